@@ -0,0 +1,113 @@
+// Benchmark: graph construction and teardown, heap vs GraphArena
+// Builds a synthetic netlist (cells with two inputs and one output) and
+// measures how long building and destroying the elk::Node tree takes.
+// Arena teardown is still O(n): every element's destructor runs to free the
+// vectors, labels and property values it owns on the heap; only the element
+// storage itself is dropped in one step.
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/graph/graph.h>
+#include <elk/graph/graph_arena.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+
+using namespace elk;
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void buildNetlist(Node* root, int cellCount) {
+    std::vector<Node*> cells;
+    cells.reserve(cellCount);
+
+    for (int i = 0; i < cellCount; i++) {
+        std::string cellId = "$and$" + std::to_string(i);
+        Node* cell = root->addChild(cellId);
+        cell->size = Size(30, 25);
+
+        Port* a = cell->addPort(cellId + ".A", PortSide::WEST);
+        a->position = Point(0, 5);
+        Port* b = cell->addPort(cellId + ".B", PortSide::WEST);
+        b->position = Point(0, 20);
+        Port* y = cell->addPort(cellId + ".Y", PortSide::EAST);
+        y->position = Point(30, 12.5);
+
+        cells.push_back(cell);
+    }
+
+    // Each output drives the next cell and one pseudo-random cell further on
+    for (int i = 0; i + 1 < cellCount; i++) {
+        Port* out = cells[i]->ports[2].get();
+        connectPorts(out, cells[i + 1]->ports[0].get(), root);
+
+        int far = (int)((i * 7919LL + 13) % cellCount);
+        if (far != i) {
+            connectPorts(out, cells[far]->ports[1].get(), root);
+        }
+    }
+}
+
+struct Timing {
+    double build = 0.0;
+    double teardown = 0.0;
+};
+
+static Timing runHeap(int cellCount) {
+    Timing t;
+    auto start = Clock::now();
+    auto root = std::make_unique<Node>("top");
+    buildNetlist(root.get(), cellCount);
+    t.build = elapsedMs(start);
+
+    start = Clock::now();
+    root.reset();
+    t.teardown = elapsedMs(start);
+    return t;
+}
+
+static Timing runArena(int cellCount, std::size_t& reserved) {
+    Timing t;
+    auto arena = std::make_unique<GraphArena>(1 << 20);
+
+    auto start = Clock::now();
+    auto root = std::make_unique<Node>("top");
+    root->arena = arena.get();
+    buildNetlist(root.get(), cellCount);
+    t.build = elapsedMs(start);
+    reserved = arena->bytesReserved();
+
+    start = Clock::now();
+    root.reset();
+    arena.reset();
+    t.teardown = elapsedMs(start);
+    return t;
+}
+
+int main(int argc, char** argv) {
+    int cellCount = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    std::cout << "Synthetic netlist: " << cellCount << " cells, "
+              << cellCount * 3 << " ports, ~" << cellCount * 2 << " edges\n";
+    std::cout << "Arena teardown still destroys each element (O(n)); only element storage is freed at once\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (int r = 0; r < repeats; r++) {
+        std::size_t reserved = 0;
+        Timing heap = runHeap(cellCount);
+        Timing arena = runArena(cellCount, reserved);
+
+        std::cout << "run " << r
+                  << "  heap: build " << heap.build << " ms, teardown " << heap.teardown << " ms"
+                  << "  |  arena: build " << arena.build << " ms, teardown " << arena.teardown << " ms"
+                  << " (" << reserved / (1024 * 1024) << " MiB reserved)\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Test batch layout of independent graphs
+// Every graph must come out exactly as a sequential layout would leave it,
+// for any thread count
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/alg/layered/batch_layout.h>
+#include <elk/io/json_reader.h>
+#include <elk/io/json_writer.h>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace elk;
+using namespace elk::layered;
+
+#ifndef ELK_EXAMPLE_DATA_DIR
+#define ELK_EXAMPLE_DATA_DIR "examples/data"
+#endif
+
+static std::string dump(const Node& root) {
+    std::string json;
+    io::writeElkJson(root, json);
+    return json;
+}
+
+// Cells in a ladder of the given length: each stage feeds the next and
+// every third stage feeds back, so layouts differ in size and shape
+static std::unique_ptr<Node> makeLadder(int stages) {
+    auto root = std::make_unique<Node>("ladder" + std::to_string(stages));
+    std::vector<Node*> cells;
+    for (int i = 0; i < stages; i++) {
+        Node* cell = root->addChild("c" + std::to_string(i));
+        cell->size = Size(30, 20 + 5 * (i % 4));
+        cell->addPort(cell->id.str() + ".A", PortSide::WEST)->size = Size(0, 0);
+        cell->addPort(cell->id.str() + ".Y", PortSide::EAST)->size = Size(0, 0);
+        cells.push_back(cell);
+    }
+    for (int i = 0; i + 1 < stages; i++) {
+        connectPorts(cells[i]->ports[1].get(), cells[i + 1]->ports[0].get(), root.get());
+        if (i % 3 == 2) {
+            connectPorts(cells[i]->ports[1].get(), cells[i - 2]->ports[0].get(), root.get());
+        }
+    }
+    return root;
+}
+
+// Owns one batch worth of graphs
+struct Batch {
+    std::vector<io::GraphDocument> documents;
+    std::vector<std::unique_ptr<Node>> built;
+    std::vector<Node*> graphs;
+
+    Batch() {
+        for (int copy = 0; copy < 3; copy++) {
+            for (const char* name : {"up3down5.elk.json", "vcc_and_gnd.elk.json"}) {
+                documents.push_back(io::readElkJsonFile(std::string(ELK_EXAMPLE_DATA_DIR) + "/" + name));
+                graphs.push_back(documents.back().root.get());
+            }
+        }
+        for (int stages : {2, 40, 7, 120, 15, 3, 60}) {
+            built.push_back(makeLadder(stages));
+            graphs.push_back(built.back().get());
+        }
+    }
+};
+
+int main() {
+    LayeredLayoutProvider options;
+    options.setNodeSpacing(25);
+
+    Batch sequential;
+    auto start = std::chrono::steady_clock::now();
+    for (Node* graph : sequential.graphs) {
+        LayeredLayoutProvider(options).layout(graph);
+    }
+    double sequentialMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::vector<std::string> expected;
+    for (Node* graph : sequential.graphs) {
+        expected.push_back(dump(*graph));
+    }
+
+    for (unsigned threads : {1u, 2u, 4u, 16u, 0u}) {
+        Batch batch;
+        start = std::chrono::steady_clock::now();
+        layoutBatch(batch.graphs, options, threads);
+        double batchMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        bool same = true;
+        for (std::size_t i = 0; i < batch.graphs.size(); i++) {
+            if (dump(*batch.graphs[i]) != expected[i]) same = false;
+        }
+        std::cout << "threads=" << threads << ": " << batchMs << " ms (sequential "
+                  << sequentialMs << " ms)\n";
+        check(same, "batch matches sequential layout");
+    }
+
+    layoutBatch(nullptr, 0, options);
+    check(true, "empty batch");
+
+    std::cout << (failures == 0 ? "All batch layout tests passed" : "Batch layout tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+// Round-trip test for the binary graph format
+// ELK JSON -> binary -> ELK JSON must reproduce the input graph, both
+// before and after layout (sections, bend points, junction points)
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/io/binary_format.h>
+#include <elk/io/json_reader.h>
+#include <elk/io/json_writer.h>
+#include <elk/io/mapped_file.h>
+#include <elk/alg/layered/layered_layout.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace elk;
+
+#ifndef ELK_EXAMPLE_DATA_DIR
+#define ELK_EXAMPLE_DATA_DIR "examples/data"
+#endif
+
+static std::string toJson(const Node& root) {
+    std::string json;
+    io::writeElkJson(root, json);
+    return json;
+}
+
+// Binary round trip in memory and through a mapped file
+static void checkRoundTrip(const Node& root, const std::string& stage) {
+    std::string expected = toJson(root);
+
+    std::string bytes;
+    io::writeElkBinary(root, bytes);
+    io::BinaryGraphView view(bytes);
+    check(view.root().children.count == root.children.size() &&
+          view.string(view.root().id) == root.id.str(), stage + ": view reads root in place");
+
+    io::GraphDocument fromMemory = io::readElkBinary(bytes);
+    check(toJson(*fromMemory.root) == expected, stage + ": JSON -> binary -> JSON (memory)");
+
+    std::string path = "binary_roundtrip_test.elkb";
+    io::writeElkBinaryFile(root, path);
+    {
+        io::GraphDocument fromFile = io::readElkBinaryFile(path);
+        check(toJson(*fromFile.root) == expected, stage + ": JSON -> binary -> JSON (mmap)");
+    }
+    std::remove(path.c_str());
+
+    std::cout << "  " << stage << ": " << expected.size() << " bytes JSON, "
+              << bytes.size() << " bytes binary\n";
+}
+
+static void checkRejectsCorruptInput() {
+    io::GraphDocument document = io::readElkJson(R"({"id":"g","children":[{"id":"n"}]})");
+    std::string bytes;
+    io::writeElkBinary(*document.root, bytes);
+
+    std::string truncated = bytes.substr(0, bytes.size() / 2);
+    bool threw = false;
+    try {
+        io::readElkBinary(truncated);
+    } catch (const io::BinaryFormatError&) {
+        threw = true;
+    }
+    check(threw, "truncated input is rejected");
+
+    threw = false;
+    try {
+        io::readElkBinary(R"({"id":"g"})");
+    } catch (const io::BinaryFormatError&) {
+        threw = true;
+    }
+    check(threw, "JSON input is rejected");
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; i++) {
+        inputs.push_back(argv[i]);
+    }
+    if (inputs.empty()) {
+        inputs.push_back(std::string(ELK_EXAMPLE_DATA_DIR) + "/vcc_and_gnd.elk.json");
+        inputs.push_back(std::string(ELK_EXAMPLE_DATA_DIR) + "/up3down5.elk.json");
+    }
+
+    for (const std::string& input : inputs) {
+        std::cout << input << "\n";
+        io::GraphDocument document = io::readElkJsonFile(input);
+        checkRoundTrip(*document.root, "input graph");
+
+        layered::LayeredLayoutProvider layout;
+        layout.setDirection(Direction::RIGHT);
+        layout.layout(document.root.get(), nullptr);
+        checkRoundTrip(*document.root, "laid-out graph");
+    }
+
+    std::cout << "corrupt input\n";
+    checkRejectsCorruptInput();
+
+    std::cout << (failures == 0 ? "All round trips passed\n" : "Round trip FAILED\n");
+    return failures == 0 ? 0 : 1;
+}
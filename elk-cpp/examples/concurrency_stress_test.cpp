@@ -0,0 +1,122 @@
+// Stress test for reentrant layout providers
+// Many threads lay out graphs at once through shared provider instances;
+// every result must equal the single-threaded one. Best run under
+// -fsanitize=thread.
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/alg/layered/layered_layout.h>
+#include <elk/alg/force/force_layout.h>
+#include <elk/io/json_reader.h>
+#include <elk/io/json_writer.h>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace elk;
+
+#ifndef ELK_EXAMPLE_DATA_DIR
+#define ELK_EXAMPLE_DATA_DIR "examples/data"
+#endif
+
+static std::string dump(const Node& root) {
+    std::string json;
+    io::writeElkJson(root, json);
+    return json;
+}
+
+// Owns whatever backs the root of a test graph
+struct TestGraph {
+    io::GraphDocument document;
+    std::unique_ptr<Node> built;
+    Node* root() { return built ? built.get() : document.root.get(); }
+};
+
+static TestGraph loadNetlist() {
+    TestGraph graph;
+    graph.document = io::readElkJsonFile(std::string(ELK_EXAMPLE_DATA_DIR) + "/up3down5.elk.json");
+    return graph;
+}
+
+// Ring of nodes that all start at the origin, so the force layout needs
+// its random generator both for initial placement and to separate them
+static TestGraph makeRing() {
+    TestGraph graph;
+    graph.built = std::make_unique<Node>("ring");
+    std::vector<Node*> nodes;
+    for (int i = 0; i < 24; i++) {
+        Node* node = graph.built->addChild("n" + std::to_string(i));
+        node->size = Size(20, 20);
+        nodes.push_back(node);
+    }
+    for (int i = 0; i < 24; i++) {
+        connectNodes(nodes[i], nodes[(i + 1) % 24], graph.built.get());
+    }
+    return graph;
+}
+
+struct Scenario {
+    std::string name;
+    std::function<TestGraph()> make;
+    ILayoutProvider* provider;
+    std::string expected;
+};
+
+int main(int argc, char* argv[]) {
+    int threads = argc > 1 ? std::atoi(argv[1]) : 8;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 6;
+
+    layered::LayeredLayoutProvider layered;
+    force::ForceLayoutProvider forceProvider;
+    forceProvider.setIterations(60);
+
+    std::vector<Scenario> scenarios = {
+        {"layered netlist", loadNetlist, &layered, ""},
+        {"force ring", makeRing, &forceProvider, ""},
+    };
+    for (auto& scenario : scenarios) {
+        TestGraph graph = scenario.make();
+        scenario.provider->layout(graph.root());
+        scenario.expected = dump(*graph.root());
+    }
+
+    // Repeated runs on one thread agree (no state carried between runs)
+    for (const auto& scenario : scenarios) {
+        TestGraph graph = scenario.make();
+        scenario.provider->layout(graph.root());
+        check(dump(*graph.root()) == scenario.expected, scenario.name + ": repeat run is identical");
+    }
+
+    std::atomic<int> mismatches{0};
+    std::atomic<int> layouts{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (int round = 0; round < rounds; round++) {
+                // Threads start on different scenarios so that every
+                // provider has several concurrent callers
+                const Scenario& scenario = scenarios[(t + round) % scenarios.size()];
+                TestGraph graph = scenario.make();
+                scenario.provider->layout(graph.root());
+                if (dump(*graph.root()) != scenario.expected) mismatches++;
+                layouts++;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::cout << layouts.load() << " concurrent layouts on " << threads << " threads\n";
+    check(mismatches.load() == 0, "concurrent layouts match the single-threaded results");
+
+    std::cout << (failures == 0 ? "All concurrency stress tests passed" : "Concurrency stress tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
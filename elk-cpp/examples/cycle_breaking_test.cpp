@@ -0,0 +1,115 @@
+// Test cycle breaking
+// Every cycle is cut by reversing edges, which are then the only ones drawn
+// right to left.
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/alg/layered/layered_layout.h>
+#include <elk/core/trace.h>
+#include <elk/io/json_writer.h>
+#include <elk/testing/generators.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace elk;
+using namespace elk::testing;
+
+// A ring of states, each also fed by a random state at most 16 steps away
+// in either direction
+static void addStateMachine(Node& module, std::size_t states) {
+    NetlistBuilder builder(&module, 7);
+    std::vector<Node*> cells;
+    for (std::size_t i = 0; i < states; i++) {
+        cells.push_back(builder.addCell(CellKind::AND));
+    }
+    for (std::size_t i = 0; i < states; i++) {
+        std::size_t other = (i + states - 16 + builder.pick(33)) % states;
+        builder.connect(NetlistBuilder::pin(cells[(i + states - 1) % states], "Y"), NetlistBuilder::pin(cells[i], "A"));
+        builder.connect(NetlistBuilder::pin(cells[other], "Y"), NetlistBuilder::pin(cells[i], "B"));
+    }
+}
+
+// Edges drawn right to left, and whether an edge between two cells has
+// both ends in one layer (cells of a layer share their x)
+static std::size_t backwardEdges(const Node& module, bool& flatEdges) {
+    std::size_t backward = 0;
+    flatEdges = false;
+    for (const auto& edge : module.edges) {
+        const Node* source = edge->sourcePorts[0]->parent;
+        const Node* target = edge->targetPorts[0]->parent;
+        if (source == target) continue;
+        backward += target->position.x < source->position.x;
+        flatEdges |= target->position.x == source->position.x;
+    }
+    return backward;
+}
+
+int main() {
+    layered::LayeredLayoutProvider provider;
+
+    // A single loop loses one edge
+    Node loop("loop");
+    {
+        NetlistBuilder builder(&loop);
+        Node* cells[3];
+        for (Node*& cell : cells) {
+            cell = builder.addCell(CellKind::NOT);
+        }
+        for (int i = 0; i < 3; i++) {
+            builder.connect(NetlistBuilder::pin(cells[i], "Y"), NetlistBuilder::pin(cells[(i + 1) % 3], "A"));
+        }
+    }
+    bool loopFlat = true;
+#if ELK_TRACE_LEVEL > 0
+    trace::Tracer loopTracer;
+    {
+        trace::TraceScope scope(loopTracer);
+        provider.layout(&loop);
+    }
+    check(loopTracer.counter(trace::Counter::REVERSED_EDGES) == 1, "a loop of three reverses one edge");
+#else
+    provider.layout(&loop);
+#endif
+    check(backwardEdges(loop, loopFlat) == 1 && !loopFlat, "and draws only that edge right to left");
+
+    // Feedback loops through registers
+    auto loopsDocument = feedbackLoops(300, 40);
+    Node* loops = loopsDocument.root.get();
+    bool loopsFlat = true;
+#if ELK_TRACE_LEVEL > 0
+    trace::Tracer loopsTracer;
+    {
+        trace::TraceScope scope(loopsTracer);
+        provider.layout(loops);
+    }
+    std::size_t reversed = static_cast<std::size_t>(loopsTracer.counter(trace::Counter::REVERSED_EDGES));
+    check(reversed > 0 && backwardEdges(*loops, loopsFlat) == reversed,
+          "feedback loops draw exactly the " + std::to_string(reversed) + " reversed edges right to left");
+#else
+    provider.layout(loops);
+    backwardEdges(*loops, loopsFlat);
+#endif
+    check(!loopsFlat, "no edge has both ends in one layer");
+    std::string first;
+    std::string second;
+    io::writeElkJson(*loops, first);
+    provider.layout(loops);
+    io::writeElkJson(*loops, second);
+    check(first == second, "cycle breaking is deterministic");
+
+    // A deeply cyclic state machine
+    const std::size_t states = 5000;
+    Node machine("fsm");
+    addStateMachine(machine, states);
+    bool machineFlat = true;
+    provider.layout(&machine);
+    std::size_t backward = backwardEdges(machine, machineFlat);
+    check(backward > 0 && backward < states && !machineFlat,
+          "a state machine of " + std::to_string(states) + " states lays out with " + std::to_string(backward) +
+              " edges reversed");
+
+    std::cout << (failures == 0 ? "All cycle breaking tests passed" : "Cycle breaking tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,578 @@
+// Layout benchmark suite
+// Runs every layout provider, and times every layered phase, on seeded
+// synthetic netlists from 100 to 1M cells. Reports median and p95 times,
+// throughput and peak memory, writes JSON and flags regressions against a
+// baseline written by an earlier run.
+//
+//   elk_bench [options]
+//     --sizes 100,1000,...   graph sizes in cells (default 100 to 1000000)
+//     --providers a,b,...    layered, layered-session, layered-merged,
+//                            layered-simplex, layered-graham,
+//                            layered-promoted, layered-chain, recursive,
+//                            batch, force
+//     --repeat N             runs per case (default 5)
+//     --max-seconds S        stop repeating a case after S seconds, and skip
+//                            larger sizes of a provider whose median run
+//                            took longer (default 60)
+//     --seed N               generator seed (default 1)
+//     --json FILE            write results as JSON ("-" for stdout)
+//     --baseline FILE        compare against a JSON file from an earlier run
+//     --threshold F          relative slowdown flagged as regression (default 0.10)
+//     --min-delta-ms MS      ignore slowdowns smaller than this (default 1)
+//
+// Exit status is 1 if a regression was flagged.
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/alg/force/force_layout.h>
+#include <elk/alg/layered/batch_layout.h>
+#include <elk/alg/layered/layered_layout.h>
+#include <elk/core/recursive_layout.h>
+#include <elk/core/trace.h>
+#include <elk/testing/generators.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+using namespace elk;
+using Clock = std::chrono::steady_clock;
+
+// ============================================================================
+// Memory
+// ============================================================================
+
+// Value in kB of a /proc/self/status field, or -1
+static long statusKb(const char* field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    std::string prefix = std::string(field) + ":";
+    while (std::getline(status, line)) {
+        if (line.compare(0, prefix.size(), prefix) == 0) {
+            return std::strtol(line.c_str() + prefix.size(), nullptr, 10);
+        }
+    }
+    return -1;
+}
+
+// Restart peak RSS tracking (Linux); false if the peak cannot be reset.
+// Memory freed by earlier runs is returned to the system first, so that
+// it does not hide what the next run allocates.
+static bool resetPeakMemory() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.flush();
+    return static_cast<bool>(clearRefs);
+}
+
+static double currentMiB() {
+    long kb = statusKb("VmRSS");
+    return kb < 0 ? 0.0 : kb / 1024.0;
+}
+
+static double peakMiB() {
+    long kb = statusKb("VmHWM");
+    if (kb >= 0) return kb / 1024.0;
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+#else
+    return 0.0;
+#endif
+}
+
+// ============================================================================
+// Workloads
+// ============================================================================
+
+// Graphs of one run; generated before the timer starts
+struct Workload {
+    std::vector<io::GraphDocument> documents;
+    std::size_t nodes = 0;
+    std::size_t edges = 0;
+};
+
+static void countElements(const Node& node, std::size_t& nodes, std::size_t& edges) {
+    nodes += node.children.size();
+    edges += node.edges.size();
+    for (const auto& child : node.children) {
+        countElements(*child, nodes, edges);
+    }
+}
+
+static void add(Workload& workload, io::GraphDocument document) {
+    countElements(*document.root, workload.nodes, workload.edges);
+    workload.documents.push_back(std::move(document));
+}
+
+struct Benchmark {
+    std::string provider;
+    std::string graph;
+    std::function<Workload(std::size_t cells, std::uint64_t seed)> generate;
+    std::function<void(Workload&)> run;
+};
+
+static Workload flatNetlist(std::size_t cells, std::uint64_t seed) {
+    Workload workload;
+    add(workload, testing::netlist(cells, seed));
+    return workload;
+}
+
+// Two levels of instances with about 50 cells per module
+static Workload hierarchy(std::size_t cells, std::uint64_t seed) {
+    std::size_t modules = std::max<std::size_t>(cells / 50, 1);
+    std::size_t instances = std::max<std::size_t>(static_cast<std::size_t>(std::sqrt(modules)), 1);
+    std::size_t cellsPerModule = cells / (1 + instances + instances * instances);
+    Workload workload;
+    add(workload, testing::hierarchicalDesign(2, instances, std::max<std::size_t>(cellsPerModule, 4), seed));
+    return workload;
+}
+
+// One inverter per layer: the deepest graph of its size
+static Workload chain(std::size_t cells, std::uint64_t seed) {
+    Workload workload;
+    add(workload, testing::inverterChain(cells, seed));
+    return workload;
+}
+
+// Independent netlists of 100 cells
+static Workload manyNetlists(std::size_t cells, std::uint64_t seed) {
+    Workload workload;
+    for (std::size_t i = 0; i < std::max<std::size_t>(cells / 100, 1); i++) {
+        add(workload, testing::netlist(std::min<std::size_t>(cells, 100), seed + i));
+    }
+    return workload;
+}
+
+static std::vector<Benchmark> benchmarks() {
+    auto layered = std::make_shared<layered::LayeredLayoutProvider>();
+    auto session = std::make_shared<layered::LayoutSession>();
+    auto merged = std::make_shared<layered::LayeredLayoutProvider>();
+    merged->setMergeLongEdges(true);
+    auto simplex = std::make_shared<layered::LayeredLayoutProvider>();
+    simplex->setLayering(LayeringStrategy::NETWORK_SIMPLEX);
+    auto graham = std::make_shared<layered::LayeredLayoutProvider>();
+    graham->setLayering(LayeringStrategy::COFFMAN_GRAHAM);
+    graham->setCoffmanGrahamLayerBound(100);
+    auto promoted = std::make_shared<layered::LayeredLayoutProvider>();
+    promoted->setNodePromotion(NodePromotionStrategy::NIKOLOV);
+    auto force = std::make_shared<force::ForceLayoutProvider>();
+
+    return {
+        {"layered", "netlist", flatNetlist,
+         [layered](Workload& workload) { layered->layout(workload.documents[0].root.get()); }},
+        {"layered-session", "netlist", flatNetlist,
+         [layered, session](Workload& workload) { layered->layout(workload.documents[0].root.get(), *session); }},
+        {"layered-merged", "netlist", flatNetlist,
+         [merged](Workload& workload) { merged->layout(workload.documents[0].root.get()); }},
+        {"layered-simplex", "netlist", flatNetlist,
+         [simplex](Workload& workload) { simplex->layout(workload.documents[0].root.get()); }},
+        {"layered-graham", "netlist", flatNetlist,
+         [graham](Workload& workload) { graham->layout(workload.documents[0].root.get()); }},
+        {"layered-promoted", "netlist", flatNetlist,
+         [promoted](Workload& workload) { promoted->layout(workload.documents[0].root.get()); }},
+        {"layered-chain", "chain", chain,
+         [layered](Workload& workload) { layered->layout(workload.documents[0].root.get()); }},
+        {"recursive", "hierarchy", hierarchy,
+         [layered](Workload& workload) {
+             RecursiveConfig config;
+             config.strategy = RecursiveStrategy::BOTTOM_UP;
+             config.parallel = true;
+             RecursiveLayoutEngine::layout(workload.documents[0].root.get(), layered.get(), config);
+         }},
+        {"batch", "netlists", manyNetlists,
+         [layered](Workload& workload) {
+             std::vector<Node*> graphs;
+             for (auto& document : workload.documents) graphs.push_back(document.root.get());
+             layered::layoutBatch(graphs, *layered);
+         }},
+        {"force", "netlist", flatNetlist,
+         [force](Workload& workload) { force->layout(workload.documents[0].root.get()); }},
+    };
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+struct Summary {
+    double median = 0.0;
+    double p95 = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+static Summary summarize(std::vector<double> samples) {
+    Summary summary;
+    if (samples.empty()) return summary;
+    std::sort(samples.begin(), samples.end());
+    std::size_t n = samples.size();
+    summary.median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    // Nearest rank
+    std::size_t rank = static_cast<std::size_t>(std::ceil(0.95 * n));
+    summary.p95 = samples[std::max<std::size_t>(rank, 1) - 1];
+    summary.min = samples.front();
+    summary.max = samples.back();
+    return summary;
+}
+
+struct CaseResult {
+    std::string name;
+    std::string provider;
+    std::string graph;
+    std::size_t cells = 0;
+    std::size_t nodes = 0;
+    std::size_t edges = 0;
+    std::vector<double> totalMs;
+    std::vector<std::pair<std::string, std::vector<double>>> phaseMs;  // In first-run order
+    std::vector<std::pair<std::string, std::int64_t>> counters;        // Of the last run
+    double peakMiB = 0.0;
+    double layoutMiB = 0.0;       // Peak minus RSS before the run
+    std::string skipped;          // Reason, if the case did not run
+};
+
+static CaseResult runCase(const Benchmark& benchmark, std::size_t cells, std::uint64_t seed, int repeat,
+                          double maxSeconds) {
+    CaseResult result;
+    result.provider = benchmark.provider;
+    result.graph = benchmark.graph;
+    result.cells = cells;
+    result.name = benchmark.provider + "/" + std::to_string(cells);
+
+    double spentMs = 0.0;
+    for (int run = 0; run < repeat && (run == 0 || spentMs < maxSeconds * 1e3); run++) {
+        Workload workload = benchmark.generate(cells, seed);
+        result.nodes = workload.nodes;
+        result.edges = workload.edges;
+
+        trace::Tracer tracer;
+        bool peakReset = resetPeakMemory();
+        double before = currentMiB();
+        auto start = Clock::now();
+        {
+            trace::TraceScope scope(tracer);
+            benchmark.run(workload);
+        }
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        // Without a reset the peak is the process's, and no growth is known
+        double peak = peakMiB();
+        result.peakMiB = peakReset ? std::max(result.peakMiB, peak) : peak;
+        if (peakReset) result.layoutMiB = std::max(result.layoutMiB, peak - before);
+        result.totalMs.push_back(ms);
+        spentMs += ms;
+
+        for (const trace::PhaseStats& phase : tracer.phases()) {
+            auto it = std::find_if(result.phaseMs.begin(), result.phaseMs.end(),
+                                   [&](const auto& entry) { return entry.first == phase.name; });
+            if (it == result.phaseMs.end()) {
+                result.phaseMs.emplace_back(phase.name, std::vector<double>());
+                it = result.phaseMs.end() - 1;
+            }
+            it->second.push_back(phase.wallMs);
+        }
+        result.counters.clear();
+        for (std::size_t i = 0; i < static_cast<std::size_t>(trace::Counter::COUNT); i++) {
+            trace::Counter counter = static_cast<trace::Counter>(i);
+            result.counters.emplace_back(trace::counterName(counter), tracer.counter(counter));
+        }
+    }
+    return result;
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+static double perSecond(std::size_t count, double ms) {
+    return ms > 0.0 ? count * 1e3 / ms : 0.0;
+}
+
+static void printCase(std::ostream& out, const CaseResult& result) {
+    if (!result.skipped.empty()) {
+        out << std::left << std::setw(26) << result.name << "skipped: " << result.skipped << "\n";
+        return;
+    }
+    Summary total = summarize(result.totalMs);
+    out << std::left << std::setw(26) << result.name << std::right << std::setw(9) << result.nodes
+        << std::setw(9) << result.edges << std::setw(5) << result.totalMs.size() << std::setw(12) << total.median
+        << std::setw(12) << total.p95 << std::setw(14) << std::setprecision(0) << perSecond(result.nodes, total.median)
+        << std::setprecision(1) << std::setw(10) << result.peakMiB << std::setw(10) << result.layoutMiB
+        << std::setprecision(3) << "\n";
+    for (const auto& phase : result.phaseMs) {
+        Summary stats = summarize(phase.second);
+        out << "  " << std::left << std::setw(41) << phase.first << std::right << std::setw(5) << ""
+            << std::setw(12) << stats.median << std::setw(12) << stats.p95 << "\n";
+    }
+}
+
+static void writeJson(std::ostream& out, const std::vector<CaseResult>& results, const std::string& commandLine) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\"benchmark\":\"elk_bench\",\"format\":1,\"command\":\"" << commandLine << "\",\"cases\":[\n";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const CaseResult& result = results[i];
+        out << "{\"name\":\"" << result.name << "\",\"provider\":\"" << result.provider << "\",\"graph\":\""
+            << result.graph << "\",\"cells\":" << result.cells;
+        if (!result.skipped.empty()) {
+            out << ",\"skipped\":\"" << result.skipped << "\"}";
+        } else {
+            Summary total = summarize(result.totalMs);
+            out << ",\"nodes\":" << result.nodes << ",\"edges\":" << result.edges << ",\"runs\":" << result.totalMs.size()
+                << ",\"median_ms\":" << total.median << ",\"p95_ms\":" << total.p95 << ",\"min_ms\":" << total.min
+                << ",\"max_ms\":" << total.max << ",\"nodes_per_s\":" << perSecond(result.nodes, total.median)
+                << ",\"edges_per_s\":" << perSecond(result.edges, total.median) << ",\"peak_rss_mib\":"
+                << result.peakMiB << ",\"layout_rss_mib\":" << result.layoutMiB << ",\"counters\":{";
+            for (std::size_t c = 0; c < result.counters.size(); c++) {
+                out << (c ? "," : "") << "\"" << result.counters[c].first << "\":" << result.counters[c].second;
+            }
+            out << "},\"phases\":{";
+            for (std::size_t p = 0; p < result.phaseMs.size(); p++) {
+                Summary stats = summarize(result.phaseMs[p].second);
+                out << (p ? "," : "") << "\"" << result.phaseMs[p].first << "\":{\"median_ms\":" << stats.median
+                    << ",\"p95_ms\":" << stats.p95 << "}";
+            }
+            out << "}}";
+        }
+        out << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]}\n";
+}
+
+// ============================================================================
+// Baseline comparison
+// ============================================================================
+
+// Median times of one baseline case: "" for the total, else per phase
+using BaselineCase = std::map<std::string, double>;
+
+// Number following "key": at or after from; false if there is none
+static bool numberAfter(const std::string& line, const std::string& key, std::size_t from, double& value,
+                        std::size_t* end = nullptr) {
+    std::string pattern = "\"" + key + "\":";
+    std::size_t pos = line.find(pattern, from);
+    if (pos == std::string::npos) return false;
+    const char* begin = line.c_str() + pos + pattern.size();
+    char* stop = nullptr;
+    value = std::strtod(begin, &stop);
+    if (stop == begin) return false;
+    if (end) *end = stop - line.c_str();
+    return true;
+}
+
+// Reads the JSON this program writes, which has one case per line
+static std::map<std::string, BaselineCase> readBaseline(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open baseline " + path);
+    std::map<std::string, BaselineCase> baseline;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::size_t nameStart = line.find("{\"name\":\"");
+        if (nameStart == std::string::npos || line.find("\"skipped\"") != std::string::npos) continue;
+        nameStart += 9;
+        std::string name = line.substr(nameStart, line.find('"', nameStart) - nameStart);
+
+        BaselineCase entry;
+        double median = 0.0;
+        std::size_t phasesStart = line.find("\"phases\":{");
+        if (!numberAfter(line.substr(0, phasesStart), "median_ms", 0, median)) continue;
+        entry[""] = median;
+        std::size_t pos = phasesStart == std::string::npos ? line.size() : phasesStart + 10;
+        while (pos < line.size() && line[pos] == '"') {
+            std::size_t nameEnd = line.find('"', pos + 1);
+            std::string phase = line.substr(pos + 1, nameEnd - pos - 1);
+            std::size_t next = 0;
+            if (!numberAfter(line, "median_ms", nameEnd, median, &next)) break;
+            entry[phase] = median;
+            // Skip the rest of this phase's object and the separator
+            pos = line.find('}', next);
+            if (pos == std::string::npos) break;
+            pos += line[pos + 1] == ',' ? 2 : 1;
+        }
+        baseline[name] = entry;
+    }
+    return baseline;
+}
+
+// Prints changes beyond the threshold; returns the number of regressions
+static int compareWithBaseline(std::ostream& out, const std::vector<CaseResult>& results,
+                               const std::map<std::string, BaselineCase>& baseline, double threshold,
+                               double minDeltaMs) {
+    int regressions = 0;
+    out << "\nComparison with baseline (threshold " << threshold * 100 << "%, min delta " << minDeltaMs
+              << " ms)\n";
+    auto compare = [&](const std::string& what, double before, double now) {
+        double delta = now - before;
+        if (std::abs(delta) < minDeltaMs || before <= 0.0) return;
+        double change = delta / before;
+        if (change > threshold) {
+            regressions++;
+            out << "  REGRESSION  ";
+        } else if (change < -threshold) {
+            out << "  improvement ";
+        } else {
+            return;
+        }
+        out << std::left << std::setw(48) << what << std::right << std::setw(12) << before << " ->"
+                  << std::setw(12) << now << " ms (" << std::showpos << std::setprecision(1) << change * 100
+                  << std::noshowpos << std::setprecision(3) << "%)\n";
+    };
+    for (const CaseResult& result : results) {
+        auto base = baseline.find(result.name);
+        if (!result.skipped.empty() || base == baseline.end()) continue;
+        auto total = base->second.find("");
+        if (total != base->second.end()) compare(result.name, total->second, summarize(result.totalMs).median);
+        for (const auto& phase : result.phaseMs) {
+            auto before = base->second.find(phase.first);
+            if (before != base->second.end()) {
+                compare(result.name + " " + phase.first, before->second, summarize(phase.second).median);
+            }
+        }
+    }
+    out << (regressions == 0 ? "  no regressions\n" : "");
+    return regressions;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::size_t> sizes = {100, 1000, 10000, 100000, 1000000};
+    std::vector<std::string> providers;
+    int repeat = 5;
+    double maxSeconds = 60.0;
+    std::uint64_t seed = 1;
+    std::string jsonPath;
+    std::string baselinePath;
+    double threshold = 0.10;
+    double minDeltaMs = 1.0;
+
+    std::string commandLine = "elk_bench";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        commandLine += " " + arg;
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 2;
+        }
+        std::string value = argv[++i];
+        commandLine += " " + value;
+        if (arg == "--sizes") {
+            sizes.clear();
+            for (const std::string& size : splitList(value)) sizes.push_back(std::stoul(size));
+        } else if (arg == "--providers") {
+            providers = splitList(value);
+        } else if (arg == "--repeat") {
+            repeat = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--max-seconds") {
+            maxSeconds = std::atof(value.c_str());
+        } else if (arg == "--seed") {
+            seed = std::stoull(value);
+        } else if (arg == "--json") {
+            jsonPath = value;
+        } else if (arg == "--baseline") {
+            baselinePath = value;
+        } else if (arg == "--threshold") {
+            threshold = std::atof(value.c_str());
+        } else if (arg == "--min-delta-ms") {
+            minDeltaMs = std::atof(value.c_str());
+        } else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return 2;
+        }
+    }
+
+    std::vector<Benchmark> selected;
+    for (Benchmark& benchmark : benchmarks()) {
+        if (providers.empty() ||
+            std::find(providers.begin(), providers.end(), benchmark.provider) != providers.end()) {
+            selected.push_back(benchmark);
+        }
+    }
+    if (selected.empty()) {
+        std::cerr << "No provider matches --providers\n";
+        return 2;
+    }
+    std::sort(sizes.begin(), sizes.end());
+
+    // Human-readable table goes to stderr when the JSON goes to stdout
+    std::ostream& table = jsonPath == "-" ? std::cerr : std::cout;
+    table << std::fixed << std::setprecision(3);
+    table << std::left << std::setw(26) << "case" << std::right << std::setw(9) << "nodes" << std::setw(9) << "edges"
+          << std::setw(5) << "runs" << std::setw(12) << "median ms" << std::setw(12) << "p95 ms" << std::setw(14)
+          << "nodes/s" << std::setw(10) << "peak MiB" << std::setw(10) << "+MiB" << "\n";
+
+    std::vector<CaseResult> results;
+    for (const Benchmark& benchmark : selected) {
+        std::string tooSlow;
+        for (std::size_t cells : sizes) {
+            CaseResult result;
+            if (!tooSlow.empty()) {
+                result.name = benchmark.provider + "/" + std::to_string(cells);
+                result.provider = benchmark.provider;
+                result.graph = benchmark.graph;
+                result.cells = cells;
+                result.skipped = tooSlow;
+            } else {
+                result = runCase(benchmark, cells, seed, repeat, maxSeconds);
+                if (summarize(result.totalMs).median > maxSeconds * 1e3) {
+                    tooSlow = result.name + " took longer than " + std::to_string(static_cast<int>(maxSeconds)) + " s";
+                }
+            }
+            printCase(table, result);
+            table.flush();
+            results.push_back(std::move(result));
+        }
+    }
+
+    if (!jsonPath.empty()) {
+        if (jsonPath == "-") {
+            writeJson(std::cout, results, commandLine);
+        } else {
+            std::ofstream out(jsonPath);
+            writeJson(out, results, commandLine);
+            if (!out) {
+                std::cerr << "Cannot write " << jsonPath << "\n";
+                return 2;
+            }
+        }
+    }
+
+    if (!baselinePath.empty()) {
+        if (compareWithBaseline(table, results, readBaseline(baselinePath), threshold, minDeltaMs) > 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+// Convert between ELK JSON and the binary graph format
+// The input format is detected from its contents; the output format is
+// chosen by the output file extension (".elkb" for binary, JSON otherwise)
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/io/binary_format.h>
+#include <elk/io/json_reader.h>
+#include <elk/io/json_writer.h>
+#include <elk/io/mapped_file.h>
+#include <iostream>
+#include <string>
+
+using namespace elk;
+
+static bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.json|input.elkb> <output.json|output.elkb>\n";
+        return 1;
+    }
+
+    try {
+        io::MappedFile input(argv[1]);
+        io::GraphDocument document = io::isElkBinary(input.view())
+            ? io::readElkBinary(input.view())
+            : io::readElkJson(input.view());
+
+        std::string output = argv[2];
+        if (endsWith(output, ".elkb")) {
+            io::writeElkBinaryFile(*document.root, output);
+        } else {
+            io::JsonWriteOptions options;
+            options.indent = 2;
+            io::writeElkJsonFile(*document.root, output, options);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "elk_convert: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
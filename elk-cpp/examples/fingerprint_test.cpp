@@ -0,0 +1,97 @@
+// Test structural graph fingerprints
+// The fingerprint must ignore layout output and addresses, change with any
+// layout input, and be identical across runs and platforms
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/graph/fingerprint.h>
+#include <elk/graph/graph.h>
+#include <elk/io/json_reader.h>
+#include <elk/alg/layered/layered_layout.h>
+#include <iostream>
+#include <string>
+
+#include "test_check.h"
+
+using namespace elk;
+
+#ifndef ELK_EXAMPLE_DATA_DIR
+#define ELK_EXAMPLE_DATA_DIR "examples/data"
+#endif
+
+static io::GraphDocument load(const std::string& name) {
+    return io::readElkJsonFile(std::string(ELK_EXAMPLE_DATA_DIR) + "/" + name);
+}
+
+int main() {
+    io::GraphDocument graph = load("up3down5.elk.json");
+    Fingerprint original = fingerprint(*graph.root);
+    std::cout << "up3down5: " << original.hex() << "\n";
+
+    // Same input read again lives at different addresses
+    io::GraphDocument copy = load("up3down5.elk.json");
+    check(fingerprint(*copy.root) == original, "independent copies hash equal");
+
+    // Hand-built graph with the same content as the JSON file
+    io::GraphDocument small = load("vcc_and_gnd.elk.json");
+    auto built = std::make_unique<Node>("test");
+    Node* vcc = built->addChild("vcc");
+    vcc->size = Size(20, 30);
+    vcc->setProperty("org.eclipse.elk.portConstraints", std::string("FIXED_POS"));
+    vcc->labels.emplace_back("VCC", 20, 11);
+    vcc->labels.back().position = Point(0, -12);
+    Port* vccPort = vcc->addPort("vcc.A");
+    vccPort->position = Point(10, 30);
+    vccPort->index = 0;
+    Node* gnd = built->addChild("gnd");
+    gnd->size = Size(20, 30);
+    gnd->setProperty("org.eclipse.elk.portConstraints", std::string("FIXED_POS"));
+    Port* gndPort = gnd->addPort("gnd.A");
+    gndPort->position = Point(10, -15);
+    gndPort->index = 0;
+    Edge* edge = connectPorts(vccPort, gndPort, built.get());
+    edge->id = ElementId("e0", built->symbolTable());
+    edge->setProperty("org.eclipse.elk.edge.thickness", 1);
+    edge->setProperty("org.eclipse.elk.layered.priority.direction", 10);
+    check(fingerprint(*built) == fingerprint(*small.root),
+          "option order, key spelling and int/double values do not matter");
+
+    // Layout output is ignored
+    layered::LayeredLayoutProvider layout;
+    layout.setDirection(Direction::RIGHT);
+    layout.layout(copy.root.get(), nullptr);
+    check(fingerprint(*copy.root) == original, "positions and sections are ignored");
+
+    // Every layout input changes it
+    Node* cell = graph.root->children[0].get();
+    cell->size.width += 1;
+    check(fingerprint(*graph.root) != original, "node size changes it");
+    cell->size.width -= 1;
+
+    cell->ports[0]->side = PortSide::SOUTH;
+    check(fingerprint(*graph.root) != original, "port side changes it");
+    cell->ports[0]->side = PortSide::NORTH;
+
+    Edge* first = graph.root->edges[0].get();
+    std::swap(first->targetPorts, graph.root->edges[1]->targetPorts);
+    check(fingerprint(*graph.root) != original, "edge endpoints change it");
+    std::swap(first->targetPorts, graph.root->edges[1]->targetPorts);
+
+    cell->setProperty("elk.layered.layering.layerConstraint", std::string("FIRST"));
+    check(fingerprint(*graph.root) != original, "layout options change it");
+    cell->removeProperty("elk.layered.layering.layerConstraint");
+
+    check(fingerprint(*graph.root) == original, "restoring the input restores it");
+
+    FingerprintOptions withoutIds;
+    withoutIds.ids = false;
+    Fingerprint anonymous = fingerprint(*graph.root, withoutIds);
+    cell->id = ElementId("renamed", *graph.symbols);
+    check(fingerprint(*graph.root) != original && fingerprint(*graph.root, withoutIds) == anonymous,
+          "IDs are included unless disabled");
+
+    // Pinned value: the hash must not vary between runs, compilers or platforms
+    check(fingerprint(*small.root).hex() == "fd0c26a57fe490b4131f5f2b6e903ceb", "stable value for vcc_and_gnd");
+
+    std::cout << (failures == 0 ? "All fingerprint checks passed\n" : "Fingerprint checks FAILED\n");
+    return failures == 0 ? 0 : 1;
+}
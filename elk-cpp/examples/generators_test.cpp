@@ -0,0 +1,173 @@
+// Test the synthetic netlist generators
+// Seeded determinism, skin shapes, requested sizes and fanouts, and that the
+// generated graphs lay out
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/alg/layered/layered_layout.h>
+#include <elk/core/recursive_layout.h>
+#include <elk/io/json_writer.h>
+#include <elk/testing/generators.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#include "test_check.h"
+
+using namespace elk;
+using namespace elk::testing;
+
+static std::string dump(const Node& root) {
+    std::string json;
+    io::writeElkJson(root, json);
+    return json;
+}
+
+static size_t countCells(const Node& module, const std::string& type) {
+    return std::count_if(module.children.begin(), module.children.end(), [&](const auto& child) {
+        return child->id.str().find("$" + type + "$") != std::string::npos;
+    });
+}
+
+// Edges whose source is the given cell's pin
+static size_t fanout(const Node& module, const Port* pin) {
+    return std::count_if(module.edges.begin(), module.edges.end(), [&](const auto& edge) {
+        return edge->sourcePorts[0] == pin;
+    });
+}
+
+static const Node* findLabelled(const Node& module, const std::string& label) {
+    for (const auto& child : module.children) {
+        if (!child->labels.empty() && child->labels[0].text == label) return child.get();
+    }
+    return nullptr;
+}
+
+// Every edge connects two ports of cells in the module that holds it, and
+// every input pin has exactly one driver
+static bool wellFormed(const Node& module) {
+    std::vector<const Port*> driven;
+    for (const auto& edge : module.edges) {
+        if (edge->sourcePorts.size() != 1 || edge->targetPorts.size() != 1) return false;
+        if (edge->sourcePorts[0]->parent->parent != &module) return false;
+        if (edge->targetPorts[0]->parent->parent != &module) return false;
+        driven.push_back(edge->targetPorts[0]);
+    }
+    std::sort(driven.begin(), driven.end());
+    if (std::adjacent_find(driven.begin(), driven.end()) != driven.end()) return false;
+    for (const auto& child : module.children) {
+        for (const auto& port : child->ports) {
+            bool input = port->side != PortSide::EAST;
+            if (input && !std::binary_search(driven.begin(), driven.end(), port.get())) return false;
+        }
+        if (!wellFormed(*child)) return false;
+    }
+    return true;
+}
+
+int main() {
+    // Determinism
+    check(dump(*netlist(500, 7).root) == dump(*netlist(500, 7).root), "same seed gives the same netlist");
+    check(dump(*netlist(500, 7).root) != dump(*netlist(500, 8).root), "different seeds give different netlists");
+
+    // Skin shapes
+    Node module("skin");
+    NetlistBuilder builder(&module);
+    Node* mux = builder.addCell(CellKind::MUX);
+    check(mux->size.width == 20 && mux->size.height == 40, "mux has the skin size");
+    Port* select = NetlistBuilder::pin(mux, "S");
+    check(select->position.x == 10 && select->position.y == 35 && select->side == PortSide::SOUTH,
+          "mux select pin is on the south side");
+    check(mux->getProperty(LayoutOptions::PORT_CONSTRAINTS) == "FIXED_POS", "cells fix their pin positions");
+    check(NetlistBuilder::pin(mux, "Y")->id.str() == mux->id.str() + ".Y", "pin IDs follow netlistsvg");
+    Node* dff = builder.addCell(CellKind::DFF);
+    check(NetlistBuilder::pin(dff, "CLK")->position.x == -1 && NetlistBuilder::pin(dff, "Q")->position.x == 31,
+          "dff pins match the skin");
+    Node* split = builder.addSplit(4);
+    check(split->size.height == 80 && NetlistBuilder::splitOutput(split, 3)->position.y == 70,
+          "split grows by 20 per output");
+    Node* instance = builder.addInstance("alu", 3, 1);
+    check(instance->size.width == 30 && instance->size.height == 60 && instance->ports.size() == 4,
+          "instance uses the generic skin");
+    check(instance->ports[0]->labels.size() == 1 && instance->labels[0].text == "alu", "instance pins are labelled");
+    Node* input = builder.addInput("clk");
+    check(input->labels.size() == 1 && input->labels[0].size.width == 18, "module ports carry their name");
+
+    // Fragments
+    auto carryDocument = carryChain(4);
+    const Node* carry = carryDocument.root.get();
+    check(countCells(*carry, "mux") == 4 && countCells(*carry, "reduce_xor") == 4, "carry chain has a mux and xor per bit");
+    check(countCells(*carry, "split") == 2 && countCells(*carry, "join") == 2, "carry chain splits and joins its buses");
+    check(wellFormed(*carry), "carry chain is well formed");
+
+    auto treeDocument = muxTree(16);
+    const Node* tree = treeDocument.root.get();
+    check(countCells(*tree, "mux") == 15, "mux tree over 16 inputs has 15 muxes");
+    const Node* s0 = findLabelled(*tree, "s0");
+    check(s0 && fanout(*tree, s0->ports[0].get()) == 8, "first tree level shares its select");
+    check(wellFormed(*tree), "mux tree is well formed");
+
+    auto registerDocument = registerFile(8, 16);
+    const Node* registers = registerDocument.root.get();
+    check(countCells(*registers, "dff") == 128, "register file has registers x width flip-flops");
+    const Node* clk = findLabelled(*registers, "clk");
+    const Node* rst = findLabelled(*registers, "rst");
+    check(clk && fanout(*registers, clk->ports[0].get()) == 128, "clock drives every flip-flop");
+    check(rst && fanout(*registers, rst->ports[0].get()) == 128, "reset drives every flip-flop");
+    check(wellFormed(*registers), "register file is well formed");
+
+    auto busDocument = bitBlastedBus(32, 3);
+    const Node* bus = busDocument.root.get();
+    check(bus->children.size() == 32 * 3 + 4, "bus has a gate per bit and stage");
+    check(wellFormed(*bus), "bus is well formed");
+
+    auto loopDocument = feedbackLoops(64, 8);
+    const Node* loops = loopDocument.root.get();
+    check(wellFormed(*loops), "feedback loops are well formed");
+
+    auto chainDocument = inverterChain(50);
+    const Node* chain = chainDocument.root.get();
+    check(countCells(*chain, "not") == 50 && chain->edges.size() == 51, "inverter chain has a net per stage");
+    check(wellFormed(*chain), "inverter chain is well formed");
+
+    // Sizes
+    for (size_t target : {100, 1000, 20000}) {
+        auto document = netlist(target, 3);
+        const Node* graph = document.root.get();
+        size_t cells = graph->children.size();
+        check(cells >= target && cells <= target + target / 10 + 20,
+              "netlist of " + std::to_string(target) + " has " + std::to_string(cells) + " cells");
+        check(wellFormed(*graph), "netlist of " + std::to_string(target) + " is well formed");
+    }
+
+    // Hierarchy: depth 2 nests instances inside instances
+    auto topDocument = hierarchicalDesign(2, 3, 12);
+    Node* top = topDocument.root.get();
+    check(countCells(*top, "sub0") == 1 && countCells(*top, "generic") == 0, "top holds named instances");
+    const Node* sub = nullptr;
+    for (const auto& child : top->children) {
+        if (child->id.str().find("$sub0$") != std::string::npos) sub = child.get();
+    }
+    check(sub && countCells(*sub, "sub2") == 1 && countCells(*sub, "and") + countCells(*sub, "or") +
+                                                     countCells(*sub, "reduce_xor") + countCells(*sub, "add") +
+                                                     countCells(*sub, "eq") >= 9,
+          "instances hold logic and instances of their own");
+    check(wellFormed(*top), "hierarchical design is well formed");
+
+    // Layout
+    layered::LayeredLayoutProvider provider;
+    auto mixedDocument = netlist(2000, 11);
+    Node* mixed = mixedDocument.root.get();
+    provider.layout(mixed);
+    bool placed = std::all_of(mixed->children.begin(), mixed->children.end(), [](const auto& child) {
+        return child->position.x >= 0 && child->position.y >= 0;
+    });
+    check(placed && mixed->size.width > 0, "generated netlist lays out");
+
+    RecursiveConfig config;
+    config.strategy = RecursiveStrategy::BOTTOM_UP;
+    RecursiveLayoutEngine::layout(top, &provider, config);
+    check(sub && sub->size.width > 30, "instances grow to fit their contents");
+
+    std::cout << (failures == 0 ? "All generator tests passed" : "Generator tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+// Test ID lookup through a GraphIndex
+// Node::findNode and findPort answer as a walk of the tree would, also
+// when an ID is used twice.
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/graph/graph.h>
+#include <elk/graph/graph_index.h>
+#include <iostream>
+#include <string>
+
+#include "test_check.h"
+
+using namespace elk;
+
+int main() {
+    Node root("root");
+    GraphIndex index;
+    root.index = &index;
+
+    Node* left = root.addChild("left");
+    Node* right = root.addChild("right");
+    Port* leftPort = left->addPort("p");
+    Port* rightPort = right->addPort("q");
+    Edge* edge = root.addEdge("e");
+
+    check(index.nodeCount() == 2 && index.portCount() == 2 && index.edgeCount() == 1,
+          "factory methods register their elements");
+    check(root.findNode("right") == right && root.findNode("root") == &root, "findNode from the root");
+    check(left->findNode("right") == nullptr, "findNode does not look outside the node");
+    check(root.findNode("missing") == nullptr, "unknown node ID");
+    check(left->findPort("p") == leftPort && right->findPort("p") == nullptr, "findPort on the port's node only");
+    check(index.findEdge("e") == edge, "findEdge");
+
+    // The same IDs again under right; the index now maps them there
+    Node* leftCell = left->addChild("cell");
+    Node* rightCell = right->addChild("cell");
+    Port* rightP = right->addPort("p");
+    check(index.findNode("cell") == rightCell && index.findPort("p") == rightP, "a reused ID maps to the later element");
+    check(left->findNode("cell") == leftCell, "findNode finds a reused ID under the node searched");
+    check(right->findNode("cell") == rightCell, "and the indexed element under its own node");
+    check(root.findNode("cell") == leftCell, "from the root, the first element in tree order");
+    check(left->findPort("p") == leftPort && right->findPort("p") == rightP,
+          "findPort finds a reused ID on the node searched");
+    check(right->findPort("q") == rightPort && !index.isPortIdReused("q"), "other ports are unaffected");
+    Port* secondQ = right->addPort("q");
+    check(right->findPort("q") == rightPort && secondQ != rightPort, "the first of two ports with one ID");
+
+    // Removing elements requires a rebuild
+    right->children.clear();
+    index.build(&root);
+    check(root.findNode("cell") == leftCell && right->findNode("cell") == nullptr, "rebuilt after a removal");
+
+    std::cout << (failures == 0 ? "All graph index tests passed" : "Graph index tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+// Test native hyperedge import and long-edge merging in the layered algorithm
+// A net with several targets lays out as one object: its targets are all
+// placed and routed, it needs fewer dummies than the same net given as
+// separate edges, and it gets a section per target. With long-edge merging,
+// separate edges from one port share dummies like a net.
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/alg/layered/layered_layout.h>
+#include <elk/core/trace.h>
+#include <elk/testing/generators.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace elk;
+using namespace elk::testing;
+
+// Turns all edges leaving the same port into one edge with several targets
+static void mergeNets(Node* module) {
+    std::map<Port*, Edge*> nets;
+    for (auto& edge : module->edges) {
+        auto inserted = nets.emplace(edge->sourcePorts[0], edge.get());
+        if (!inserted.second) {
+            inserted.first->second->targetPorts.push_back(edge->targetPorts[0]);
+            edge->targetPorts.clear();
+        }
+    }
+    module->edges.erase(std::remove_if(module->edges.begin(), module->edges.end(),
+                                       [](const auto& edge) { return edge->targetPorts.empty(); }),
+                        module->edges.end());
+}
+
+static Point anchor(const Port* port) {
+    return {port->parent->position.x + port->position.x, port->parent->position.y + port->position.y};
+}
+
+static bool near(const Point& a, const Point& b) {
+    return std::abs(a.x - b.x) < 0.01 && std::abs(a.y - b.y) < 0.01;
+}
+
+// Every edge has a section per target that connects its source to that
+// target (backwards for edges reversed to break cycles), naming both ends
+// when the edge is a hyperedge
+static bool routed(const Node& module) {
+    for (const auto& edge : module.edges) {
+        if (edge->sections.size() != edge->targetPorts.size()) return false;
+        const Port* source = edge->sourcePorts[0];
+        for (size_t i = 0; i < edge->targetPorts.size(); i++) {
+            const EdgeSection& section = edge->sections[i];
+            const Port* target = edge->targetPorts[i];
+            bool forward = near(section.startPoint, anchor(source)) && near(section.endPoint, anchor(target));
+            bool backward = near(section.startPoint, anchor(target)) && near(section.endPoint, anchor(source));
+            if (!forward && !backward) return false;
+            if (edge->isHyperedge() && (section.getIncomingPort() != (forward ? source : target) ||
+                                        section.getOutgoingPort() != (forward ? target : source))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+struct Counts {
+    std::int64_t dummies = 0;
+    std::int64_t edges = 0;
+};
+
+static Counts layout(Node* graph, bool mergeLongEdges = false) {
+    trace::Tracer tracer;
+    {
+        trace::TraceScope scope(tracer);
+        layered::LayeredLayoutProvider provider;
+        provider.setMergeLongEdges(mergeLongEdges);
+        provider.layout(graph);
+    }
+    return {tracer.counter(trace::Counter::DUMMY_NODES), tracer.counter(trace::Counter::EDGE_ALLOCATIONS)};
+}
+
+// A driver whose net reaches into the first, second and third layer after
+// it, next to a chain of gates that pins those layers
+static void buildStaircase(Node* module, bool merged) {
+    NetlistBuilder builder(module);
+    Node* in = builder.addInput("in");
+    Node* out = builder.addOutput("out");
+    Node* driver = builder.addInput("d");
+    Port* previous = NetlistBuilder::pin(in, "Y");
+    std::vector<Port*> riders;
+    for (int i = 0; i < 4; i++) {
+        Node* gate = builder.addCell(CellKind::AND);
+        builder.connect(previous, NetlistBuilder::pin(gate, "A"));
+        if (i == 0) {
+            builder.connect(NetlistBuilder::pin(in, "Y"), NetlistBuilder::pin(gate, "B"));
+        } else {
+            riders.push_back(NetlistBuilder::pin(gate, "B"));
+        }
+        previous = NetlistBuilder::pin(gate, "Y");
+    }
+    builder.connect(previous, NetlistBuilder::pin(out, "A"));
+    if (merged) {
+        Edge* net = builder.connect(NetlistBuilder::pin(driver, "Y"), riders[0]);
+        net->targetPorts.insert(net->targetPorts.end(), riders.begin() + 1, riders.end());
+    } else {
+        for (Port* rider : riders) {
+            builder.connect(NetlistBuilder::pin(driver, "Y"), rider);
+        }
+    }
+}
+
+int main() {
+#if ELK_TRACE_LEVEL == 0
+    std::cout << "Tracing is compiled out (ELK_TRACE_LEVEL=0), nothing to test\n";
+    return 0;
+#endif
+
+    // Staircase: separate edges need 0 + 1 + 2 dummies, the net shares them
+    Node separate("separate");
+    buildStaircase(&separate, false);
+    Counts separateCounts = layout(&separate);
+    Node merged("merged");
+    buildStaircase(&merged, true);
+    Counts mergedCounts = layout(&merged);
+    check(separateCounts.dummies == 3, "separate edges get a dummy chain each");
+    check(mergedCounts.dummies == 2, "a net shares one dummy chain up to its farthest target");
+    check(routed(separate) && routed(merged), "each target gets a section from the driver");
+    bool samePlacement = true;
+    for (size_t i = 0; i < merged.children.size(); i++) {
+        samePlacement &= merged.children[i]->position.x == separate.children[i]->position.x;
+    }
+    check(samePlacement, "a net lands its cells in the same layers as separate edges");
+
+    // Register file: clock and reset each reach every flip-flop
+    auto separateDocument = registerFile(8, 16);
+    Node* separateFile = separateDocument.root.get();
+    Counts fileCounts = layout(separateFile);
+    auto mergedDocument = registerFile(8, 16);
+    Node* mergedFile = mergedDocument.root.get();
+    size_t edgesBefore = mergedFile->edges.size();
+    mergeNets(mergedFile);
+    size_t targets = 0;
+    for (const auto& edge : mergedFile->edges) {
+        targets += edge->targetPorts.size();
+    }
+    check(mergedFile->edges.size() < edgesBefore && targets == edgesBefore, "nets keep all their riders");
+    Counts netCounts = layout(mergedFile);
+    check(netCounts.dummies < fileCounts.dummies,
+          "register file with nets needs " + std::to_string(netCounts.dummies) + " dummies instead of " +
+              std::to_string(fileCounts.dummies));
+    check(netCounts.edges < fileCounts.edges, "and fewer layered edges");
+    check(routed(*mergedFile), "every rider of every net is routed");
+
+    // Long-edge merging: separate edges from one port share a chain as well
+    Node mergedSeparate("mergedSeparate");
+    buildStaircase(&mergedSeparate, false);
+    check(layout(&mergedSeparate, true).dummies == 2, "merging shares dummies between separate edges");
+    check(routed(mergedSeparate), "merged edges still get their own section");
+
+    auto mergingDocument = registerFile(8, 16);
+    Node* mergingFile = mergingDocument.root.get();
+    Counts mergingCounts = layout(mergingFile, true);
+    check(mergingCounts.dummies == netCounts.dummies, "merging needs as many dummies as nets (" +
+                                                           std::to_string(mergingCounts.dummies) + ")");
+    check(routed(*mergingFile), "every merged edge is routed");
+
+    auto unmergedDocument = netlist(3000, 5);
+    Counts unmergedCounts = layout(unmergedDocument.root.get());
+    auto mergingNetlist = netlist(3000, 5);
+    Counts mergingNetlistCounts = layout(mergingNetlist.root.get(), true);
+    check(mergingNetlistCounts.dummies < unmergedCounts.dummies,
+          "merging cuts netlist dummies from " + std::to_string(unmergedCounts.dummies) + " to " +
+              std::to_string(mergingNetlistCounts.dummies));
+    check(routed(*mergingNetlist.root), "every netlist edge is routed");
+
+    std::cout << (failures == 0 ? "All hyperedge tests passed" : "Hyperedge tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+// Test the ELK JSON reader on string escapes and deep nesting
+// \u escapes decode to UTF-8, and surrogates that do not form a high-low
+// pair are rejected. Nesting past the reader's depth limit is a parse
+// error, not a stack overflow.
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/io/json_reader.h>
+#include <iostream>
+#include <string>
+
+#include "test_check.h"
+
+using namespace elk;
+
+// Root ID read from a graph whose id is the given JSON string body
+static std::string readId(const std::string& escaped) {
+    io::GraphDocument document = io::readElkJson("{\"id\":\"" + escaped + "\"}");
+    return document.root->id.str();
+}
+
+static bool rejects(const std::string& escaped) {
+    try {
+        readId(escaped);
+    } catch (const io::JsonReadError&) {
+        return true;
+    }
+    return false;
+}
+
+// Root graph with an unknown member holding depth nested arrays
+static bool readsNested(std::size_t depth) {
+    std::string json = "{\"id\":\"root\",\"extra\":" + std::string(depth, '[') + std::string(depth, ']') + "}";
+    try {
+        io::readElkJson(json);
+    } catch (const io::JsonReadError&) {
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    check(readId("a\\nb\\u0041") == "a\nbA", "simple escapes");
+    check(readId("\\u00e9\\u20ac") == "\xC3\xA9\xE2\x82\xAC", "two and three byte code points");
+    check(readId("\\ud83d\\ude00") == "\xF0\x9F\x98\x80", "surrogate pair");
+
+    check(rejects("\\ud83d\\u0041"), "high surrogate followed by a non-surrogate");
+    check(rejects("\\ud83d\\ud83d"), "high surrogate followed by a high surrogate");
+    check(rejects("\\ud83dx"), "lone high surrogate");
+    check(rejects("\\ude00"), "lone low surrogate");
+    check(rejects("\\ude00\\ud83d"), "pair in the wrong order");
+
+    check(readsNested(1000), "1000 nested arrays");
+    check(!readsNested(1000000), "1000000 nested arrays are rejected");
+
+    std::cout << (failures == 0 ? "All JSON reader tests passed" : "JSON reader tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+// Test layer assignment
+// Longest-path layering puts every node as far right as its longest path to
+// a sink allows, honours FIRST/LAST layer constraints, and handles chains
+// far deeper than the call stack. Network simplex layering keeps edges
+// short and needs fewer dummies. Coffman-Graham layering bounds the number
+// of cells per layer. Node promotion moves cells back where that saves
+// dummies.
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/alg/layered/layered_layout.h>
+#include <elk/core/trace.h>
+#include <elk/testing/generators.h>
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace elk;
+using namespace elk::testing;
+
+// Lays out a chain of inverters and tells whether there is one per layer
+static bool onePerLayer(std::size_t depth, layered::LayeredLayoutProvider& provider) {
+    auto document = inverterChain(depth);
+    Node* chain = document.root.get();
+    provider.layout(chain);
+    std::vector<double> xs;
+    for (const auto& child : chain->children) {
+        if (child->id.str().find("$not$") != std::string::npos) xs.push_back(child->position.x);
+    }
+    bool ordered = xs.size() == depth;
+    for (std::size_t i = 1; ordered && i < xs.size(); i++) {
+        ordered = xs[i - 1] < xs[i];
+    }
+    return ordered;
+}
+
+#if ELK_TRACE_LEVEL > 0
+// Dummy nodes of a layout, whether it put both ends of an edge in the same
+// layer (cells of a layer share their x) and the dummies node promotion saved
+static std::int64_t layoutCountingDummies(Node* graph, layered::LayeredLayoutProvider& provider, bool& flatEdges,
+                                          std::int64_t* saved = nullptr) {
+    trace::Tracer tracer;
+    {
+        trace::TraceScope scope(tracer);
+        provider.layout(graph);
+    }
+    flatEdges = false;
+    for (const auto& edge : graph->edges) {
+        const Node* source = edge->sourcePorts[0]->parent;
+        const Node* target = edge->targetPorts[0]->parent;
+        flatEdges |= source != target && source->position.x == target->position.x;
+    }
+    if (saved) *saved = tracer.counter(trace::Counter::SAVED_DUMMIES);
+    return tracer.counter(trace::Counter::DUMMY_NODES);
+}
+#endif
+
+// Independent input -> inverter -> output paths
+static void addPaths(Node& module, int paths) {
+    NetlistBuilder builder(&module);
+    for (int i = 0; i < paths; i++) {
+        Node* input = builder.addInput("i" + std::to_string(i));
+        Node* inverter = builder.addCell(CellKind::NOT);
+        Node* output = builder.addOutput("o" + std::to_string(i));
+        builder.connect(NetlistBuilder::pin(input, "Y"), NetlistBuilder::pin(inverter, "A"));
+        builder.connect(NetlistBuilder::pin(inverter, "Y"), NetlistBuilder::pin(output, "A"));
+    }
+}
+
+// Most cells sharing a layer
+static std::size_t widestLayer(const Node& module) {
+    std::map<double, std::size_t> layers;
+    std::size_t widest = 0;
+    for (const auto& child : module.children) {
+        widest = std::max(widest, ++layers[child->position.x]);
+    }
+    return widest;
+}
+
+// x -> n1 -> n2 -> n3 -> y with a shortcut x -> d -> y and a sink m fed by
+// x, with the given layer constraints on m and d, layering strategy and
+// node promotion strategy
+struct Diamond {
+    Node module{"diamond"};
+    Node* x;
+    Node* n[3];
+    Node* d;
+    Node* m;
+    Node* y;
+
+    explicit Diamond(const std::string& mConstraint = "", const std::string& dConstraint = "",
+                     const std::string& layering = "", const std::string& promotion = "") {
+        NetlistBuilder builder(&module);
+        x = builder.addInput("x");
+        y = builder.addOutput("y");
+        Port* previous = NetlistBuilder::pin(x, "Y");
+        for (Node*& cell : n) {
+            cell = builder.addCell(CellKind::NOT);
+            builder.connect(previous, NetlistBuilder::pin(cell, "A"));
+            previous = NetlistBuilder::pin(cell, "Y");
+        }
+        builder.connect(previous, NetlistBuilder::pin(y, "A"));
+        d = builder.addCell(CellKind::NOT);
+        builder.connect(NetlistBuilder::pin(x, "Y"), NetlistBuilder::pin(d, "A"));
+        builder.connect(NetlistBuilder::pin(d, "Y"), NetlistBuilder::pin(y, "A"));
+        m = builder.addCell(CellKind::NOT);
+        builder.connect(NetlistBuilder::pin(x, "Y"), NetlistBuilder::pin(m, "A"));
+        if (!mConstraint.empty()) m->setProperty(LayoutOptions::LAYER_CONSTRAINT, mConstraint);
+        if (!dConstraint.empty()) d->setProperty(LayoutOptions::LAYER_CONSTRAINT, dConstraint);
+        if (!layering.empty()) module.setProperty(LayoutOptions::LAYERING_STRATEGY, layering);
+        if (!promotion.empty()) module.setProperty(LayoutOptions::NODE_PROMOTION_STRATEGY, promotion);
+        layered::LayeredLayoutProvider().layout(&module);
+    }
+};
+
+int main() {
+    // Longest path: nodes sit as far right as their path to a sink allows
+    Diamond plain;
+    check(plain.x->position.x < plain.n[0]->position.x && plain.n[0]->position.x < plain.n[1]->position.x &&
+              plain.n[1]->position.x < plain.n[2]->position.x && plain.n[2]->position.x < plain.y->position.x,
+          "a chain gets a layer per cell");
+    check(plain.d->position.x == plain.n[2]->position.x, "the shortcut sits in the layer before its sink");
+    check(plain.m->position.x > plain.n[2]->position.x, "a sink goes to the last layer");
+
+    // Layer constraints
+    Diamond first("FIRST");
+    check(first.m->position.x < first.n[0]->position.x, "FIRST moves a sink to the first layer");
+    Diamond last("", "LAST");
+    check(last.d->position.x == last.m->position.x, "LAST moves a node to the last layer");
+
+    // Network simplex: the sink stays next to its driver, selected per graph
+    Diamond simplex("", "", "NETWORK_SIMPLEX");
+    check(simplex.x->position.x < simplex.n[0]->position.x && simplex.n[0]->position.x < simplex.n[1]->position.x &&
+              simplex.n[1]->position.x < simplex.n[2]->position.x &&
+              simplex.n[2]->position.x < simplex.y->position.x,
+          "network simplex keeps the chain a layer per cell");
+    check(simplex.m->position.x == simplex.n[0]->position.x, "network simplex puts the sink right after its driver");
+    check(simplex.d->position.x > simplex.x->position.x && simplex.d->position.x < simplex.y->position.x,
+          "the shortcut stays between its ends");
+    Diamond simplexLast("", "LAST", "NETWORK_SIMPLEX");
+    check(simplexLast.d->position.x == simplexLast.y->position.x, "network simplex honours LAST");
+
+    // Coffman-Graham: the diamond fits in any bound of two or more
+    Diamond graham("", "", "COFFMAN_GRAHAM");
+    check(graham.x->position.x < graham.n[0]->position.x && graham.n[2]->position.x < graham.y->position.x &&
+              graham.d->position.x > graham.x->position.x && graham.d->position.x < graham.y->position.x,
+          "coffman-graham keeps every edge pointing right");
+
+    // Node promotion: the sink moves back next to its driver, LAST stays
+    Diamond promoted("", "", "", "NIKOLOV");
+    check(promoted.m->position.x == promoted.n[0]->position.x, "promotion moves the sink back to its driver");
+    check(promoted.n[2]->position.x < promoted.y->position.x && promoted.d->position.x < promoted.y->position.x,
+          "promotion keeps every edge pointing right");
+    Diamond promotedLast("", "LAST", "", "NO_BOUNDARY");
+    check(promotedLast.d->position.x >= promotedLast.y->position.x, "promotion leaves LAST nodes in the last layer");
+
+    layered::LayeredLayoutProvider longestPath;
+    layered::LayeredLayoutProvider networkSimplex;
+    networkSimplex.setLayering(LayeringStrategy::NETWORK_SIMPLEX);
+    layered::LayeredLayoutProvider coffmanGraham;
+    coffmanGraham.setLayering(LayeringStrategy::COFFMAN_GRAHAM);
+    coffmanGraham.setCoffmanGrahamLayerBound(40);
+    layered::LayeredLayoutProvider promoting;
+    promoting.setNodePromotion(NodePromotionStrategy::NIKOLOV);
+
+    Node unbounded("paths");
+    addPaths(unbounded, 300);
+    unbounded.setProperty(LayoutOptions::LAYERING_STRATEGY, std::string("COFFMAN_GRAHAM"));
+    longestPath.layout(&unbounded);
+    check(widestLayer(unbounded) == 300, "without a bound coffman-graham puts the paths in three layers");
+    Node bounded("paths");
+    addPaths(bounded, 300);
+    bounded.setProperty(LayoutOptions::LAYERING_STRATEGY, std::string("COFFMAN_GRAHAM"));
+    bounded.setProperty(LayoutOptions::COFFMAN_GRAHAM_LAYER_BOUND, 40.0);
+    longestPath.layout(&bounded);
+    check(widestLayer(bounded) <= 40, "the layer bound option limits a layer to 40 cells");
+    Node boundedText("paths");
+    addPaths(boundedText, 300);
+    boundedText.setProperty(Properties::LAYERED_LAYERING_STRATEGY, std::string("COFFMAN_GRAHAM"));
+    boundedText.setProperty(Properties::LAYERED_COFFMAN_GRAHAM_LAYER_BOUND, std::string("40"));
+    longestPath.layout(&boundedText);
+    check(widestLayer(boundedText) <= 40, "the layer bound option is read from a string");
+    Node boundedInteger("paths");
+    addPaths(boundedInteger, 300);
+    boundedInteger.setProperty(Properties::LAYERED_LAYERING_STRATEGY, std::string("COFFMAN_GRAHAM"));
+    boundedInteger.setProperty(Properties::LAYERED_COFFMAN_GRAHAM_LAYER_BOUND, 40);
+    longestPath.layout(&boundedInteger);
+    check(widestLayer(boundedInteger) <= 40, "and from an integer");
+#if ELK_TRACE_LEVEL > 0
+    auto longestDocument = netlist(3000, 5);
+    auto simplexDocument = netlist(3000, 5);
+    bool longestFlat = true;
+    bool simplexFlat = true;
+    std::int64_t longestDummies = layoutCountingDummies(longestDocument.root.get(), longestPath, longestFlat);
+    std::int64_t simplexDummies = layoutCountingDummies(simplexDocument.root.get(), networkSimplex, simplexFlat);
+    check(!longestFlat && !simplexFlat, "no edge has both ends in one layer");
+    check(simplexDummies < longestDummies, "network simplex cuts netlist dummies from " +
+                                               std::to_string(longestDummies) + " to " +
+                                               std::to_string(simplexDummies));
+
+    auto grahamDocument = netlist(3000, 5);
+    bool grahamFlat = true;
+    layoutCountingDummies(grahamDocument.root.get(), coffmanGraham, grahamFlat);
+    check(!grahamFlat, "coffman-graham puts no edge in one layer");
+
+    auto promotedDocument = netlist(3000, 5);
+    bool promotedFlat = true;
+    std::int64_t saved = 0;
+    std::int64_t promotedDummies = layoutCountingDummies(promotedDocument.root.get(), promoting, promotedFlat, &saved);
+    check(!promotedFlat, "promotion puts no edge in one layer");
+    check(promotedDummies < longestDummies && saved == longestDummies - promotedDummies,
+          "promotion cuts netlist dummies from " + std::to_string(longestDummies) + " to " +
+              std::to_string(promotedDummies) + " and reports the saving");
+    std::int64_t sweepSaved[3] = {0, 0, 0};
+    for (int i = 0; i < 3; i++) {
+        auto document = netlist(1000, 5);
+        if (i == 1) document.root->setProperty(LayoutOptions::NODE_PROMOTION_MAX_ITERATIONS, 1.0);
+        if (i == 2) document.root->setProperty(Properties::LAYERED_NODE_PROMOTION_MAX_ITERATIONS, std::string("1"));
+        bool flat = true;
+        layoutCountingDummies(document.root.get(), promoting, flat, &sweepSaved[i]);
+    }
+    check(sweepSaved[1] < sweepSaved[0] && sweepSaved[2] == sweepSaved[1],
+          "a maxIterations string of 1 limits promotion to one sweep");
+    Node stacked("paths");
+    bool stackedFlat = true;
+    addPaths(stacked, 300);
+    check(layoutCountingDummies(&stacked, coffmanGraham, stackedFlat) == 0 && widestLayer(stacked) <= 40,
+          "bounded paths are stacked without long edges");
+#endif
+
+    // Deep chains need no recursion
+    const std::size_t depth = 200000;
+    check(onePerLayer(depth, longestPath),
+          "a chain of " + std::to_string(depth) + " inverters lays out one per layer");
+    check(onePerLayer(depth, networkSimplex), "and so it does with network simplex");
+    check(onePerLayer(depth, coffmanGraham), "and with coffman-graham");
+    check(onePerLayer(depth, promoting), "and after node promotion");
+
+    std::cout << (failures == 0 ? "All layering tests passed" : "Layering tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+// Test the layout cache
+// A hit must reproduce a fresh layout exactly without running the provider;
+// configuration changes must miss, and the memory bound must evict
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/core/layout_cache.h>
+#include <elk/alg/layered/layered_layout.h>
+#include <elk/io/json_reader.h>
+#include <elk/io/json_writer.h>
+#include <iostream>
+#include <string>
+
+#include "test_check.h"
+
+using namespace elk;
+
+#ifndef ELK_EXAMPLE_DATA_DIR
+#define ELK_EXAMPLE_DATA_DIR "examples/data"
+#endif
+
+static io::GraphDocument load(const std::string& name) {
+    return io::readElkJsonFile(std::string(ELK_EXAMPLE_DATA_DIR) + "/" + name);
+}
+
+static std::string dump(const Node& root) {
+    std::string json;
+    io::writeElkJson(root, json);
+    return json;
+}
+
+// Counts calls that reach the wrapped provider
+class CountingProvider : public ILayoutProvider {
+public:
+    void layout(Node* graph, ProgressCallback progress) override {
+        calls++;
+        inner.layout(graph, progress);
+    }
+    std::string getAlgorithmId() const override { return inner.getAlgorithmId(); }
+    void hashConfiguration(FingerprintHasher& hasher) const override {
+        inner.hashConfiguration(hasher);
+    }
+
+    layered::LayeredLayoutProvider inner;
+    int calls = 0;
+};
+
+// Adds a node before laying out, so its results never fit the input
+class GrowingProvider : public CountingProvider {
+public:
+    void layout(Node* graph, ProgressCallback progress) override {
+        graph->addChild("added");
+        CountingProvider::layout(graph, progress);
+    }
+};
+
+int main() {
+    CountingProvider provider;
+    LayoutCache cache(provider);
+
+    // Reference: uncached layout
+    io::GraphDocument reference = load("up3down5.elk.json");
+    layered::LayeredLayoutProvider().layout(reference.root.get());
+    std::string expected = dump(*reference.root);
+
+    io::GraphDocument first = load("up3down5.elk.json");
+    cache.layout(first.root.get());
+    check(provider.calls == 1, "miss runs the provider");
+    check(dump(*first.root) == expected, "miss result matches uncached layout");
+
+    io::GraphDocument second = load("up3down5.elk.json");
+    cache.layout(second.root.get());
+    check(provider.calls == 1, "hit does not run the provider");
+    check(dump(*second.root) == expected, "hit result matches uncached layout");
+
+    LayoutCacheStats stats = cache.stats();
+    check(stats.hits == 1 && stats.misses == 1, "hit and miss counters");
+    check(stats.entries == 1 && stats.bytes > 0, "one entry with nonzero size");
+
+    // Edge sections must point at the new graph's shapes, not the old ones
+    bool shapesLocal = true;
+    for (const auto& edge : second.root->edges) {
+        for (const auto& section : edge->sections) {
+            if (section.parent != edge.get()) shapesLocal = false;
+            if (Port* port = section.getIncomingPort()) {
+                if (port->parent->parent != second.root.get()) shapesLocal = false;
+            }
+        }
+    }
+    check(shapesLocal, "replayed sections refer to the target graph");
+
+    // Input and configuration changes miss
+    io::GraphDocument resized = load("up3down5.elk.json");
+    resized.root->children.front()->size.width += 10;
+    cache.layout(resized.root.get());
+    check(provider.calls == 2, "changed node size misses");
+
+    provider.inner.setLayerSpacing(80);
+    io::GraphDocument respaced = load("up3down5.elk.json");
+    cache.layout(respaced.root.get());
+    check(provider.calls == 3, "changed provider configuration misses");
+    check(cache.stats().entries == 3, "three distinct entries");
+
+    // Memory bound: room for about one entry
+    LayoutCache small(provider, stats.bytes + stats.bytes / 2);
+    io::GraphDocument a = load("up3down5.elk.json");
+    io::GraphDocument b = load("up3down5.elk.json");
+    b.root->children.front()->size.height += 5;
+    small.layout(a.root.get());
+    small.layout(b.root.get());
+    LayoutCacheStats smallStats = small.stats();
+    check(smallStats.evictions == 1 && smallStats.entries == 1, "LRU bound evicts the oldest entry");
+    check(smallStats.bytes <= small.maxBytes(), "bytes stay within the bound");
+
+    io::GraphDocument again = load("up3down5.elk.json");
+    again.root->children.front()->size.height += 5;
+    int before = provider.calls;
+    small.layout(again.root.get());
+    check(provider.calls == before, "most recent entry survives eviction");
+
+    GrowingProvider growing;
+    LayoutCache unfit(growing);
+    io::GraphDocument grown = load("up3down5.elk.json");
+    io::GraphDocument plain = load("up3down5.elk.json");
+    unfit.layout(grown.root.get());
+    unfit.layout(plain.root.get());
+    LayoutCacheStats unfitStats = unfit.stats();
+    check(growing.calls == 2 && unfitStats.hits == 0 && unfitStats.misses == 2,
+          "entry the graph does not fit counts as a miss");
+
+    cache.clear();
+    check(cache.stats().entries == 0 && cache.stats().bytes == 0, "clear drops all entries");
+
+    std::cout << (failures == 0 ? "All layout cache tests passed" : "Layout cache tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+// Test layout sessions
+// Layouts run through one long-lived session must equal layouts run with a
+// fresh session each time, whatever the previous graphs looked like, and a
+// warmed-up session allocates little more than the laid-out edges themselves
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/alg/layered/layered_layout.h>
+#include <elk/io/json_reader.h>
+#include <elk/io/json_writer.h>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace elk;
+using namespace elk::layered;
+
+#ifndef ELK_EXAMPLE_DATA_DIR
+#define ELK_EXAMPLE_DATA_DIR "examples/data"
+#endif
+
+// Every allocation of the process is counted
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+static std::string dump(const Node& root) {
+    std::string json;
+    io::writeElkJson(root, json);
+    return json;
+}
+
+// Chain of cells where every third stage feeds back two stages, giving
+// reversed edges, long edges and dummy segments
+static std::unique_ptr<Node> makeLadder(int stages) {
+    auto root = std::make_unique<Node>("ladder" + std::to_string(stages));
+    std::vector<Node*> cells;
+    for (int i = 0; i < stages; i++) {
+        Node* cell = root->addChild("c" + std::to_string(i));
+        cell->size = Size(30, 20 + 5 * (i % 4));
+        cell->addPort(cell->id.str() + ".A", PortSide::WEST)->size = Size(0, 0);
+        cell->addPort(cell->id.str() + ".Y", PortSide::EAST)->size = Size(0, 0);
+        cells.push_back(cell);
+    }
+    for (int i = 0; i + 1 < stages; i++) {
+        connectPorts(cells[i]->ports[1].get(), cells[i + 1]->ports[0].get(), root.get());
+        if (i % 3 == 2) {
+            connectPorts(cells[i]->ports[1].get(), cells[i - 2]->ports[0].get(), root.get());
+        }
+    }
+    return root;
+}
+
+// Owns whatever backs the root of a test graph
+struct TestGraph {
+    io::GraphDocument document;
+    std::unique_ptr<Node> built;
+    Node* root() { return built ? built.get() : document.root.get(); }
+};
+
+static std::function<TestGraph()> fromFile(const std::string& name) {
+    return [name]() {
+        TestGraph graph;
+        graph.document = io::readElkJsonFile(std::string(ELK_EXAMPLE_DATA_DIR) + "/" + name);
+        return graph;
+    };
+}
+
+static std::function<TestGraph()> ladder(int stages) {
+    return [stages]() {
+        TestGraph graph;
+        graph.built = makeLadder(stages);
+        return graph;
+    };
+}
+
+int main() {
+    // Large and small graphs interleaved, so that later runs see buffers
+    // left over from bigger ones
+    std::vector<std::pair<std::string, std::function<TestGraph()>>> graphs = {
+        {"up3down5", fromFile("up3down5.elk.json")},
+        {"ladder 3", ladder(3)},
+        {"ladder 80", ladder(80)},
+        {"vcc_and_gnd", fromFile("vcc_and_gnd.elk.json")},
+        {"ladder 12", ladder(12)},
+        {"up3down5 again", fromFile("up3down5.elk.json")},
+        {"ladder 1", ladder(1)},
+    };
+
+    LayeredLayoutProvider right;
+    LayeredLayoutProvider down;
+    down.setDirection(Direction::DOWN);
+
+    for (LayeredLayoutProvider* provider : {&right, &down}) {
+        std::string direction = provider == &right ? "right" : "down";
+
+        std::vector<std::string> expected;
+        for (auto& entry : graphs) {
+            TestGraph graph = entry.second();
+            provider->layout(graph.root());
+            expected.push_back(dump(*graph.root()));
+        }
+
+        LayoutSession session;
+        for (int round = 0; round < 2; round++) {
+            for (size_t i = 0; i < graphs.size(); i++) {
+                TestGraph graph = graphs[i].second();
+                provider->layout(graph.root(), session);
+                check(dump(*graph.root()) == expected[i],
+                      direction + ", round " + std::to_string(round) + ": " + graphs[i].first);
+            }
+        }
+        check(session.layoutCount() == 2 * graphs.size(), direction + ": session counts its layouts");
+
+        session.shrink();
+        TestGraph graph = graphs[2].second();
+        provider->layout(graph.root(), session);
+        check(dump(*graph.root()) == expected[2], direction + ": layout after shrink()");
+    }
+
+    // Sessions may be shared between differently configured providers
+    LayoutSession shared;
+    for (LayeredLayoutProvider* provider : {&right, &down, &right}) {
+        TestGraph fresh = graphs[0].second();
+        provider->layout(fresh.root());
+        TestGraph reused = graphs[0].second();
+        provider->layout(reused.root(), shared);
+        check(dump(*reused.root()) == dump(*fresh.root()), "session shared between providers");
+    }
+
+    // Empty graphs leave the session usable
+    Node empty("empty");
+    right.layout(&empty, shared);
+    TestGraph after = graphs[1].second();
+    right.layout(after.root(), shared);
+    TestGraph fresh = graphs[1].second();
+    right.layout(fresh.root());
+    check(dump(*after.root()) == dump(*fresh.root()), "layout after an empty graph");
+
+    // Once the session has seen a graph, laying it out again only allocates
+    // the bend point lists of the edge sections written into the graph
+    LayoutSession warm;
+    TestGraph big = graphs[2].second();
+    std::size_t before = allocations;
+    right.layout(big.root(), warm);
+    std::size_t freshAllocations = allocations - before;
+    for (int round = 0; round < 2; round++) {
+        right.layout(big.root(), warm);
+    }
+    before = allocations;
+    right.layout(big.root(), warm);
+    std::size_t warmAllocations = allocations - before;
+    std::cout << "  " << freshAllocations << " allocations with a new session, " << warmAllocations
+              << " with a warmed-up one\n";
+    check(warmAllocations <= big.root()->edges.size(), "warmed-up session allocates at most once per edge");
+    check(warmAllocations * 10 < freshAllocations, "and far less than a new session");
+
+    std::cout << (failures == 0 ? "All layout session tests passed" : "Layout session tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
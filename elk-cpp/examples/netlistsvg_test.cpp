@@ -54,8 +54,8 @@ void printOutputGraph(Node* root) {
 
     std::cout << "\nEdge routing:" << std::endl;
     for (const auto& edge : root->edges) {
-        std::string sourceId = edge->sourcePorts.empty() ? "none" : edge->sourcePorts[0]->id;
-        std::string targetId = edge->targetPorts.empty() ? "none" : edge->targetPorts[0]->id;
+        std::string sourceId = edge->sourcePorts.empty() ? "none" : edge->sourcePorts[0]->id.str();
+        std::string targetId = edge->targetPorts.empty() ? "none" : edge->targetPorts[0]->id.str();
         std::cout << "  " << edge->id << ": " << sourceId << " -> " << targetId << std::endl;
 
         for (size_t i = 0; i < edge->sections.size(); ++i) {
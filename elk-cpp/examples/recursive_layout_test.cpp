@@ -0,0 +1,146 @@
+// Test parallel bottom-up recursive layout
+// Parallel mode must leave the hierarchy exactly as the sequential mode
+// does; the work-stealing pool must handle nesting and exceptions
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/core/recursive_layout.h>
+#include <elk/core/thread_pool.h>
+#include <elk/alg/layered/layered_layout.h>
+#include <elk/io/json_writer.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "test_check.h"
+
+using namespace elk;
+
+static std::string dump(const Node& root) {
+    std::string json;
+    io::writeElkJson(root, json);
+    return json;
+}
+
+// Module hierarchy: every compound node holds a chain of cells plus
+// `fanout` submodules, down to `depth` levels
+static void populate(Node* module, int depth, int fanout) {
+    std::string prefix = module->id.str() + "/";
+    Node* previous = nullptr;
+    for (int i = 0; i < 4 + depth; i++) {
+        Node* cell = module->addChild(prefix + "c" + std::to_string(i));
+        cell->size = Size(30 + 4 * i, 20);
+        cell->addPort(cell->id.str() + ".A", PortSide::WEST);
+        cell->addPort(cell->id.str() + ".Y", PortSide::EAST);
+        if (previous) {
+            connectPorts(previous->ports[1].get(), cell->ports[0].get(), module);
+        }
+        previous = cell;
+    }
+    if (depth == 0) return;
+    for (int i = 0; i < fanout; i++) {
+        Node* sub = module->addChild(prefix + "m" + std::to_string(i));
+        sub->addPort(sub->id.str() + ".IN", PortSide::WEST);
+        sub->addPort(sub->id.str() + ".OUT", PortSide::EAST);
+        connectPorts(previous->ports[1].get(), sub->ports[0].get(), module);
+        populate(sub, depth - 1, fanout);
+    }
+}
+
+static std::unique_ptr<Node> makeDesign() {
+    auto root = std::make_unique<Node>("top");
+    populate(root.get(), 3, 3);
+    return root;
+}
+
+static std::string layoutDesign(bool parallel, unsigned threads, WorkStealingPool* pool) {
+    auto design = makeDesign();
+    layered::LayeredLayoutProvider provider;
+    RecursiveConfig config;
+    config.strategy = RecursiveStrategy::BOTTOM_UP;
+    config.parallel = parallel;
+    config.threads = threads;
+    config.pool = pool;
+    RecursiveLayoutEngine::layout(design.get(), &provider, config);
+    return dump(*design);
+}
+
+static void testPool() {
+    WorkStealingPool pool(3);
+
+    // Nested fork/join: sum of 1..n computed by binary splitting
+    std::function<long(long, long)> sum = [&](long first, long last) -> long {
+        if (last - first < 8) {
+            long total = 0;
+            for (long i = first; i <= last; i++) total += i;
+            return total;
+        }
+        long middle = (first + last) / 2;
+        long left = 0;
+        TaskGroup group(pool);
+        group.run([&]() { left = sum(first, middle); });
+        long right = sum(middle + 1, last);
+        group.wait();
+        return left + right;
+    };
+    check(sum(1, 10000) == 50005000L, "nested task groups");
+
+    // Single worker with nesting deeper than the pool
+    WorkStealingPool single(1);
+    std::atomic<int> ran{0};
+    {
+        TaskGroup outer(single);
+        for (int i = 0; i < 4; i++) {
+            outer.run([&]() {
+                TaskGroup inner(single);
+                for (int j = 0; j < 4; j++) inner.run([&]() { ran++; });
+                inner.wait();
+            });
+        }
+        outer.wait();
+    }
+    check(ran.load() == 16, "nesting on a one-thread pool");
+
+    bool caught = false;
+    try {
+        TaskGroup group(pool);
+        group.run([]() { throw std::runtime_error("task failed"); });
+        group.run([]() {});
+        group.wait();
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()) == "task failed";
+    }
+    check(caught, "task exception reaches wait()");
+}
+
+int main() {
+    testPool();
+
+    auto start = std::chrono::steady_clock::now();
+    std::string expected = layoutDesign(false, 0, nullptr);
+    double sequentialMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    for (unsigned threads : {1u, 2u, 4u, 0u}) {
+        start = std::chrono::steady_clock::now();
+        std::string result = layoutDesign(true, threads, nullptr);
+        double parallelMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "threads=" << threads << ": " << parallelMs << " ms (sequential "
+                  << sequentialMs << " ms)\n";
+        check(result == expected, "parallel bottom-up matches sequential");
+    }
+
+    WorkStealingPool shared(4);
+    bool same = true;
+    for (int run = 0; run < 3; run++) {
+        if (layoutDesign(true, 0, &shared) != expected) same = false;
+    }
+    check(same, "reused pool matches sequential");
+
+    std::cout << (failures == 0 ? "All recursive layout tests passed" : "Recursive layout tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
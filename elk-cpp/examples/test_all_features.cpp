@@ -237,10 +237,14 @@ bool testIncrementalLayout() {
 
 // Test 8: Configuration System
 bool testConfigurationSystem() {
-    auto& config = GlobalConfig::instance();
-
-    config.setValue(GlobalConfig::NODE_SPACING, 25.0);
-    double spacing = config.getValue(GlobalConfig::NODE_SPACING, 20.0);
+    ConfigurationStore config;
+    LayoutOption nodeSpacing;
+    nodeSpacing.id = CoreOptions::NODE_SPACING;
+    nodeSpacing.defaultValue = 20.0;
+    config.registerOption(nodeSpacing);
+
+    config.setValue(CoreOptions::NODE_SPACING, 25.0);
+    double spacing = config.getValue(CoreOptions::NODE_SPACING, 20.0);
 
     return spacing == 25.0;
 }
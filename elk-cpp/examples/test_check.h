@@ -0,0 +1,16 @@
+// Shared checks of the example tests
+// Each check prints one PASS or FAIL line; failures counts the failed ones
+// for the test's exit code.
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+
+inline int failures = 0;
+
+inline void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  PASS " : "  FAIL ") << what << "\n";
+    if (!condition) failures++;
+}
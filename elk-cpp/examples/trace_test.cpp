@@ -0,0 +1,156 @@
+// Test layout tracing
+// Phase timers, counters, log levels and the Chrome trace export of a
+// traced layered layout
+// SPDX-License-Identifier: EPL-2.0
+
+#include <elk/alg/layered/layered_layout.h>
+#include <elk/core/trace.h>
+#include <elk/io/json_reader.h>
+#include <elk/io/json_writer.h>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace elk;
+
+#ifndef ELK_EXAMPLE_DATA_DIR
+#define ELK_EXAMPLE_DATA_DIR "examples/data"
+#endif
+
+static std::string dump(const Node& root) {
+    std::string json;
+    io::writeElkJson(root, json);
+    return json;
+}
+
+static size_t occurrences(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+// Complete bipartite graph between two columns of n cells; any two-layer
+// drawing of it has C(n,2)^2 crossings
+static std::unique_ptr<Node> makeBipartite(int n) {
+    auto root = std::make_unique<Node>("bipartite");
+    std::vector<Port*> outputs;
+    std::vector<Port*> inputs;
+    for (int i = 0; i < n; i++) {
+        Node* source = root->addChild("s" + std::to_string(i));
+        source->size = Size(30, 30);
+        outputs.push_back(source->addPort("s" + std::to_string(i) + ".Y", PortSide::EAST));
+        Node* target = root->addChild("t" + std::to_string(i));
+        target->size = Size(30, 30);
+        inputs.push_back(target->addPort("t" + std::to_string(i) + ".A", PortSide::WEST));
+    }
+    for (Port* output : outputs) {
+        for (Port* input : inputs) {
+            connectPorts(output, input, root.get());
+        }
+    }
+    return root;
+}
+
+int main() {
+#if ELK_TRACE_LEVEL == 0
+    std::cout << "Tracing is compiled out (ELK_TRACE_LEVEL=0), nothing to test\n";
+    return 0;
+#endif
+
+    const std::string path = std::string(ELK_EXAMPLE_DATA_DIR) + "/up3down5.elk.json";
+    layered::LayeredLayoutProvider provider;
+
+    io::GraphDocument untraced = io::readElkJsonFile(path);
+    provider.layout(untraced.root.get());
+
+    trace::Tracer tracer;
+    tracer.setRecordEvents(true);
+    io::GraphDocument traced = io::readElkJsonFile(path);
+    {
+        trace::TraceScope scope(tracer);
+        provider.layout(traced.root.get());
+    }
+    check(dump(*traced.root) == dump(*untraced.root), "tracing does not change the layout");
+
+    std::vector<trace::PhaseStats> phases = tracer.phases();
+    std::vector<std::string> names;
+    for (const auto& phase : phases) {
+        names.push_back(phase.name);
+    }
+    std::vector<std::string> expected = {"import", "cycle breaking", "layering", "margins", "dummies",
+                                         "crossing minimization", "placement", "routing", "apply"};
+    check(names == expected, "every phase is timed once, in order");
+    bool timesValid = std::all_of(phases.begin(), phases.end(), [](const trace::PhaseStats& phase) {
+        return phase.calls == 1 && phase.wallMs >= 0.0 && phase.cpuMs >= 0.0;
+    });
+    check(timesValid, "phase timings are recorded");
+
+    size_t ports = 0;
+    for (const auto& child : traced.root->children) {
+        ports += child->ports.size();
+    }
+    std::int64_t dummies = tracer.counter(trace::Counter::DUMMY_NODES);
+    check(tracer.counter(trace::Counter::NODE_ALLOCATIONS) ==
+              static_cast<std::int64_t>(traced.root->children.size()) + dummies,
+          "node allocations are the graph's nodes plus dummies");
+    std::int64_t dummyPorts = tracer.counter(trace::Counter::PORT_ALLOCATIONS) - static_cast<std::int64_t>(ports);
+    check(dummyPorts > 0 && dummyPorts < 2 * dummies,
+          "long edges only get ports where they start and end, not two per dummy");
+    check(tracer.counter(trace::Counter::ROUTING_SLOTS) > 0, "routing slots are counted");
+
+    // Chrome trace: one complete event per phase, one counter event per counter
+    std::ostringstream chrome;
+    tracer.writeChromeTrace(chrome);
+    std::string json = chrome.str();
+    check(json.rfind("{\"traceEvents\":[", 0) == 0, "Chrome trace starts with traceEvents");
+    check(occurrences(json, "\"ph\":\"X\"") == expected.size(), "Chrome trace has an event per phase");
+    check(occurrences(json, "\"ph\":\"C\"") == static_cast<size_t>(trace::Counter::COUNT),
+          "Chrome trace has an event per counter");
+
+    std::ostringstream summary;
+    tracer.writeSummary(summary);
+    check(summary.str().find("crossing minimization") != std::string::npos, "summary lists phases");
+
+    // reset() starts over; K(3,3) has 9 crossings in any order
+    tracer.reset();
+    auto bipartite = makeBipartite(3);
+    {
+        trace::TraceScope scope(tracer);
+        provider.layout(bipartite.get());
+    }
+    check(tracer.counter(trace::Counter::CROSSINGS) == 9, "crossings of K(3,3) are counted");
+    check(tracer.counter(trace::Counter::REVERSED_EDGES) == 0, "acyclic graph reverses no edges");
+
+    // Log levels: messages up to the level go to the log stream
+    std::ostringstream log;
+    trace::Tracer logger;
+    logger.setLogStream(log);
+    io::GraphDocument quiet = io::readElkJsonFile(path);
+    {
+        trace::TraceScope scope(logger);
+        provider.layout(quiet.root.get());
+    }
+    check(log.str().empty(), "default level writes no progress messages");
+
+    logger.setLogLevel(trace::Level::INFO);
+    io::GraphDocument verbose = io::readElkJsonFile(path);
+    {
+        trace::TraceScope scope(logger);
+        provider.layout(verbose.root.get());
+    }
+    check(log.str().find("=== BREAK CYCLES") != std::string::npos, "INFO level writes phase messages");
+    check(ELK_TRACE_LEVEL >= 3 || log.str().find("Barycenter") == std::string::npos,
+          "DEBUG messages are compiled out below ELK_TRACE_LEVEL 3");
+
+    check(trace::current() == nullptr, "scopes uninstall their tracer");
+
+    std::cout << (failures == 0 ? "All trace tests passed" : "Trace tests FAILED") << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -57,6 +57,7 @@ public:
 
     void layout(Node* graph, ProgressCallback progress = nullptr) override;
     std::string getAlgorithmId() const override { return "elk.force"; }
+    void hashConfiguration(FingerprintHasher& hasher) const override;
 
     // Configuration
     void setModel(ForceModel model) { model_ = model; }
@@ -64,14 +65,16 @@ public:
     void setRepulsion(double repulsion) { repulsion_ = repulsion; }
     void setSpringLength(double length) { springLength_ = length; }
     void setTemperature(double temp) { temperature_ = temp; }
+    void setRandomSeed(unsigned seed) { randomSeed_ = seed; }
 
 private:
     // Build internal graph representation
     void importGraph(Node* graph, std::vector<ForceNode>& nodes, std::vector<ForceEdge>& edges);
 
     // Force calculation methods
-    void calculateForces(std::vector<ForceNode>& nodes, const std::vector<ForceEdge>& edges);
-    void calculateRepulsiveForces(std::vector<ForceNode>& nodes);
+    void calculateForces(std::vector<ForceNode>& nodes, const std::vector<ForceEdge>& edges,
+                         std::mt19937& random);
+    void calculateRepulsiveForces(std::vector<ForceNode>& nodes, std::mt19937& random);
     void calculateAttractiveForces(const std::vector<ForceEdge>& edges);
 
     // Apply forces and update positions
@@ -90,21 +93,27 @@ private:
     double repulsion_ = 5.0;
     double springLength_ = 80.0;
     double temperature_ = 100.0;
-
-    std::mt19937 rng_;
+    unsigned randomSeed_ = 1;  // Each layout run starts its own generator from this
 };
 
 // ============================================================================
 // Force calculation helpers
 // ============================================================================
 
+// Small random displacement that separates coincident nodes
+inline Point randomDisplacement(std::mt19937& random) {
+    std::uniform_int_distribution<int> offset(-50, 49);
+    return {offset(random) * 0.01, offset(random) * 0.01};
+}
+
 // Eades model forces
-inline Point calculateEadesRepulsion(const Point& p1, const Point& p2, double repulsion) {
+inline Point calculateEadesRepulsion(const Point& p1, const Point& p2, double repulsion,
+                                     std::mt19937& random) {
     Point delta = p1 - p2;
     double dist = delta.length();
     if (dist < EPSILON) {
         // Add small random displacement to avoid singularity
-        return {(rand() % 100 - 50) * 0.01, (rand() % 100 - 50) * 0.01};
+        return randomDisplacement(random);
     }
     // Repulsive force: F = k / d²
     double force = repulsion / (dist * dist);
@@ -122,11 +131,12 @@ inline Point calculateEadesAttraction(const Point& p1, const Point& p2, double s
 }
 
 // Fruchterman-Reingold model forces
-inline Point calculateFRRepulsion(const Point& p1, const Point& p2, double k) {
+inline Point calculateFRRepulsion(const Point& p1, const Point& p2, double k,
+                                  std::mt19937& random) {
     Point delta = p1 - p2;
     double dist = delta.length();
     if (dist < EPSILON) {
-        return {(rand() % 100 - 50) * 0.01, (rand() % 100 - 50) * 0.01};
+        return randomDisplacement(random);
     }
     // Repulsive force: F = k² / d
     double force = (k * k) / dist;
@@ -0,0 +1,42 @@
+// Eclipse Layout Kernel - C++ Port
+// Parallel layout of many independent graphs
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "layered_layout.h"
+#include <cstddef>
+#include <vector>
+
+namespace elk {
+namespace layered {
+
+// ============================================================================
+// Batch layout
+// ============================================================================
+
+// Lay out independent graphs (e.g. the modules of a hierarchical design)
+// on a pool of worker threads. Every graph is laid out by its own copy of
+// options, so the result for each graph is exactly what
+// options.layout(graph) would produce on its own, whatever the thread count
+// or scheduling order.
+//
+// Graphs are handed out largest first (by node, port and edge count) to
+// whichever worker is idle, which keeps one big module from finishing long
+// after the others. threads == 0 uses std::thread::hardware_concurrency();
+// no more threads are started than there are graphs, and with one thread
+// the graphs are laid out on the calling thread.
+//
+// The graphs must not share elements. If layouts throw, the remaining
+// graphs are still laid out and the exception of the first failing graph
+// (in input order) is rethrown.
+void layoutBatch(Node* const* graphs, std::size_t count,
+                 const LayeredLayoutProvider& options, unsigned threads = 0);
+
+inline void layoutBatch(const std::vector<Node*>& graphs,
+                        const LayeredLayoutProvider& options, unsigned threads = 0) {
+    layoutBatch(graphs.data(), graphs.size(), options, threads);
+}
+
+} // namespace layered
+} // namespace elk
@@ -0,0 +1,103 @@
+// Eclipse Layout Kernel - C++ Port
+// Node promotion after layer assignment
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "../lgraph.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace elk {
+namespace layered {
+
+/**
+ * Moves nodes to earlier layers where that shortens their edges, so that
+ * fewer long-edge dummies are needed.
+ *
+ * Port of ELK's NodePromotion (the NIKOLOV and NO_BOUNDARY strategies) on
+ * the layered graph's adjacency rows. Sweeping over the nodes with incoming
+ * edges in layer order, each node is moved one layer back, pushing along
+ * every predecessor it would otherwise share a layer with. The move is
+ * kept if it saves dummies, counting one per layer an edge skips, and
+ * otherwise undone from a log of the moved nodes. ELK tries each node once
+ * per sweep; here a node keeps moving while that pays, which needs far
+ * fewer sweeps on netlists whose sources sit many layers before the cells
+ * they drive. The sweeps stop when one promotes nothing, after the given
+ * number of sweeps, or when the moves have visited that many times the
+ * graph's nodes and edges, which bounds the cascades a long chain would
+ * otherwise make quadratic.
+ *
+ * Unlike ELK, no layer is added in front of the first one, and nodes with
+ * a layer constraint or an edge that does not point forward stay put.
+ * Layers left empty are removed.
+ *
+ * Based on:
+ *   Nikolov, Tarassov, Branke. In search for efficient heuristics for
+ *   minimum-width graph layering with consideration of dummy nodes.
+ *   In Journal of Experimental Algorithmics, 2005.
+ *
+ * Holds its working arrays between runs; one instance per thread.
+ */
+class NodePromotion {
+public:
+    /**
+     * Updates the layerIndex of the nodes, which must form a proper
+     * layering from layer 0. Returns whether any node moved.
+     *
+     * @param nodes nodes of the layered graph, numbered by graphIndex.
+     * @param adjacency adjacency rows of the nodes.
+     * @param keepWidth reject promotions that make a layer wider, dummies
+     *        included, than the widest layer was before.
+     * @param maxSweeps most sweeps over the nodes, at least 1.
+     */
+    bool process(const std::vector<LNode*>& nodes, const LAdjacency& adjacency, bool keepWidth, int maxSweeps);
+
+    /** Dummies the layering needed before and after the last run, one per edge and skipped layer. */
+    std::int64_t dummiesBefore() const { return dummiesBefore_; }
+    std::int64_t dummiesAfter() const { return dummiesAfter_; }
+
+    /** Promotions kept and sweeps made by the last run. */
+    std::int64_t promotionCount() const { return promotions_; }
+    int sweepCount() const { return sweeps_; }
+
+    /** Releases all retained capacity. */
+    void shrink();
+
+private:
+    void initialize(const std::vector<LNode*>& nodes, const LAdjacency& adjacency);
+    bool promote(int node, const LAdjacency& adjacency, bool keepWidth);
+    bool move(int node, const LAdjacency& adjacency, bool keepWidth);
+    void undoMoves();
+    std::int64_t countDummies(const LAdjacency& adjacency) const;
+
+    int nodeCount_ = 0;
+    int maxWidth_ = 0;
+    std::int64_t budget_ = 0;
+    std::int64_t dummies_ = 0;
+    std::int64_t dummiesBefore_ = 0;
+    std::int64_t dummiesAfter_ = 0;
+    std::int64_t promotions_ = 0;
+    int sweeps_ = 0;
+
+    // Per node: layer, edges in and out (self-loops not counted), and
+    // whether it must stay in its layer
+    std::vector<int> layer_;
+    std::vector<int> inDegree_;
+    std::vector<int> outDegree_;
+    std::vector<char> fixed_;
+
+    // Per layer: nodes and dummies in it
+    std::vector<int> width_;
+
+    // Nodes with incoming edges in layer order, the nodes moved by the
+    // current promotion, and predecessors still to check, each with the
+    // layer it must end up before
+    std::vector<int> order_;
+    std::vector<int> moved_;
+    std::vector<std::pair<int, int>> stack_;
+};
+
+} // namespace layered
+} // namespace elk
@@ -7,6 +7,8 @@
 #include "../../core/layout_provider.h"
 #include "../../core/types.h"
 #include "lgraph.h"
+#include "layout_session.h"
+#include <limits>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -25,55 +27,77 @@ public:
     LayeredLayoutProvider();
 
     void layout(Node* graph, ProgressCallback progress = nullptr) override;
+
+    // Same, with temporary containers taken from session (see LayoutSession)
+    void layout(Node* graph, LayoutSession& session, ProgressCallback progress = nullptr);
     std::string getAlgorithmId() const override { return "elk.layered"; }
+    void hashConfiguration(FingerprintHasher& hasher) const override;
 
     // Configuration
     void setDirection(Direction dir) { direction_ = dir; }
     void setNodeSpacing(double spacing) { nodeSpacing_ = spacing; }
     void setLayerSpacing(double spacing) { layerSpacing_ = spacing; }
+    // Overridden per graph by elk.layered.layering.strategy
+    // ("LONGEST_PATH", "NETWORK_SIMPLEX" or "COFFMAN_GRAHAM")
+    void setLayering(LayeringStrategy strategy) { layeringStrategy_ = strategy; }
+    // Most nodes COFFMAN_GRAHAM puts into one layer, not counting dummies;
+    // overridden per graph by elk.layered.layering.coffmanGraham.layerBound
+    void setCoffmanGrahamLayerBound(int bound) { layerBound_ = bound; }
+    // Overridden per graph by elk.layered.layering.nodePromotion.strategy
+    // ("NONE", "NIKOLOV" or "NO_BOUNDARY")
+    void setNodePromotion(NodePromotionStrategy strategy) { nodePromotion_ = strategy; }
+    // Most sweeps node promotion makes; overridden per graph by
+    // elk.layered.layering.nodePromotion.maxIterations
+    void setNodePromotionMaxIterations(int iterations) { promotionIterations_ = iterations; }
     void setCrossingMinimization(CrossingMinimizationStrategy strategy) {
         crossingStrategy_ = strategy;
     }
     void setNodePlacement(NodePlacementStrategy strategy) {
         nodeStrategy_ = strategy;
     }
+    // Let long edges that leave the same port share one chain of dummy
+    // nodes up to the layer where their paths split, as the edges of a
+    // multi-terminal net always do. Off by default, which matches ELK.
+    void setMergeLongEdges(bool merge) { mergeLongEdges_ = merge; }
 
 private:
     // Phase 1: Import graph and create internal representation
-    void importGraph(Node* graph, std::vector<LNode*>& nodes, std::vector<LEdge*>& edges);
+    void importGraph(Node* graph, LayoutSession& session);
 
     // Phase 2: Cycle breaking - make graph acyclic
-    void breakCycles(std::vector<LNode*>& nodes, std::vector<LEdge*>& edges);
+    void breakCycles(LayoutSession& session);
 
     // Phase 2.5: Calculate node margins (for ports extending beyond bounds)
     void calculateNodeMargins(std::vector<LNode*>& nodes);
 
     // Phase 3: Layer assignment
-    void assignLayers(std::vector<LNode*>& nodes, std::vector<Layer>& layers);
-    std::vector<LNode*> assignLayersLongestPath(std::vector<LNode*>& nodes);
+    void assignLayers(const Node* graph, LayoutSession& session);
+    void assignLayersLongestPath(LayoutSession& session);
+    void fillLayers(LayoutSession& session, int layerCount);
+
+    // Move nodes to earlier layers where that saves dummies
+    void promoteNodes(const Node* graph, LayoutSession& session);
 
     // Phase 4: Add dummy nodes for edges spanning multiple layers
-    void insertDummyNodes(std::vector<LNode*>& nodes, std::vector<LEdge*>& edges, std::vector<Layer>& layers);
+    void insertDummyNodes(LayoutSession& session);
+    LNode* appendLongEdgeSlot(LongEdgeChain* chain, LayoutSession& session);
+    LPort* leaveLongEdge(LNode* slot, LayoutSession& session);
+    void connectLongEdgeSlot(LPort* from, LNode* slot, LayoutSession& session);
 
     // Phase 5: Crossing minimization
-    void minimizeCrossings(std::vector<Layer>& layers);
-    int countCrossings(const Layer& upperLayer, const Layer& lowerLayer);
-    void barycenterHeuristic(Layer& layer, bool useIncoming);
+    void minimizeCrossings(LayoutSession& session);
+    int countCrossings(const Layer& upperLayer, const Layer& lowerLayer, const LayoutSession& session);
+    void barycenterHeuristic(Layer& layer, bool useIncoming, LayoutSession& session);
 
     // Phase 6: Node placement (coordinate assignment)
-    void assignCoordinates(std::vector<Layer>& layers);
+    void assignCoordinates(LayoutSession& session);
     void linearSegmentPlacement(std::vector<Layer>& layers);
 
     // LinearSegmentsNodePlacer algorithm (faithful port from Java)
-    std::vector<LinearSegment*> sortLinearSegments(std::vector<Layer>& layers);
-    bool fillSegment(LNode* node, LinearSegment* segment);
-    void createDependencyGraphEdges(std::vector<Layer>& layers,
-                                     std::vector<LinearSegment*>& segmentList,
-                                     std::vector<std::vector<LinearSegment*>>& outgoingList,
-                                     std::vector<int>& incomingCountList,
-                                     int& nextLinearSegmentID);
-    void createUnbalancedPlacement(std::vector<Layer>& layers,
-                                    const std::vector<LinearSegment*>& linearSegments);
+    void sortLinearSegments(LayoutSession& session);
+    bool fillSegment(LNode* node, LinearSegment* segment, const LAdjacency& adjacency);
+    void createDependencyGraphEdges(LayoutSession& session, int& nextLinearSegmentID);
+    void createUnbalancedPlacement(LayoutSession& session);
 
     // Phase 7: Edge routing
     void routeEdges(const std::vector<Layer>& layers, std::vector<LEdge*>& edges);
@@ -85,14 +109,19 @@ private:
     void calculateGraphSize(Node* graph, const std::vector<LNode*>& nodes);
 
     // Cleanup
-    void cleanup(std::vector<LNode*>& nodes, std::vector<LEdge*>& edges);
+    void cleanup(LayoutSession& session);
 
     // Configuration
     Direction direction_ = Direction::RIGHT;
     double nodeSpacing_ = 20.0;
     double layerSpacing_ = 50.0;
+    LayeringStrategy layeringStrategy_ = LayeringStrategy::LONGEST_PATH;
+    int layerBound_ = std::numeric_limits<int>::max();
+    NodePromotionStrategy nodePromotion_ = NodePromotionStrategy::NONE;
+    int promotionIterations_ = 30;
     CrossingMinimizationStrategy crossingStrategy_ = CrossingMinimizationStrategy::LAYER_SWEEP;
     NodePlacementStrategy nodeStrategy_ = NodePlacementStrategy::LINEAR_SEGMENTS;
+    bool mergeLongEdges_ = false;
 };
 
 // ============================================================================
@@ -0,0 +1,127 @@
+// Eclipse Layout Kernel - C++ Port
+// Reusable scratch state for layered layout runs
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "intermediate/node_promotion.h"
+#include "lgraph.h"
+#include "p2layers/coffman_graham_layerer.h"
+#include "p2layers/network_simplex_layerer.h"
+#include "p5edges/orthogonal_routing_generator.h"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace elk {
+namespace layered {
+
+class LayeredLayoutProvider;
+
+// ============================================================================
+// LayoutSession - Temporary containers shared by consecutive layout runs
+// ============================================================================
+
+// Holds every temporary container of a LayeredLayoutProvider run: the
+// layered graph, whose pools own its nodes, ports and edges, the layer
+// lists and adjacency rows, the lookup tables of import and cycle breaking,
+// the linear segment lists of node placement and the graph and hyperedge
+// segments of the edge router. Between runs the containers are cleared but
+// keep their capacity. Once a session has seen the largest of many similar
+// graphs, a run only allocates the bend point lists of the edge sections it
+// writes into the laid-out graph.
+//
+// A session is used by one layout at a time; give each thread its own.
+class LayoutSession {
+public:
+    LayoutSession() = default;
+
+    LayoutSession(const LayoutSession&) = delete;
+    LayoutSession& operator=(const LayoutSession&) = delete;
+
+    // Number of layouts run with this session
+    std::size_t layoutCount() const { return layoutCount_; }
+
+    // Release all retained capacity
+    void shrink();
+
+private:
+    friend class LayeredLayoutProvider;
+
+    // Start a run: clear everything, keeping capacity
+    void reset();
+
+    // Make layers hold count empty layers, reusing node vectors of
+    // earlier runs
+    void resizeLayers(std::size_t count);
+
+    // Empty linear segment with the given id, owned by the session
+    LinearSegment* newSegment(int id);
+
+    // Empty long-edge chain from the given port, owned by the session
+    LongEdgeChain* newChain(LPort* source, int firstLayer);
+
+    std::size_t layoutCount_ = 0;
+
+    // Layered graph of the current run; nodes and edges are its lists
+    LGraph graph;
+    std::vector<LNode*>& nodes = graph.lnodes;
+    std::vector<LEdge*>& edges = graph.ledges;
+    std::vector<Layer> layers;
+    std::vector<std::vector<LNode*>> spareLayerNodes;
+    LAdjacency adjacency;
+
+    // Import: the layered port of each original port, sorted by port
+    std::vector<std::pair<Port*, LPort*>> portMap;
+
+    // Cycle breaking (indexed by LNode::graphIndex)
+    std::vector<int> indegree;
+    std::vector<int> outdegree;
+    std::vector<int> mark;
+    std::vector<int> sources;
+    std::vector<int> sinks;
+    std::vector<int> bucketFirst;     // Per outflow: first and last node
+    std::vector<int> bucketLast;
+    std::vector<int> bucketNext;      // Per node: neighbours in its bucket
+    std::vector<int> bucketPrevious;
+    std::vector<LEdge*> reversedEdges;
+
+    // Layering (indexed by LNode::graphIndex)
+    std::vector<int> heights;
+    std::vector<int> unplacedSuccessors;
+    std::vector<int> layeringQueue;
+    p2layers::NetworkSimplexLayerer networkSimplex;
+    p2layers::CoffmanGrahamLayerer coffmanGraham;
+    NodePromotion nodePromotion;
+
+    // Long edges and crossing minimization
+    std::vector<LEdge*> longEdges;
+    std::vector<std::unique_ptr<LongEdgeChain>> chainPool;
+    std::size_t chainsInUse = 0;
+    std::vector<std::pair<double, int>> barycenters;  // With position in the layer
+    std::vector<LNode*> sortedLayer;
+    std::vector<int> order;  // orderInLayer by LNode::graphIndex
+
+    // Node placement
+    std::vector<std::unique_ptr<LinearSegment>> segmentPool;
+    std::size_t segmentsInUse = 0;
+    std::vector<LinearSegment*> segments;
+    std::vector<LinearSegment*> sortedSegments;
+    std::vector<std::vector<LinearSegment*>> segmentSuccessors;
+    std::vector<int> segmentPredecessorCounts;
+    std::vector<int> segmentRanks;
+    std::vector<LinearSegment*> segmentQueue;
+    std::vector<int> placedCounts;
+    std::vector<LNode*> recentNodes;
+    std::vector<double> layerExtents;
+    std::vector<double> layerWidths;
+
+    // Graph the orthogonal edge router works on, and its generator with
+    // the pooled hyperedge segments
+    LGraph routingGraph;
+    p5edges::OrthogonalRoutingGenerator routingGenerator{p5edges::RoutingDirection::WEST_TO_EAST, 0.0};
+};
+
+} // namespace layered
+} // namespace elk
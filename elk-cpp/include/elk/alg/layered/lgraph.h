@@ -12,6 +12,8 @@
 #include <string>
 #include <memory>
 #include <climits>
+#include <cstddef>
+#include <new>
 #include <random>
 
 namespace elk {
@@ -23,6 +25,7 @@ class LNode;
 class LPort;
 class LEdge;
 class LLabel;
+struct LongEdgeChain;
 class Layer;
 
 // ============================================================================
@@ -61,10 +64,10 @@ struct LPadding {
 
 class LGraphElement : public PropertyHolder {
 public:
-    std::string id;
+    ElementId id;  // Shares the interned symbol of the original element
 
     virtual ~LGraphElement() = default;
-    virtual std::string getDesignation() const { return id; }
+    virtual std::string getDesignation() const { return id.str(); }
 };
 
 // ============================================================================
@@ -139,7 +142,7 @@ public:
     LayerConstraint layerConstraint = LayerConstraint::NONE;  // Layer placement constraint
 
     // Node content
-    std::list<LPort*> ports;  // Use list for O(1) insert/remove
+    std::vector<LPort*> ports;
     std::vector<LLabel> labels;
 
     // Hierarchical support
@@ -156,6 +159,10 @@ public:
     // Segment assignment (for LinearSegmentsNodePlacer)
     int segmentId = -1;  // LinearSegment ID this node belongs to
 
+    // Free for use by the current phase, typically as an index into dense
+    // per-node arrays (the int id of LGraphElement in Java)
+    int scratchIndex = -1;
+
     // Edge priorities (for LinearSegmentsNodePlacer)
     int inputPriority = INT_MIN;   // Max priority of incoming edges
     int outputPriority = INT_MIN;  // Max priority of outgoing edges
@@ -163,6 +170,12 @@ public:
     // Original graph element
     Node* originalNode = nullptr;
 
+    // Index in the layered graph's node list, the node's row in LAdjacency
+    int graphIndex = -1;
+
+    // For LONG_EDGE dummies: the long edge this node is the order slot of
+    LongEdgeChain* longEdge = nullptr;
+
     // Cache for port side indices (optimization after PortListSorter)
     std::unordered_map<PortSide, std::pair<int, int>> portSideIndices;
     bool portSidesCached = false;
@@ -170,6 +183,9 @@ public:
     LNode() = default;
     explicit LNode(LGraph* g) : graph(g) {}
 
+    // Return to a default node, keeping the capacity of its containers
+    void reset();
+
     // Get layer assignment
     Layer* getLayer() const { return layer; }
     void setLayer(Layer* l);
@@ -184,8 +200,8 @@ public:
     void setType(NodeType t) { type = t; }
 
     // Port access
-    std::list<LPort*>& getPorts() { return ports; }
-    const std::list<LPort*>& getPorts() const { return ports; }
+    std::vector<LPort*>& getPorts() { return ports; }
+    const std::vector<LPort*>& getPorts() const { return ports; }
 
     // Get edges (through ports)
     std::vector<LEdge*> getIncomingEdges() const;
@@ -236,8 +252,8 @@ public:
     std::vector<LLabel> labels;
 
     // Connected edges (ports own edge connectivity in layered graph!)
-    std::list<LEdge*> incomingEdges;  // Use list for O(1) insert/remove
-    std::list<LEdge*> outgoingEdges;
+    std::vector<LEdge*> incomingEdges;
+    std::vector<LEdge*> outgoingEdges;
 
     // Hierarchical support
     bool connectedToExternalNodes = true;
@@ -245,8 +261,14 @@ public:
     // Original graph element
     Port* originalPort = nullptr;
 
+    // Index of the port's edge rows in LAdjacency
+    int graphIndex = -1;
+
     LPort() = default;
 
+    // Return to a default port, keeping the capacity of its containers
+    void reset();
+
     // Owner node
     LNode* getNode() const { return node; }
     void setNode(LNode* n);
@@ -270,10 +292,10 @@ public:
     const std::vector<LLabel>& getLabels() const { return labels; }
 
     // Edge access
-    std::list<LEdge*>& getIncomingEdges() { return incomingEdges; }
-    const std::list<LEdge*>& getIncomingEdges() const { return incomingEdges; }
-    std::list<LEdge*>& getOutgoingEdges() { return outgoingEdges; }
-    const std::list<LEdge*>& getOutgoingEdges() const { return outgoingEdges; }
+    std::vector<LEdge*>& getIncomingEdges() { return incomingEdges; }
+    const std::vector<LEdge*>& getIncomingEdges() const { return incomingEdges; }
+    std::vector<LEdge*>& getOutgoingEdges() { return outgoingEdges; }
+    const std::vector<LEdge*>& getOutgoingEdges() const { return outgoingEdges; }
 
     // Degree & net flow
     int getDegree() const { return incomingEdges.size() + outgoingEdges.size(); }
@@ -313,6 +335,9 @@ public:
 
     LEdge() = default;
 
+    // Return to a default edge, keeping the capacity of its containers
+    void reset();
+
     // Source/target
     LPort* getSource() const { return source; }
     void setSource(LPort* src);
@@ -367,6 +392,109 @@ public:
     int getIndex() const { return index; }
 };
 
+// ============================================================================
+// LongEdgeChain - A long edge stored once with its span
+// ============================================================================
+
+// An edge spanning several layers, or the edges of one net that leave the
+// same port, which share their path. Every layer the chain crosses holds a
+// LONG_EDGE node as the chain's order slot there. Slots only get ports and
+// edges where the layered graph must show them: the first slot's input
+// from the source, and an output on every slot that edges leave the chain
+// from, leading to their targets and to the next slot. The layers in
+// between cost one port-less node each; crossing minimization and node
+// placement reach their neighbours through the chain.
+struct LongEdgeChain {
+    LPort* source = nullptr;
+    int firstLayer = -1;        // Layer of slots[0]
+    std::vector<LNode*> slots;  // slots[i] lies in layer firstLayer + i
+
+    LNode* previous(const LNode* slot) const {
+        int index = slot->layerIndex - firstLayer;
+        return index == 0 ? source->getNode() : slots[index - 1];
+    }
+
+    LNode* next(const LNode* slot) const {
+        std::size_t index = static_cast<std::size_t>(slot->layerIndex - firstLayer) + 1;
+        return index < slots.size() ? slots[index] : nullptr;
+    }
+};
+
+// ============================================================================
+// LAdjacency - The layered graph compiled into compressed sparse rows
+// ============================================================================
+
+// Row i lists the graphIndex of the node at the other end of every edge
+// entering (incoming) or leaving (outgoing) nodes[i], in port order and then
+// edge order, self-loops included. A long-edge slot without a port on one
+// side lists its chain neighbour there instead. Besides these node rows,
+// every node has a row of its ports and every port (numbered by
+// LPort::graphIndex) rows of the edges entering and leaving it. The rows
+// are contiguous and reused between builds, so phases that only follow
+// edges iterate them without allocating or walking port and edge lists.
+// They are a snapshot: rebuild after adding, removing or reversing edges or
+// reordering ports.
+class LAdjacency {
+public:
+    template<typename T>
+    struct Span {
+        const T* first = nullptr;
+        const T* last = nullptr;
+
+        const T* begin() const { return first; }
+        const T* end() const { return last; }
+        std::size_t size() const { return static_cast<std::size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    using Row = Span<int>;
+    using PortRow = Span<LPort*>;
+    using EdgeRow = Span<LEdge*>;
+
+    // Number the nodes (LNode::graphIndex) and their ports
+    // (LPort::graphIndex) and compile their rows
+    void build(const std::vector<LNode*>& nodes);
+
+    void clear();
+    void shrink();
+
+    std::size_t nodeCount() const { return outStart.empty() ? 0 : outStart.size() - 1; }
+    std::size_t portCount() const { return portOutStart.empty() ? 0 : portOutStart.size() - 1; }
+
+    Row incoming(int node) const { return {inNodes.data() + inStart[node], inNodes.data() + inStart[node + 1]}; }
+    Row outgoing(int node) const { return {outNodes.data() + outStart[node], outNodes.data() + outStart[node + 1]}; }
+
+    // Edges of the outgoing row, in the same order; null for chain links
+    LEdge* const* outgoingEdges(int node) const { return outEdges.data() + outStart[node]; }
+
+    // Ports of a node in port order; ports(node)[k]->graphIndex is
+    // portStart[node] + k
+    PortRow ports(int node) const {
+        return {portList.data() + portStart[node], portList.data() + portStart[node + 1]};
+    }
+
+    // Edges entering and leaving a port, in edge order
+    EdgeRow portIncoming(int port) const {
+        return {portInEdges.data() + portInStart[port], portInEdges.data() + portInStart[port + 1]};
+    }
+    EdgeRow portOutgoing(int port) const {
+        return {portOutEdges.data() + portOutStart[port], portOutEdges.data() + portOutStart[port + 1]};
+    }
+
+private:
+    std::vector<int> inStart;   // nodeCount() + 1 offsets into inNodes
+    std::vector<int> inNodes;
+    std::vector<int> outStart;  // nodeCount() + 1 offsets into outNodes
+    std::vector<int> outNodes;
+    std::vector<LEdge*> outEdges;
+    std::vector<int> portStart;  // nodeCount() + 1 offsets into portList
+    std::vector<LPort*> portList;
+    std::vector<int> portInStart;  // portCount() + 1 offsets into portInEdges
+    std::vector<LEdge*> portInEdges;
+    std::vector<int> portOutStart;  // portCount() + 1 offsets into portOutEdges
+    std::vector<LEdge*> portOutEdges;
+};
+
 // ============================================================================
 // LinearSegment - Group of nodes for LinearSegmentsNodePlacer
 // Port from: org.eclipse.elk.alg.layered.p4nodes.LinearSegmentsNodePlacer.LinearSegment
@@ -392,17 +520,16 @@ public:
         return seg;
     }
 
-    // Split segment before given node, return new segment with remaining nodes
-    LinearSegment* split(LNode* node, int newId) {
+    // Split segment before given node, moving the remaining nodes into the
+    // empty newSegment (whose id must be set); returns newSegment, or null if
+    // node is not part of this segment
+    LinearSegment* split(LNode* node, LinearSegment* newSegment) {
         auto it = std::find(nodes.begin(), nodes.end(), node);
         if (it == nodes.end()) return nullptr;
 
-        LinearSegment* newSegment = new LinearSegment();
-        newSegment->id = newId;
-
         // Move nodes from 'node' onward to new segment
         for (auto moveIt = it; moveIt != nodes.end(); ++moveIt) {
-            (*moveIt)->segmentId = newId;
+            (*moveIt)->segmentId = newSegment->id;
             newSegment->nodes.push_back(*moveIt);
         }
         nodes.erase(it, nodes.end());
@@ -411,15 +538,82 @@ public:
     }
 };
 
+// ============================================================================
+// ElementPool - Slab storage for the elements of a layered graph
+// ============================================================================
+
+// Hands out elements from slabs of SLAB_SIZE, constructing each slot the
+// first time it is used. reset() frees every element at once by rewinding
+// to the first slot, without destructor calls or frees. A slot handed out
+// again is returned to a default element by T::reset(), which clears its
+// port, edge, label and property containers but keeps their capacity, so
+// elements of a graph no larger than earlier ones reuse that memory.
+// Slabs, and whatever the elements in them still hold, are released by
+// shrink() or the destructor.
+template<typename T>
+class ElementPool {
+public:
+    static constexpr std::size_t SLAB_SIZE = 256;
+
+    ElementPool() = default;
+    ~ElementPool() { shrink(); }
+
+    ElementPool(const ElementPool&) = delete;
+    ElementPool& operator=(const ElementPool&) = delete;
+
+    T* create() {
+        if (used_ < constructed_) {
+            T* element = slot(used_++);
+            element->reset();
+            return element;
+        }
+        if (constructed_ == slabs_.size() * SLAB_SIZE) {
+            slabs_.emplace_back(new Slot[SLAB_SIZE]);
+        }
+        T* element = new (&slabs_[used_ / SLAB_SIZE][used_ % SLAB_SIZE]) T();
+        constructed_ = ++used_;
+        return element;
+    }
+
+    // Elements handed out since the last reset
+    std::size_t size() const { return used_; }
+
+    void reset() { used_ = 0; }
+
+    void shrink() {
+        for (std::size_t i = 0; i < constructed_; ++i) {
+            slot(i)->~T();
+        }
+        used_ = 0;
+        constructed_ = 0;
+        slabs_.clear();
+        slabs_.shrink_to_fit();
+    }
+
+private:
+    struct Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    T* slot(std::size_t index) {
+        return std::launder(reinterpret_cast<T*>(&slabs_[index / SLAB_SIZE][index % SLAB_SIZE]));
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    std::size_t used_ = 0;
+    std::size_t constructed_ = 0;
+};
+
 // ============================================================================
 // LGraph - The complete layered graph
 // ============================================================================
 
 class LGraph : public LGraphElement {
 public:
-    // Node and edge lists (owned)
-    std::vector<std::unique_ptr<LNode>> lnodes;
-    std::vector<std::unique_ptr<LEdge>> ledges;
+    // Node and edge lists; the pools below own these elements and every
+    // port, including those of dummy nodes
+    std::vector<LNode*> lnodes;
+    std::vector<LEdge*> ledges;
 
     // Layers (owned)
     std::vector<std::unique_ptr<Layer>> layers;
@@ -443,14 +637,17 @@ public:
 
     LGraph() : random(42) {}  // Default seed
 
-    // Add elements
+    // Add elements, allocated from the graph's pools. addPort() sets the
+    // port's node but leaves placing it in the node's port list to the
+    // caller.
     LNode* addNode();
+    LPort* addPort(LNode* node);
     LEdge* addEdge();
     Layer* addLayer();
     Layer* addLayer(int index);
 
     // Access
-    std::vector<std::unique_ptr<LNode>>& getLayerlessNodes() { return lnodes; }
+    std::vector<LNode*>& getLayerlessNodes() { return lnodes; }
     std::vector<std::unique_ptr<Layer>>& getLayers() { return layers; }
 
     LPadding& getPadding() { return padding; }
@@ -458,6 +655,18 @@ public:
 
     Point& getOffset() { return offset; }
     const Point& getOffset() const { return offset; }
+
+    // Drop all nodes, ports, edges and layers at once, keeping the pools'
+    // slabs for the next graph
+    void clear();
+
+    // Drop all elements and release the pools' slabs
+    void shrink();
+
+private:
+    ElementPool<LNode> nodePool;
+    ElementPool<LPort> portPool;
+    ElementPool<LEdge> edgePool;
 };
 
 } // namespace layered
@@ -0,0 +1,91 @@
+// Eclipse Layout Kernel - C++ Port
+// Coffman-Graham layer assignment
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "../lgraph.h"
+#include <vector>
+
+namespace elk {
+namespace layered {
+namespace p2layers {
+
+/**
+ * Layer assignment that puts at most a given number of nodes into each
+ * layer, so that wide graphs become longer instead of taller.
+ *
+ * Port of ELK's CoffmanGrahamLayerer on the layered graph's adjacency rows.
+ * Edges that skip over a single intermediate node are dropped first; they
+ * add no ordering constraint, and finding longer transitive paths as ELK
+ * does costs a search per node. The nodes are then numbered in the
+ * Coffman-Graham topological order, where among the nodes whose
+ * predecessors are all numbered the one whose predecessors' numbers,
+ * sorted in decreasing order, are lexicographically smallest comes first.
+ * Finally layers are filled from the sinks with the nodes whose successors
+ * are all placed in earlier layers, and a new layer is started when the
+ * current one is full or no such node is left.
+ *
+ * ELK fills each layer by number alone. Here the nodes whose nearest
+ * successor is closest come first and the number only breaks ties, so a
+ * node follows its successors instead of waiting behind every other sink;
+ * otherwise bounding the width mostly turns short edges into long ones.
+ *
+ * Based on:
+ *   Coffman, Graham. Optimal scheduling for two-processor systems.
+ *   In Acta Informatica, 1972.
+ *
+ * Holds its working arrays between runs; one instance per thread.
+ */
+class CoffmanGrahamLayerer {
+public:
+    /**
+     * Sets the layerIndex of every node. The graph must be acyclic apart
+     * from self-loops, which are ignored.
+     *
+     * @param nodes nodes of the layered graph, numbered by graphIndex.
+     * @param adjacency adjacency rows of the nodes.
+     * @param layerBound maximum number of nodes per layer, at least 1.
+     */
+    void process(const std::vector<LNode*>& nodes, const LAdjacency& adjacency, int layerBound);
+
+    /** Releases all retained capacity. */
+    void shrink();
+
+private:
+    void reduceTransitiveEdges(const LAdjacency& adjacency);
+    void orderTopologically();
+    int assignLayers(int layerBound);
+
+    // Whether node a comes after node b in the topological order
+    bool numberedAfter(int a, int b) const;
+
+    int nodeCount_ = 0;
+
+    // Edges left after the reduction, as successor and predecessor rows
+    std::vector<int> successorStart_;
+    std::vector<int> successors_;
+    std::vector<int> predecessorStart_;
+    std::vector<int> predecessors_;
+
+    // Per node: topological number, the numbers of its numbered
+    // predecessors in increasing order (in its predecessor row's space),
+    // its unplaced neighbours and its layer counted from the sinks
+    std::vector<int> number_;
+    std::vector<int> byNumber_;
+    std::vector<int> predecessorNumbers_;
+    std::vector<int> numberedPredecessors_;
+    std::vector<int> remaining_;
+    std::vector<int> layerFromSinks_;
+    std::vector<int> nearestSuccessor_;
+
+    // Scratch
+    std::vector<int> seen_;
+    std::vector<int> skipped_;
+    std::vector<int> candidates_;
+    std::vector<int> ready_;
+};
+
+} // namespace p2layers
+} // namespace layered
+} // namespace elk
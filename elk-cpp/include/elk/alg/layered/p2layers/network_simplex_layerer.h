@@ -0,0 +1,132 @@
+// Eclipse Layout Kernel - C++ Port
+// Network simplex layer assignment
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "../lgraph.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace elk {
+namespace layered {
+namespace p2layers {
+
+/**
+ * Layer assignment that minimizes the total span of all edges, so that long
+ * edges need as few dummy nodes as possible.
+ *
+ * Each connected component is laid out by the network simplex algorithm on
+ * the layered graph's adjacency rows: a feasible spanning tree of tight
+ * edges is built by merging tight subtrees, smallest first, and tree edges
+ * with negative cut value are then exchanged for the non-tree edge of least
+ * slack that crosses the same cut. An exchange only changes the cut values
+ * on the tree path between the ends of the entering edge, and only the
+ * postorder numbering below their lowest common ancestor, so both are
+ * updated in place instead of being recomputed for the whole tree. All
+ * traversals are iterative. Afterwards each component is normalized to
+ * start in layer 0, and nodes with as many incoming as outgoing edges move
+ * to the emptiest layer their edges allow.
+ *
+ * Like ELK's NetworkSimplexLayerer, the number of exchanges per component
+ * is limited to a multiple of the square root of its size.
+ *
+ * Based on:
+ *   Gansner, Koutsofios, North, Vo. A technique for drawing directed graphs.
+ *   In IEEE Transactions on Software Engineering, 1993.
+ *
+ * Holds its working arrays between runs; one instance per thread.
+ */
+class NetworkSimplexLayerer {
+public:
+    /**
+     * Sets the layerIndex of every node. The graph must be acyclic apart
+     * from self-loops, which are ignored.
+     *
+     * @param nodes nodes of the layered graph, numbered by graphIndex.
+     * @param adjacency adjacency rows of the nodes.
+     */
+    void process(const std::vector<LNode*>& nodes, const LAdjacency& adjacency);
+
+    /** Number of tree edge exchanges made by the last run. */
+    std::int64_t exchangeCount() const { return exchanges_; }
+
+    /** Releases all retained capacity. */
+    void shrink();
+
+private:
+    // Edges and their incidence
+    void initialize(const std::vector<LNode*>& nodes, const LAdjacency& adjacency);
+    int slack(int edge) const { return rank_[head_[edge]] - rank_[tail_[edge]] - 1; }
+    int other(int edge, int node) const { return tail_[edge] == node ? head_[edge] : tail_[edge]; }
+    int treeStart(int node) const { return outStart_[node] + inStart_[node]; }
+
+    // Feasible tree
+    void initialRanking();
+    void feasibleTree();
+    int findTree(int node);
+    void addTreeEdge(int edge);
+    void removeTreeEdge(int edge);
+
+    // Postorder ranges and cut values
+    int numberSubtree(int root, int parentEdge, int low);
+    void initCutValues();
+    int cutValueOf(int node) const;
+
+    // Pivoting
+    int leaveEdge(int first, int last);
+    int enterEdge(int leaving);
+    void exchange(int leaving, int entering);
+    int updateCutValues(int from, int to, int cutValue, bool direction);
+    void shiftSubtree(int root, int delta);
+
+    // Layers
+    void normalize();
+    void balance();
+
+    int nodeCount_ = 0;
+    int edgeCount_ = 0;
+    int searchStart_ = 0;  // Where leaveEdge resumes its search
+    std::int64_t exchanges_ = 0;
+
+    // Per edge: endpoints, cut value (only for tree edges), position in
+    // treeEdges_ or -1 for non-tree edges. Out-edges of a node are numbered
+    // consecutively, from outStart_[node] to outStart_[node + 1].
+    std::vector<int> tail_;
+    std::vector<int> head_;
+    std::vector<int> cutValue_;
+    std::vector<int> treeSlot_;
+    std::vector<int> outStart_;
+    std::vector<int> inStart_;
+    std::vector<int> inEdges_;
+
+    // Per node: layer, tree edges (at most degree many, from treeStart),
+    // postorder range [low, lim] of the subtree below it, edge to its tree
+    // parent (-1 at the root) and the root of its component
+    std::vector<int> rank_;
+    std::vector<int> treeAdjacency_;
+    std::vector<int> treeCount_;
+    std::vector<int> low_;
+    std::vector<int> lim_;
+    std::vector<int> parentEdge_;
+    std::vector<int> component_;
+
+    // Tree edges, grouped by component
+    std::vector<int> treeEdges_;
+    std::vector<int> componentRoots_;
+    std::vector<int> componentEnds_;
+
+    // Scratch
+    std::vector<int> unionFind_;
+    std::vector<int> treeSize_;
+    std::vector<std::pair<int, int>> treeHeap_;
+    std::vector<int> stack_;
+    std::vector<int> stackSlot_;
+    std::vector<int> nodeList_;
+    std::vector<int> filling_;
+};
+
+} // namespace p2layers
+} // namespace layered
+} // namespace elk
@@ -7,7 +7,7 @@
 #include "../lgraph.h"
 #include "routing_direction.h"
 #include "hyper_edge_segment.h"
-#include <set>
+#include <vector>
 #include <memory>
 
 namespace elk {
@@ -47,16 +47,21 @@ public:
     // Accessors
 
     /**
-     * Returns the set of junction points created so far.
+     * Returns the junction points created so far, sorted and without duplicates.
      */
-    std::set<Point>& getCreatedJunctionPoints() { return createdJunctionPoints; }
-    const std::set<Point>& getCreatedJunctionPoints() const { return createdJunctionPoints; }
+    std::vector<Point>& getCreatedJunctionPoints() { return createdJunctionPoints; }
+    const std::vector<Point>& getCreatedJunctionPoints() const { return createdJunctionPoints; }
 
     /**
-     * Removes all junction points created so far.
+     * Removes all junction points created so far, keeping the capacity of their list.
      */
     void clearCreatedJunctionPoints() { createdJunctionPoints.clear(); }
 
+    /**
+     * Removes all junction points created so far and releases their list.
+     */
+    void shrinkCreatedJunctionPoints() { createdJunctionPoints = {}; }
+
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // To be implemented by subclasses
 
@@ -113,8 +118,11 @@ private:
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Properties
 
-    /** Set of already created junction points, to avoid multiple points at the same position. */
-    std::set<Point> createdJunctionPoints;
+    /**
+     * Sorted list of already created junction points, to avoid multiple points at the same
+     * position. A sorted vector instead of a set keeps its memory between routing calls.
+     */
+    std::vector<Point> createdJunctionPoints;
 };
 
 } // namespace p5edges
@@ -6,8 +6,8 @@
 
 #include "hyper_edge_segment.h"
 #include "hyper_edge_segment_dependency.h"
+#include <cstddef>
 #include <vector>
-#include <list>
 #include <random>
 
 namespace elk {
@@ -32,59 +32,73 @@ public:
      * dependencies. The latter assumes that there are no cycles among critical dependencies
      * left and will never return a critical dependency in the result.
      *
+     * The detector keeps its working lists between calls, so reusing one instance does not
+     * allocate once it has seen the largest segment graph.
+     *
      * @param segments list of hyper edge segments.
      * @param criticalOnly true if we should only detect cycles among critical dependencies.
      * @param random random number generator.
-     * @return list of dependencies whose removal or reversal will make the graph acyclic.
+     * @return list of dependencies whose removal or reversal will make the graph acyclic;
+     *         valid until the next call.
      */
-    static std::vector<HyperEdgeSegmentDependency*> detectCycles(
+    const std::vector<HyperEdgeSegmentDependency*>& detectCycles(
         const std::vector<HyperEdgeSegment*>& segments,
         bool criticalOnly,
         std::mt19937& random);
 
 private:
-    /**
-     * No instances allowed - static utility class.
-     */
-    HyperEdgeCycleDetector() = delete;
-
     /**
      * Initializes the mark, in weight and out weight of each hyper edge segment. Also adds
      * all sources (segments without incoming weight 0) and sinks (segments with outgoing
      * weight 0) to their respective lists. Once this is complete, all segments are marked
      * from -1 to -segments.size().
      */
-    static void initialize(
-        const std::vector<HyperEdgeSegment*>& segments,
-        std::list<HyperEdgeSegment*>& sources,
-        std::list<HyperEdgeSegment*>& sinks,
-        bool criticalOnly);
+    void initialize(const std::vector<HyperEdgeSegment*>& segments, bool criticalOnly);
 
     /**
      * Computes marks for all segments based on a linear ordering of the segments. Marks
      * will be mutually different, and sinks will have higher marks than sources.
      */
-    static void computeLinearOrderingMarks(
+    void computeLinearOrderingMarks(
         const std::vector<HyperEdgeSegment*>& segments,
-        std::list<HyperEdgeSegment*>& sources,
-        std::list<HyperEdgeSegment*>& sinks,
         bool criticalOnly,
         std::mt19937& random);
 
+    /**
+     * Removes the segment with the given mark from the unprocessed ones, if its initial
+     * mark is still unprocessed.
+     */
+    void markProcessed(int mark);
+
     /**
      * Updates in-weight and out-weight values of the neighbors of the given node, simulating
      * its removal from the graph. The sources and sinks lists are also updated.
      *
      * @param node node for which neighbors are updated
-     * @param sources list of sources
-     * @param sinks list of sinks
      * @param criticalOnly true if only critical dependencies should be taken into account.
      */
-    static void updateNeighbors(
-        HyperEdgeSegment* node,
-        std::list<HyperEdgeSegment*>& sources,
-        std::list<HyperEdgeSegment*>& sinks,
-        bool criticalOnly);
+    void updateNeighbors(HyperEdgeSegment* node, bool criticalOnly);
+
+    /** Sources and sinks still to be processed, in queue order from the head index on. */
+    std::vector<HyperEdgeSegment*> sources_;
+    std::size_t sourcesHead_ = 0;
+    std::vector<HyperEdgeSegment*> sinks_;
+    std::size_t sinksHead_ = 0;
+
+    /**
+     * Indices of the segments not processed yet, ordered by ascending initial mark, that is,
+     * from the last segment to the first. Indices whose flag in unprocessedFlags_ was cleared
+     * are dropped lazily.
+     */
+    std::vector<int> unprocessed_;
+    std::vector<char> unprocessedFlags_;
+    std::size_t unprocessedCount_ = 0;
+
+    /** Segments with maximal outflow. */
+    std::vector<HyperEdgeSegment*> maxSegments_;
+
+    /** Result of the last call. */
+    std::vector<HyperEdgeSegmentDependency*> result_;
 };
 
 } // namespace p5edges
@@ -6,9 +6,7 @@
 
 #include "../lgraph.h"
 #include "hyper_edge_segment_dependency.h"
-#include <list>
 #include <vector>
-#include <map>
 #include <string>
 #include <utility>
 #include <cmath>
@@ -45,15 +43,37 @@ public:
      *
      * @param routingStrategy the routing strategy. Only required if addPortPositions() will be called.
      */
-    explicit HyperEdgeSegment(BaseRoutingDirectionStrategy* routingStrategy);
+    explicit HyperEdgeSegment(BaseRoutingDirectionStrategy* routingStrategy = nullptr);
+
+    /**
+     * Returns this segment to a new one without routing strategy, keeping the capacity of its
+     * coordinate, port and dependency lists, so that an ElementPool can hand it out again.
+     */
+    void reset();
+
+    /**
+     * Sets the routing strategy used by addPortPositions().
+     */
+    void setRoutingStrategy(BaseRoutingDirectionStrategy* routingStrategy) { routingStrategy_ = routingStrategy; }
 
     /**
      * Adds the positions of the given port and all connected ports.
      *
      * @param port a port.
-     * @param hyperEdgeSegmentMap map of ports to existing hyperedge segments.
+     * @param segmentsByPort existing hyperedge segments by LPort::graphIndex; grown as needed.
      */
-    void addPortPositions(LPort* port, std::map<LPort*, HyperEdgeSegment*>& hyperEdgeSegmentMap);
+    void addPortPositions(LPort* port, std::vector<HyperEdgeSegment*>& segmentsByPort);
+
+    /**
+     * Returns the segment the given port was added to, or nullptr.
+     *
+     * @param port a port, numbered by LPort::graphIndex.
+     * @param segmentsByPort hyperedge segments by LPort::graphIndex.
+     */
+    static HyperEdgeSegment* segmentOf(const LPort* port, const std::vector<HyperEdgeSegment*>& segmentsByPort) {
+        std::size_t index = static_cast<std::size_t>(port->graphIndex);
+        return index < segmentsByPort.size() ? segmentsByPort[index] : nullptr;
+    }
 
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Getters and Setters
@@ -87,14 +107,14 @@ public:
     /**
      * Returns the (sorted) list of coordinates where incoming connections enter this segment.
      */
-    std::list<double>& getIncomingConnectionCoordinates() { return incomingConnectionCoordinates_; }
-    const std::list<double>& getIncomingConnectionCoordinates() const { return incomingConnectionCoordinates_; }
+    std::vector<double>& getIncomingConnectionCoordinates() { return incomingConnectionCoordinates_; }
+    const std::vector<double>& getIncomingConnectionCoordinates() const { return incomingConnectionCoordinates_; }
 
     /**
      * Returns the (sorted) list of coordinates where outgoing connections leave this segment.
      */
-    std::list<double>& getOutgoingConnectionCoordinates() { return outgoingConnectionCoordinates_; }
-    const std::list<double>& getOutgoingConnectionCoordinates() const { return outgoingConnectionCoordinates_; }
+    std::vector<double>& getOutgoingConnectionCoordinates() { return outgoingConnectionCoordinates_; }
+    const std::vector<double>& getOutgoingConnectionCoordinates() const { return outgoingConnectionCoordinates_; }
 
     /**
      * Return the outgoing dependencies to other hyper edge segments.
@@ -208,21 +228,23 @@ public:
     // Splitting
 
     /**
-     * Simulates what would happen during a split. The returned pair contains two new HyperEdgeSegments:
-     * the first simulates what would happen to this instance, and the second simulates the split partner.
+     * Simulates what would happen during a split. The returned pair contains two new HyperEdgeSegments
+     * taken from the given pool: the first simulates what would happen to this instance, and the second
+     * simulates the split partner.
      */
-    std::pair<HyperEdgeSegment*, HyperEdgeSegment*> simulateSplit();
+    std::pair<HyperEdgeSegment*, HyperEdgeSegment*> simulateSplit(ElementPool<HyperEdgeSegment>& segmentPool);
 
     /**
-     * Splits this segment into two and returns the new segment. The segments will be linked at the
-     * given position. This segment will retain all incoming connection coordinates, but all of its
-     * outgoing connection coordinates will move over to the new segment. This will completely clear
-     * all dependencies since they may have become obsolete.
+     * Splits this segment into two and returns the new segment, which is taken from the given pool. The
+     * segments will be linked at the given position. This segment will retain all incoming connection
+     * coordinates, but all of its outgoing connection coordinates will move over to the new segment. This
+     * will completely clear all dependencies since they may have become obsolete.
      *
      * @param splitPosition position to split the two segments.
+     * @param segmentPool pool the new segment is taken from.
      * @return the new segment for convenience.
      */
-    HyperEdgeSegment* splitAt(double splitPosition);
+    HyperEdgeSegment* splitAt(double splitPosition, ElementPool<HyperEdgeSegment>& segmentPool);
 
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Comparable and Object Methods
@@ -253,12 +275,12 @@ private:
     /**
      * Inserts a value into a sorted list, maintaining sorted order.
      */
-    static void insertSorted(std::list<double>& list, double value);
+    static void insertSorted(std::vector<double>& list, double value);
 
     /**
      * Recomputes extent based on a list of positions.
      */
-    void recomputeExtent(const std::list<double>& positions);
+    void recomputeExtent(const std::vector<double>& positions);
 
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Properties
@@ -278,9 +300,9 @@ private:
     double endPosition_ = NAN;
 
     /** Sorted list of coordinates where incoming connections enter this segment. */
-    std::list<double> incomingConnectionCoordinates_;
+    std::vector<double> incomingConnectionCoordinates_;
     /** Sorted list of coordinates where outgoing connections leave this segment. */
-    std::list<double> outgoingConnectionCoordinates_;
+    std::vector<double> outgoingConnectionCoordinates_;
 
     /** List of outgoing dependencies to other edge segments. */
     std::vector<HyperEdgeSegmentDependency*> outgoingSegmentDependencies_;
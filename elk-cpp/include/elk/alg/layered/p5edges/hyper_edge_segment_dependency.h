@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../lgraph.h"
 #include <memory>
 #include <string>
 
@@ -45,19 +46,29 @@ public:
 
     /**
      * Creates a regular dependency between the given segments with the given weight,
-     * and adds it to the segments' list of incident dependencies.
+     * and adds it to the segments' list of incident dependencies. The dependency is
+     * taken from the given pool, which owns it.
      */
-    static HyperEdgeSegmentDependency* createAndAddRegular(HyperEdgeSegment* source,
+    static HyperEdgeSegmentDependency* createAndAddRegular(ElementPool<HyperEdgeSegmentDependency>& pool,
+                                                           HyperEdgeSegment* source,
                                                            HyperEdgeSegment* target,
                                                            int weight);
 
     /**
      * Creates a critical dependency between the given segments with a weight of
      * CRITICAL_DEPENDENCY_WEIGHT, and adds it to the segments' list of incident dependencies.
+     * The dependency is taken from the given pool, which owns it.
      */
-    static HyperEdgeSegmentDependency* createAndAddCritical(HyperEdgeSegment* source,
+    static HyperEdgeSegmentDependency* createAndAddCritical(ElementPool<HyperEdgeSegmentDependency>& pool,
+                                                             HyperEdgeSegment* source,
                                                              HyperEdgeSegment* target);
 
+    /**
+     * Returns this dependency to an unconnected one, so that an ElementPool can hand it
+     * out again. Its former segments are not updated.
+     */
+    void reset() { *this = HyperEdgeSegmentDependency(); }
+
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Manipulation
 
@@ -110,23 +121,29 @@ public:
     std::string toString() const;
 
 private:
+    friend class ElementPool<HyperEdgeSegmentDependency>;
+
     /**
      * Private constructor - use static factory methods instead.
      */
-    HyperEdgeSegmentDependency(DependencyType type, HyperEdgeSegment* source,
-                               HyperEdgeSegment* target, int weight);
+    HyperEdgeSegmentDependency() = default;
+
+    /**
+     * Initializes a dependency taken from a pool and adds it to the given segments.
+     */
+    void init(DependencyType type, HyperEdgeSegment* source, HyperEdgeSegment* target, int weight);
 
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Properties
 
     /** The dependency's type. */
-    DependencyType type_;
+    DependencyType type_ = DependencyType::REGULAR;
     /** The source hypernode of this dependency. */
-    HyperEdgeSegment* source_;
+    HyperEdgeSegment* source_ = nullptr;
     /** The target hypernode of this dependency. */
-    HyperEdgeSegment* target_;
+    HyperEdgeSegment* target_ = nullptr;
     /** The weight of this dependency. */
-    int weight_;
+    int weight_ = 0;
 };
 
 } // namespace p5edges
@@ -7,7 +7,6 @@
 #include "hyper_edge_segment.h"
 #include "hyper_edge_segment_dependency.h"
 #include <vector>
-#include <set>
 
 namespace elk {
 namespace layered {
@@ -27,9 +26,12 @@ class OrthogonalRoutingGenerator;
 class HyperEdgeSegmentSplitter {
 public:
     /**
-     * Creates a new instance to be used by the given routing generator.
+     * Creates a new instance to be used by the given routing generator, taking new segments
+     * and dependencies from the generator's pools.
      */
-    explicit HyperEdgeSegmentSplitter(OrthogonalRoutingGenerator* routingGenerator);
+    HyperEdgeSegmentSplitter(OrthogonalRoutingGenerator* routingGenerator,
+                             ElementPool<HyperEdgeSegment>& segmentPool,
+                             ElementPool<HyperEdgeSegmentDependency>& dependencyPool);
 
     /**
      * Breaks critical dependency cycles by resolving the given dependencies. For each dependency,
@@ -78,20 +80,19 @@ private:
 
     /**
      * Assembles the areas between horizontal segments that are large enough to allow another
-     * horizontal segment to slip in.
+     * horizontal segment to slip in into freeAreas_.
      */
-    std::vector<FreeArea> findFreeAreas(const std::vector<HyperEdgeSegment*>& segments,
-                                        double criticalConflictThreshold);
+    void findFreeAreas(const std::vector<HyperEdgeSegment*>& segments, double criticalConflictThreshold);
 
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Split Segment Decisions
 
     /**
      * Given a list of hyperedge dependencies, this method assembles a list of HyperEdgeSegments
-     * which, if split, will cause the critical cycles caused by the dependencies to be broken.
+     * in segmentsToSplit_ which, if split, will cause the critical cycles caused by the
+     * dependencies to be broken.
      */
-    std::vector<HyperEdgeSegment*> decideWhichSegmentsToSplit(
-        const std::vector<HyperEdgeSegmentDependency*>& dependencies);
+    void decideWhichSegmentsToSplit(const std::vector<HyperEdgeSegmentDependency*>& dependencies);
 
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Actual Splitting
@@ -177,6 +178,15 @@ private:
 
     /** The routing generator that created us. */
     OrthogonalRoutingGenerator* routingGenerator_;
+
+    /** Pools of the routing generator that new segments and dependencies are taken from. */
+    ElementPool<HyperEdgeSegment>& segmentPool_;
+    ElementPool<HyperEdgeSegmentDependency>& dependencyPool_;
+
+    /** Working lists, kept between calls. */
+    std::vector<FreeArea> freeAreas_;
+    std::vector<double> allCoordinates_;
+    std::vector<HyperEdgeSegment*> segmentsToSplit_;
 };
 
 } // namespace p5edges
@@ -10,6 +10,8 @@ namespace elk {
 namespace layered {
 namespace p5edges {
 
+class OrthogonalRoutingGenerator;
+
 /**
  * Edge routing implementation that creates orthogonal bend points. Inspired by:
  * - Georg Sander, Layout of directed hypergraphs with orthogonal hyperedges
@@ -18,13 +20,17 @@ namespace p5edges {
  * This is Phase 5 of the ELK Layered algorithm.
  *
  * Precondition: the graph has a proper layering with assigned node and port positions;
- *               the size of each layer is correctly set
+ *               the size of each layer is correctly set; the ports are numbered by
+ *               LPort::graphIndex, as LAdjacency::build() leaves them
  *
  * Postcondition: each node is assigned a horizontal coordinate; the bend points of each
  *                edge are set; the width of the whole graph is set
  */
 class OrthogonalEdgeRouter {
 public:
+    /** Seed of the random generator each call to process() starts from. */
+    static constexpr unsigned RANDOM_SEED = 42;
+
     /**
      * Main entry point: routes all edges in the layered graph using orthogonal routing.
      * This also computes and sets horizontal node positions, taking into account the
@@ -40,6 +46,19 @@ public:
                           double nodeNodeSpacing,
                           double edgeEdgeSpacing,
                           double edgeNodeSpacing);
+
+    /**
+     * Same as above, but works on the given routing graph and west-to-east routing
+     * generator instead of temporary ones, so that callers running many layouts can
+     * keep reusing them and the segments the generator pools. The graph's spacings
+     * and random generator and the generator's edge spacing are reset on each call.
+     */
+    static double process(std::vector<Layer>& layers,
+                          LGraph& routingGraph,
+                          OrthogonalRoutingGenerator& routingGenerator,
+                          double nodeNodeSpacing,
+                          double edgeEdgeSpacing,
+                          double edgeNodeSpacing);
 };
 
 } // namespace p5edges
@@ -5,11 +5,11 @@
 #pragma once
 
 #include "../lgraph.h"
+#include "hyper_edge_cycle_detector.h"
 #include "hyper_edge_segment.h"
 #include "hyper_edge_segment_dependency.h"
 #include "routing_direction.h"
 #include <vector>
-#include <map>
 #include <random>
 #include <string>
 
@@ -38,6 +38,10 @@ class HyperEdgeSegmentSplitter;
  * When instantiating a new routing generator, the concrete directional strategy must be
  * specified. Once that is done, routeEdges() is called repeatedly to route edges between
  * given lists of nodes.
+ *
+ * The hyperedge segments and dependencies of a call are taken from pools that the next call
+ * reuses, along with the generator's working lists, so a generator kept across layouts stops
+ * allocating for them once it has routed the largest pair of layers.
  */
 class OrthogonalRoutingGenerator {
 public:
@@ -64,11 +68,26 @@ public:
      */
     ~OrthogonalRoutingGenerator();
 
+    OrthogonalRoutingGenerator(const OrthogonalRoutingGenerator&) = delete;
+    OrthogonalRoutingGenerator& operator=(const OrthogonalRoutingGenerator&) = delete;
+
+    /**
+     * Prepares a generator used before for routing another graph, with the given space
+     * between edges. Keeps the pools and the capacity of the working lists.
+     */
+    void reset(double edgeSpacing);
+
+    /**
+     * Releases the pooled segments and dependencies and all retained capacity.
+     */
+    void shrink();
+
     ///////////////////////////////////////////////////////////////////////////////
     // Edge Routing
 
     /**
-     * Route edges between the given layers.
+     * Route edges between the given layers. Their ports must be numbered by LPort::graphIndex,
+     * as LAdjacency::build() leaves them; the segments of the previous call are released.
      *
      * @param layeredGraph the layered graph.
      * @param sourceLayerNodes the left layer. May be nullptr.
@@ -94,13 +113,13 @@ public:
      * @param end end of the critical area
      * @return number of positions in the critical area
      */
-    static int countCrossings(const std::list<double>& posis, double start, double end);
+    static int countCrossings(const std::vector<double>& posis, double start, double end);
 
     /**
      * Finds and breaks non-critical cycles by removing and reversing non-critical dependencies.
      * This method is used by the self loop routing code as well.
      */
-    static void breakNonCriticalCycles(std::vector<HyperEdgeSegment*>& edgeSegments, std::mt19937& random);
+    void breakNonCriticalCycles(std::vector<HyperEdgeSegment*>& edgeSegments, std::mt19937& random);
 
     ///////////////////////////////////////////////////////////////////////////////
     // Package-visible Methods (used by HyperEdgeSegmentSplitter)
@@ -153,12 +172,12 @@ private:
      * @param nodes the layer. May be nullptr, in which case nothing happens.
      * @param portSide side of the output ports for whose outgoing edges hyperedge segments should be created.
      * @param hyperEdges list the created hyperedge segments should be added to.
-     * @param portToHyperEdgeSegmentMap map from ports to hyperedge segments that should be filled.
+     * @param segmentsByPort hyperedge segments by LPort::graphIndex that should be filled.
      */
     void createHyperEdgeSegments(const std::vector<LNode*>* nodes,
                                  PortSide portSide,
                                  std::vector<HyperEdgeSegment*>& hyperEdges,
-                                 std::map<LPort*, HyperEdgeSegment*>& portToHyperEdgeSegmentMap);
+                                 std::vector<HyperEdgeSegment*>& segmentsByPort);
 
     /**
      * Counts the number of conflicts for the given lists of positions.
@@ -167,7 +186,7 @@ private:
      * @param posis2 sorted list of positions
      * @return number of positions that overlap, or CRITICAL_CONFLICTS_DETECTED if a critical conflict was detected.
      */
-    int countConflicts(const std::list<double>& posis1, const std::list<double>& posis2);
+    int countConflicts(const std::vector<double>& posis1, const std::vector<double>& posis2);
 
     /**
      * Finds and breaks critical cycles to avoid edge overlaps. The critical cycles we find will
@@ -180,7 +199,7 @@ private:
      *
      * @param segments list of hyperedge segments
      */
-    static void topologicalNumbering(std::vector<HyperEdgeSegment*>& segments);
+    void topologicalNumbering(std::vector<HyperEdgeSegment*>& segments);
 
     ///////////////////////////////////////////////////////////////////////////////
     // Member Variables
@@ -219,6 +238,21 @@ private:
 
     /** Prefix of debug output files. */
     std::string debugPrefix_;
+
+    /** Hyperedge segments and dependencies of the current call to routeEdges(). */
+    ElementPool<HyperEdgeSegment> segmentPool_;
+    ElementPool<HyperEdgeSegmentDependency> dependencyPool_;
+
+    /** Finds the dependencies to break cycles in. */
+    HyperEdgeCycleDetector cycleDetector_;
+
+    /** Working lists, kept between calls. */
+    std::vector<HyperEdgeSegment*> edgeSegments_;
+    std::vector<HyperEdgeSegment*> segmentsByPort_;
+    std::vector<double> incomingCoordinates_;
+    std::vector<double> outgoingCoordinates_;
+    std::vector<HyperEdgeSegment*> sources_;
+    std::vector<HyperEdgeSegment*> rightwardTargets_;
 };
 
 } // namespace p5edges
@@ -127,7 +127,7 @@ private:
 // ============================================================================
 
 // Check if node is a potential tree root (no incoming edges or specified as root)
-inline bool isPotentialRoot(Node* node, const std::vector<std::unique_ptr<Edge>>& edges) {
+inline bool isPotentialRoot(Node* node, const std::vector<ElementPtr<Edge>>& edges) {
     for (const auto& edge : edges) {
         for (Node* target : edge->targetNodes) {
             if (target == node) {
@@ -139,7 +139,7 @@ inline bool isPotentialRoot(Node* node, const std::vector<std::unique_ptr<Edge>>
 }
 
 // Get children of a node
-inline std::vector<Node*> getChildren(Node* node, const std::vector<std::unique_ptr<Edge>>& edges) {
+inline std::vector<Node*> getChildren(Node* node, const std::vector<ElementPtr<Edge>>& edges) {
     std::vector<Node*> children;
     for (const auto& edge : edges) {
         for (Node* source : edge->sourceNodes) {
@@ -65,22 +65,17 @@ private:
 };
 
 // ============================================================================
-// Global Configuration
+// Common option keys
 // ============================================================================
 
-class GlobalConfig {
-public:
-    static ConfigurationStore& instance();
-
-    // Common options
+// There is deliberately no process-wide store: every layout owns its
+// ConfigurationStore, so concurrent layouts cannot see each other's values.
+struct CoreOptions {
     static const std::string ALGORITHM;
     static const std::string DIRECTION;
     static const std::string NODE_SPACING;
     static const std::string LAYER_SPACING;
     static const std::string EDGE_ROUTING;
-
-private:
-    static ConfigurationStore store_;
 };
 
 } // namespace elk
@@ -0,0 +1,88 @@
+// Eclipse Layout Kernel - C++ Port
+// Memoization of layout results by structural graph fingerprint
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "layout_provider.h"
+#include "../graph/fingerprint.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace elk {
+
+struct LayoutSnapshot;
+
+struct LayoutCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t entries = 0;
+    std::size_t bytes = 0;  // Estimated memory held by cached results
+};
+
+// ============================================================================
+// LayoutCache - Replays earlier results of a provider for identical input
+// ============================================================================
+
+// Wraps a provider and is itself a provider. The key of a layout is the
+// structural fingerprint of the graph (see fingerprint()) combined with the
+// provider's algorithm ID and configuration (hashConfiguration()). On a hit
+// the stored result is copied onto the graph without running any phase:
+// node, port and label positions, node sizes, port sides and order, edge
+// sections and junction points. Internal properties a provider may leave on
+// elements are not replayed.
+//
+// Results are kept in least-recently-used order and evicted once their
+// estimated size exceeds maxBytes. All methods are thread-safe; a miss runs
+// the wrapped provider outside the lock, so the wrapped provider must itself
+// be safe to call concurrently if the cache is shared between threads.
+class LayoutCache : public ILayoutProvider {
+public:
+    static constexpr std::size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+    explicit LayoutCache(ILayoutProvider& provider, std::size_t maxBytes = DEFAULT_MAX_BYTES);
+    ~LayoutCache() override;
+
+    LayoutCache(const LayoutCache&) = delete;
+    LayoutCache& operator=(const LayoutCache&) = delete;
+
+    void layout(Node* graph, ProgressCallback progress = nullptr) override;
+    std::string getAlgorithmId() const override { return provider_.getAlgorithmId(); }
+    void hashConfiguration(FingerprintHasher& hasher) const override {
+        provider_.hashConfiguration(hasher);
+    }
+
+    // Cache key the graph would be stored under
+    Fingerprint key(const Node& graph) const;
+
+    LayoutCacheStats stats() const;
+    std::size_t maxBytes() const { return maxBytes_; }
+
+    // Drop all entries (counters are kept)
+    void clear();
+
+private:
+    struct Entry {
+        Fingerprint key;
+        std::shared_ptr<const LayoutSnapshot> snapshot;
+    };
+
+    std::shared_ptr<const LayoutSnapshot> lookup(const Fingerprint& key);
+    void count(bool hit);
+    void insert(const Fingerprint& key, std::shared_ptr<const LayoutSnapshot> snapshot);
+
+    ILayoutProvider& provider_;
+    std::size_t maxBytes_;
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  // Most recently used first
+    std::unordered_map<Fingerprint, std::list<Entry>::iterator> lookup_;
+    LayoutCacheStats stats_;
+};
+
+} // namespace elk
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../graph/graph.h"
+#include "../graph/fingerprint.h"
 #include <functional>
 
 namespace elk {
@@ -20,11 +21,19 @@ class ILayoutProvider {
 public:
     virtual ~ILayoutProvider() = default;
 
-    // Main layout function
+    // Main layout function. Must be reentrant: state of a run (including
+    // random generators) lives in that run, and configuration members are
+    // only read, so one provider can lay out different graphs concurrently.
     virtual void layout(Node* graph, ProgressCallback progress = nullptr) = 0;
 
     // Get algorithm name/identifier
     virtual std::string getAlgorithmId() const = 0;
+
+    // Mix every provider setting that influences the result into hasher.
+    // LayoutCache uses this to keep results of differently configured
+    // providers apart; providers configured only through graph properties
+    // can keep the default.
+    virtual void hashConfiguration(FingerprintHasher& hasher) const { (void)hasher; }
 };
 
 // ============================================================================
@@ -5,48 +5,212 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
-#include <memory>
+#include <string_view>
+#include <vector>
+#include <array>
 #include <any>
-#include <typeindex>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
 
 namespace elk {
 
-// Simple property holder using std::any for type-safe storage
+// ============================================================================
+// PropertyRegistry - Maps option keys to dense integer IDs
+// ============================================================================
+
+// Keys are normalized so that "org.eclipse.elk.foo" and "elk.foo" share one
+// ID, matching how elkjs accepts both spellings. Looking up a key does not
+// copy it but takes a shared lock, so code that reads an option per element
+// should hold a Property<T> (or an ID) instead; keyFor() takes no lock.
+// Thread-safe.
+class PropertyRegistry {
+public:
+    // Return the ID for key, registering it if needed
+    static int idFor(std::string_view key);
+
+    // Return the ID for key, or -1 if it was never registered
+    static int find(std::string_view key);
+
+    // Return the normalized key for an ID
+    static const std::string& keyFor(int id);
+};
+
+// ============================================================================
+// Property<T> - Typed property key with a dense integer ID
+// ============================================================================
+
+template<typename T>
+class Property {
+public:
+    explicit Property(const std::string& key, T defaultValue = T{})
+        : id_(PropertyRegistry::idFor(key)), default_(std::move(defaultValue)) {}
+
+    int id() const { return id_; }
+    const T& getDefault() const { return default_; }
+    const std::string& key() const { return PropertyRegistry::keyFor(id_); }
+
+private:
+    int id_;
+    T default_;
+};
+
+// ============================================================================
+// PropertyHolder - Flat property storage keyed by dense property IDs
+// ============================================================================
+
+// The first few properties live inline in the holder; only elements with
+// many options spill into a heap-allocated overflow vector. Values are
+// std::any, which stores numbers, enums, flags and pointers without
+// allocating; a std::string value is one heap allocation, as are the
+// string-valued options the readers store. Lookups never throw: a type
+// mismatch yields the default, except that double options also accept
+// integers and numeric strings, the form netlistsvg skins pass every
+// option in.
 class PropertyHolder {
 public:
+    // Typed access
     template<typename T>
-    void setProperty(const std::string& key, const T& value) {
-        properties_[key] = value;
+    void setProperty(const Property<T>& property, const T& value) {
+        obtainEntry(property.id()).value = value;
     }
 
     template<typename T>
-    T getProperty(const std::string& key, const T& defaultValue = T{}) const {
-        auto it = properties_.find(key);
-        if (it != properties_.end()) {
-            try {
-                return std::any_cast<T>(it->second);
-            } catch (const std::bad_any_cast&) {
-                return defaultValue;
-            }
-        }
-        return defaultValue;
+    T getProperty(const Property<T>& property) const {
+        return valueOr(findEntry(property.id()), property.getDefault());
+    }
+
+    template<typename T>
+    bool hasProperty(const Property<T>& property) const {
+        return findEntry(property.id()) != nullptr;
+    }
+
+    template<typename T>
+    void removeProperty(const Property<T>& property) {
+        eraseEntry(property.id());
+    }
+
+    // String-keyed adapter (Properties:: constants, raw ELK option keys).
+    // Each call resolves the key in the registry.
+    template<typename T>
+    void setProperty(std::string_view key, const T& value) {
+        obtainEntry(PropertyRegistry::idFor(key)).value = value;
+    }
+
+    template<typename T>
+    T getProperty(std::string_view key, const T& defaultValue = T{}) const {
+        return valueOr(findEntry(PropertyRegistry::find(key)), defaultValue);
+    }
+
+    bool hasProperty(std::string_view key) const {
+        return findEntry(PropertyRegistry::find(key)) != nullptr;
+    }
+
+    void removeProperty(std::string_view key) {
+        eraseEntry(PropertyRegistry::find(key));
     }
 
-    bool hasProperty(const std::string& key) const {
-        return properties_.find(key) != properties_.end();
+    // Raw access by registry ID, for readers that resolve each distinct
+    // option key once and reuse the ID
+    void setPropertyValue(int id, std::any value) {
+        obtainEntry(id).value = std::move(value);
     }
 
-    void removeProperty(const std::string& key) {
-        properties_.erase(key);
+    // Visit every stored property as visit(registry ID, const std::any&)
+    template<typename F>
+    void forEachProperty(F&& visit) const {
+        for (std::uint8_t i = 0; i < inlineCount_; i++) {
+            visit(inline_[i].id, inline_[i].value);
+        }
+        for (const Entry& entry : overflow_) {
+            visit(entry.id, entry.value);
+        }
     }
 
     void clearProperties() {
-        properties_.clear();
+        for (std::uint8_t i = 0; i < inlineCount_; i++) {
+            inline_[i] = Entry{};
+        }
+        inlineCount_ = 0;
+        overflow_.clear();
     }
 
+    std::size_t propertyCount() const { return inlineCount_ + overflow_.size(); }
+
 private:
-    std::unordered_map<std::string, std::any> properties_;
+    struct Entry {
+        int id = -1;
+        std::any value;
+    };
+
+    static constexpr std::size_t INLINE_CAPACITY = 3;
+
+    template<typename T>
+    static T valueOr(const Entry* entry, const T& fallback) {
+        if (entry == nullptr) return fallback;
+        if (const T* value = std::any_cast<T>(&entry->value)) {
+            return *value;
+        }
+        if constexpr (std::is_same_v<T, double>) {
+            double number = 0.0;
+            if (toNumber(entry->value, number)) return number;
+        }
+        return fallback;
+    }
+
+    // Reads integers and numeric strings as a double
+    static bool toNumber(const std::any& value, double& number);
+
+    const Entry* findEntry(int id) const {
+        if (id < 0) return nullptr;
+        for (std::uint8_t i = 0; i < inlineCount_; i++) {
+            if (inline_[i].id == id) return &inline_[i];
+        }
+        for (const Entry& entry : overflow_) {
+            if (entry.id == id) return &entry;
+        }
+        return nullptr;
+    }
+
+    Entry& obtainEntry(int id) {
+        if (const Entry* existing = findEntry(id)) {
+            return const_cast<Entry&>(*existing);
+        }
+        if (inlineCount_ < INLINE_CAPACITY) {
+            Entry& entry = inline_[inlineCount_++];
+            entry.id = id;
+            return entry;
+        }
+        overflow_.push_back(Entry{id, {}});
+        return overflow_.back();
+    }
+
+    void eraseEntry(int id) {
+        if (id < 0) return;
+        for (std::uint8_t i = 0; i < inlineCount_; i++) {
+            if (inline_[i].id == id) {
+                // Keep inline slots dense; refill from the overflow if possible
+                inline_[i] = std::move(inline_[inlineCount_ - 1]);
+                if (!overflow_.empty()) {
+                    inline_[inlineCount_ - 1] = std::move(overflow_.back());
+                    overflow_.pop_back();
+                } else {
+                    inline_[--inlineCount_] = Entry{};
+                }
+                return;
+            }
+        }
+        for (auto it = overflow_.begin(); it != overflow_.end(); ++it) {
+            if (it->id == id) {
+                overflow_.erase(it);
+                return;
+            }
+        }
+    }
+
+    std::array<Entry, INLINE_CAPACITY> inline_{};
+    std::vector<Entry> overflow_;
+    std::uint8_t inlineCount_ = 0;
 };
 
 // Common property keys
@@ -71,6 +235,32 @@ namespace Properties {
     inline const std::string LAYERED_CROSSING_MINIMIZATION = "elk.layered.crossingMinimization.strategy";
     inline const std::string LAYERED_NODE_PLACEMENT = "elk.layered.nodePlacement.strategy";
     inline const std::string LAYERED_CYCLE_BREAKING = "elk.layered.cycleBreaking.strategy";
+    inline const std::string LAYERED_LAYERING_STRATEGY = "elk.layered.layering.strategy";
+    inline const std::string LAYERED_COFFMAN_GRAHAM_LAYER_BOUND = "elk.layered.layering.coffmanGraham.layerBound";
+    inline const std::string LAYERED_NODE_PROMOTION_STRATEGY = "elk.layered.layering.nodePromotion.strategy";
+    inline const std::string LAYERED_NODE_PROMOTION_MAX_ITERATIONS = "elk.layered.layering.nodePromotion.maxIterations";
+    inline const std::string LAYERED_LAYER_CONSTRAINT = "elk.layered.layering.layerConstraint";
+    inline const std::string PORT_CONSTRAINTS = "elk.portConstraints";
+    inline const std::string PORT_SIDE = "elk.port.side";
+}
+
+// Typed keys for the options the algorithms read. Values set through the
+// matching Properties:: string keys are visible through these and vice versa.
+namespace LayoutOptions {
+    inline const Property<std::string> ALGORITHM{Properties::ALGORITHM};
+    inline const Property<std::string> PORT_CONSTRAINTS{Properties::PORT_CONSTRAINTS};
+    inline const Property<std::string> LAYERING_STRATEGY{Properties::LAYERED_LAYERING_STRATEGY};
+    inline const Property<double> COFFMAN_GRAHAM_LAYER_BOUND{Properties::LAYERED_COFFMAN_GRAHAM_LAYER_BOUND};
+    inline const Property<std::string> NODE_PROMOTION_STRATEGY{Properties::LAYERED_NODE_PROMOTION_STRATEGY};
+    inline const Property<double> NODE_PROMOTION_MAX_ITERATIONS{Properties::LAYERED_NODE_PROMOTION_MAX_ITERATIONS};
+    inline const Property<std::string> LAYER_CONSTRAINT{Properties::LAYERED_LAYER_CONSTRAINT};
+    inline const Property<std::string> PORT_SIDE{Properties::PORT_SIDE};
+
+    // Internal: set on layered edges that were reversed
+    inline const Property<bool> REVERSED{"REVERSED", false};
+
+    // Internal: spacing NodeSpacingCalculator requires around a node
+    inline const Property<double> REQUIRED_SPACING{"spacing.required"};
 }
 
 } // namespace elk
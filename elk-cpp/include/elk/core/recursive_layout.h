@@ -5,6 +5,7 @@
 #pragma once
 
 #include "layout_provider.h"
+#include "thread_pool.h"
 #include "types.h"
 #include "../graph/graph.h"
 #include <functional>
@@ -26,6 +27,14 @@ struct RecursiveConfig {
     bool layoutChildren = true;
     bool adjustParentSize = true;
     double minParentPadding = 10.0;
+
+    // BOTTOM_UP only: lay out sibling subtrees concurrently, joining before
+    // each parent. The result is identical to the sequential mode provided
+    // the provider is reentrant and only touches the node it is given and
+    // that node's direct children, ports and edges.
+    bool parallel = false;
+    unsigned threads = 0;               // Pool size when no pool is given; 0 = all cores
+    WorkStealingPool* pool = nullptr;   // Optional pool to reuse across layouts
 };
 
 // ============================================================================
@@ -44,6 +53,10 @@ private:
     static void layoutBottomUp(Node* node, ILayoutProvider* provider,
                               const RecursiveConfig& config);
 
+    static void layoutBottomUpParallel(Node* node, ILayoutProvider* provider,
+                                      const RecursiveConfig& config,
+                                      WorkStealingPool& pool);
+
     static void adjustParentSize(Node* parent, const RecursiveConfig& config);
 };
 
@@ -0,0 +1,94 @@
+// Eclipse Layout Kernel - C++ Port
+// Work-stealing thread pool for fork/join parallelism
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace elk {
+
+// ============================================================================
+// WorkStealingPool
+// ============================================================================
+
+// Every worker owns a deque: tasks it spawns go to the back and it takes
+// work from the back (depth first, cache warm), while idle workers steal
+// from the front of other deques (the oldest and usually largest tasks).
+// Tasks spawned by threads outside the pool go to a shared injection queue.
+//
+// Threads waiting on a TaskGroup run pending tasks instead of blocking, so
+// nested fork/join never deadlocks, even with a single worker.
+class WorkStealingPool {
+public:
+    // threads == 0 uses std::thread::hardware_concurrency()
+    explicit WorkStealingPool(unsigned threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    // Queue a task. Prefer TaskGroup, which also waits and forwards errors.
+    void submit(std::function<void()> task);
+
+    // Run one pending task on the calling thread; false if none was found
+    bool runPending();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(std::size_t index);
+    bool popLocal(std::size_t index, std::function<void()>& task);
+    bool steal(std::size_t thief, std::function<void()>& task);
+    std::size_t currentQueue() const;
+
+    std::vector<std::unique_ptr<Queue>> queues_;  // One per worker, then the injection queue
+    std::vector<std::thread> workers_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<std::size_t> queued_{0};
+    bool stopping_ = false;  // Guarded by sleepMutex_
+};
+
+// ============================================================================
+// TaskGroup - Fork/join over a WorkStealingPool
+// ============================================================================
+
+class TaskGroup {
+public:
+    explicit TaskGroup(WorkStealingPool& pool) : pool_(pool) {}
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // Spawn task; it may run on any worker or on a thread inside wait()
+    void run(std::function<void()> task);
+
+    // Help run tasks until all tasks of this group have finished, then
+    // rethrow the first exception one of them threw
+    void wait();
+
+private:
+    WorkStealingPool& pool_;
+    std::atomic<std::size_t> pending_{0};
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+};
+
+} // namespace elk
@@ -0,0 +1,206 @@
+// Eclipse Layout Kernel - C++ Port
+// Tracing: log levels, phase timers, counters and trace export
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Highest trace level compiled into the library (see trace::Level). Messages
+// above it cost nothing at run time; at 0 phase timers and counters are
+// compiled out as well. Set through the ELK_TRACE_LEVEL CMake cache variable.
+#ifndef ELK_TRACE_LEVEL
+#define ELK_TRACE_LEVEL 2
+#endif
+
+namespace elk {
+namespace trace {
+
+enum class Level {
+    NONE = 0,
+    WARN = 1,   // Input that had to be skipped or repaired
+    INFO = 2,   // One line per phase step and summary
+    DEBUG = 3   // Per node, port and edge detail
+};
+
+enum class Counter {
+    REVERSED_EDGES,     // Edges reversed by cycle breaking
+    DUMMY_NODES,        // Long-edge dummies inserted
+    SAVED_DUMMIES,      // Long-edge dummies node promotion saved
+    CROSSINGS,          // Edge crossings left after crossing minimization
+    ROUTING_SLOTS,      // Routing slots used by the orthogonal router
+    NODE_ALLOCATIONS,   // LNode objects created
+    PORT_ALLOCATIONS,   // LPort objects created
+    EDGE_ALLOCATIONS,   // LEdge objects created
+    COUNT
+};
+
+const char* counterName(Counter counter);
+
+// Accumulated timings of one phase name
+struct PhaseStats {
+    std::string name;
+    std::size_t calls = 0;
+    double wallMs = 0.0;
+    double cpuMs = 0.0;    // CPU time of the calling thread
+};
+
+// ============================================================================
+// Tracer - Collects logs, timings and counters of the layouts run under it
+// ============================================================================
+
+// Layout code reports to the tracer installed on its thread with a
+// TraceScope; without one, tracing only costs a thread-local lookup and
+// warnings go to std::cerr. A tracer may be installed on several threads at
+// once. Work a layout hands to other threads (layoutBatch, the parallel
+// recursive engine) is only traced if those threads install it too.
+class Tracer {
+public:
+    Tracer();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    // Messages up to this level are written to the log stream (default WARN)
+    void setLogLevel(Level level) { logLevel_ = level; }
+    Level logLevel() const { return logLevel_; }
+    bool logs(Level level) const { return level <= logLevel_; }
+
+    // Destination of log messages (default std::cerr)
+    void setLogStream(std::ostream& stream) { logStream_ = &stream; }
+
+    // Keep every phase run as an event for writeChromeTrace (default off)
+    void setRecordEvents(bool record) { recordEvents_ = record; }
+
+    void log(const std::string& message);
+    void addPhase(const char* name, std::chrono::steady_clock::time_point start,
+                  double wallMs, double cpuMs);
+    void count(Counter counter, std::int64_t delta);
+
+    std::int64_t counter(Counter counter) const;
+    // Phases in the order they first ran
+    std::vector<PhaseStats> phases() const;
+    void reset();
+
+    // Phase table and counters, human readable
+    void writeSummary(std::ostream& out) const;
+    // Chrome trace-event JSON, for chrome://tracing or Perfetto. Phase runs
+    // are complete ("X") events, final counter values counter ("C") events.
+    void writeChromeTrace(std::ostream& out) const;
+
+private:
+    struct Event {
+        const char* name;
+        double startUs;
+        double wallUs;
+        double cpuUs;
+        int thread;
+    };
+
+    int threadNumber();
+
+    Level logLevel_ = Level::WARN;
+    std::ostream* logStream_;
+    bool recordEvents_ = false;
+    std::chrono::steady_clock::time_point origin_;
+
+    mutable std::mutex mutex_;
+    std::vector<PhaseStats> phases_;
+    std::array<std::int64_t, static_cast<std::size_t>(Counter::COUNT)> counters_{};
+    std::vector<Event> events_;
+    std::vector<std::thread::id> threads_;
+};
+
+// Tracer installed on the calling thread, or null
+Tracer* current();
+
+// Installs a tracer on the calling thread for its lifetime
+class TraceScope {
+public:
+    explicit TraceScope(Tracer& tracer);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    Tracer* previous_;
+};
+
+// Times the enclosing block as the named phase of the current tracer
+class PhaseTimer {
+public:
+    explicit PhaseTimer(const char* name);
+    ~PhaseTimer();
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    Tracer* tracer_;
+    const char* name_;
+    std::chrono::steady_clock::time_point wallStart_;
+    double cpuStart_ = 0.0;
+};
+
+// CPU time of the calling thread in milliseconds
+double threadCpuMs();
+
+// Whether a message of this level would be written
+inline bool logging(Level level) {
+    Tracer* tracer = current();
+    return tracer ? tracer->logs(level) : level == Level::WARN;
+}
+
+// Write a message: to the current tracer's log, or warnings to std::cerr
+void write(Level level, const std::string& message);
+
+inline void count(Counter counter, std::int64_t delta = 1) {
+    if (Tracer* tracer = current()) tracer->count(counter, delta);
+}
+
+} // namespace trace
+} // namespace elk
+
+#define ELK_TRACE_CONCAT_INNER(a, b) a##b
+#define ELK_TRACE_CONCAT(a, b) ELK_TRACE_CONCAT_INNER(a, b)
+
+// True if messages of the given level are compiled in and would be written;
+// guards work done only to produce a message
+#define ELK_TRACE_ENABLED(level) \
+    (static_cast<int>(level) <= ELK_TRACE_LEVEL && ::elk::trace::logging(level))
+
+// Stream-style messages: ELK_TRACE_INFO("Created " << n << " edges\n").
+// The text is written as is; add line breaks explicitly.
+#define ELK_TRACE_MESSAGE(level, message)                     \
+    do {                                                      \
+        if (ELK_TRACE_ENABLED(level)) {                       \
+            std::ostringstream elkTraceStream_;               \
+            elkTraceStream_ << message;                       \
+            ::elk::trace::write(level, elkTraceStream_.str()); \
+        }                                                     \
+    } while (0)
+
+#define ELK_TRACE_WARN(message) ELK_TRACE_MESSAGE(::elk::trace::Level::WARN, message)
+#define ELK_TRACE_INFO(message) ELK_TRACE_MESSAGE(::elk::trace::Level::INFO, message)
+#define ELK_TRACE_DEBUG(message) ELK_TRACE_MESSAGE(::elk::trace::Level::DEBUG, message)
+
+#if ELK_TRACE_LEVEL > 0
+// Time the rest of the enclosing block as a phase
+#define ELK_TRACE_PHASE(name) ::elk::trace::PhaseTimer ELK_TRACE_CONCAT(elkTracePhase_, __LINE__)(name)
+#define ELK_TRACE_COUNT(counter, delta) ::elk::trace::count(::elk::trace::Counter::counter, delta)
+// True if a tracer collects counters; guards counters that cost work
+#define ELK_TRACE_COUNTING() (::elk::trace::current() != nullptr)
+#else
+#define ELK_TRACE_PHASE(name) do { } while (0)
+#define ELK_TRACE_COUNT(counter, delta) do { } while (0)
+#define ELK_TRACE_COUNTING() false
+#endif
@@ -165,6 +165,18 @@ enum class EdgeRouting {
     SPLINES        // Curved splines
 };
 
+enum class LayeringStrategy {
+    LONGEST_PATH,
+    NETWORK_SIMPLEX,
+    COFFMAN_GRAHAM
+};
+
+enum class NodePromotionStrategy {
+    NONE,
+    NIKOLOV,      // Only promotions that keep every layer within the widest one
+    NO_BOUNDARY   // Any promotion that saves dummies
+};
+
 enum class NodePlacementStrategy {
     SIMPLE,
     LINEAR_SEGMENTS,
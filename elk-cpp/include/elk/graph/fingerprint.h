@@ -0,0 +1,99 @@
+// Eclipse Layout Kernel - C++ Port
+// Structural 128-bit fingerprints of graph hierarchies
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace elk {
+
+class Node;
+
+// ============================================================================
+// Fingerprint - 128-bit structural hash value
+// ============================================================================
+
+struct Fingerprint {
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+
+    bool operator==(const Fingerprint& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const Fingerprint& other) const { return !(*this == other); }
+    bool operator<(const Fingerprint& other) const {
+        return high != other.high ? high < other.high : low < other.low;
+    }
+
+    // 32 lowercase hex digits, high word first
+    std::string hex() const;
+};
+
+// ============================================================================
+// FingerprintHasher - Streaming 128-bit hash (MurmurHash3 x64_128 body)
+// ============================================================================
+
+// Values are fed as integers rather than as raw memory, so the result does
+// not depend on byte order; doubles are hashed by their IEEE-754 bits with
+// -0 folded into 0 and every NaN into one value.
+class FingerprintHasher {
+public:
+    explicit FingerprintHasher(std::uint64_t seed = 0) : h1_(seed), h2_(seed) {}
+
+    void add(std::uint64_t value);
+    void add(double value);
+    void add(std::string_view text);  // Length-prefixed
+    void add(bool value) { add(static_cast<std::uint64_t>(value ? 1 : 0)); }
+    void add(std::int64_t value) { add(static_cast<std::uint64_t>(value)); }
+    void add(int value) { add(static_cast<std::uint64_t>(static_cast<std::int64_t>(value))); }
+
+    Fingerprint finish() const;
+
+private:
+    void mixBlock(std::uint64_t k1, std::uint64_t k2);
+
+    std::uint64_t h1_;
+    std::uint64_t h2_;
+    std::uint64_t pending_ = 0;
+    bool hasPending_ = false;
+    std::uint64_t length_ = 0;  // Bytes fed
+};
+
+// ============================================================================
+// Graph fingerprints
+// ============================================================================
+
+struct FingerprintOptions {
+    // Include element IDs. Layout does not depend on them except through
+    // tie-breaking, but a cache that copies results back by structure is
+    // only safe when they match.
+    bool ids = true;
+
+    // Include label sizes (label text is ignored; only its extent matters)
+    bool labels = true;
+};
+
+// Canonical hash of everything in the hierarchy below root that is input to
+// layout: leaf node sizes, padding, ports (side, position, size, order), edge
+// endpoints, labels and the string, numeric and boolean layout options of
+// every element (hashed by normalized key text in sorted order). Node
+// positions, the size of the root and of compound nodes, edge sections and
+// junction points are layout output and are ignored, as are internal
+// properties that are not plain values.
+//
+// Runs in time linear in the size of the graph. Elements are identified by
+// their position in the tree, never by address, so the result is the same
+// across runs, processes and platforms for the same input.
+Fingerprint fingerprint(const Node& root, const FingerprintOptions& options = {});
+
+} // namespace elk
+
+template<>
+struct std::hash<elk::Fingerprint> {
+    std::size_t operator()(const elk::Fingerprint& fp) const noexcept {
+        return static_cast<std::size_t>(fp.low ^ (fp.high * 0x9E3779B97F4A7C15ull));
+    }
+};
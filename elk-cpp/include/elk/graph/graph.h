@@ -6,6 +6,9 @@
 
 #include "../core/types.h"
 #include "../core/properties.h"
+#include "graph_arena.h"
+#include "graph_index.h"
+#include "symbol_table.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -36,7 +39,7 @@ public:
     enum class ParentType { NONE, NODE, EDGE, PORT };
     ParentType parentType = ParentType::NONE;
 
-    std::string id;
+    ElementId id;
 
     Label() = default;
     Label(const std::string& txt) : text(txt) {}
@@ -64,10 +67,9 @@ public:
     int index = -1;      // Index within port list (for ordering)
 
     Node* parent = nullptr;  // Non-owning pointer
-    std::string id;
+    ElementId id;
 
     Port() = default;
-    explicit Port(const std::string& id_) : id(id_) {}
 
     Rect getBounds() const { return {position.x, position.y, size.width, size.height}; }
     Point getAbsolutePosition() const;  // Implemented in cpp
@@ -166,10 +168,9 @@ public:
     std::vector<Port*> targetPorts;
 
     Node* containingNode = nullptr;  // Non-owning pointer
-    std::string id;
+    ElementId id;
 
     Edge() = default;
-    explicit Edge(const std::string& id_) : id(id_) {}
 
     bool isHyperedge() const {
         return (sourceNodes.size() + sourcePorts.size() > 1) ||
@@ -189,9 +190,9 @@ public:
     Size size;
     Padding padding;
 
-    std::vector<std::unique_ptr<Node>> children;     // Owned child nodes
-    std::vector<std::unique_ptr<Port>> ports;        // Owned ports
-    std::vector<std::unique_ptr<Edge>> edges;        // Owned edges (contained in this node)
+    std::vector<ElementPtr<Node>> children;     // Owned child nodes
+    std::vector<ElementPtr<Port>> ports;        // Owned ports
+    std::vector<ElementPtr<Edge>> edges;        // Owned edges (contained in this node)
     std::vector<Label> labels;
 
     // Edge connectivity (from ElkConnectableShape)
@@ -199,30 +200,62 @@ public:
     std::vector<Edge*> outgoingEdges;  // Non-owning pointers to edges sourcing from this node
 
     Node* parent = nullptr;  // Non-owning pointer to parent
-    std::string id;
+    ElementId id;
+
+    // Optional allocation region for elements created by the factory methods
+    // below; inherited by child nodes. Must outlive this node.
+    GraphArena* arena = nullptr;  // Non-owning
+
+    // Optional ID index kept up to date by the factory methods below;
+    // inherited by child nodes. Must outlive this node, and be rebuilt
+    // after elements are removed from the tree.
+    GraphIndex* index = nullptr;  // Non-owning
+
+    // Interner for the IDs of elements created by the factory methods
+    // below; inherited by child nodes. Must outlive this node. If none is
+    // set, the node creates and owns one, so IDs are freed with the graph.
+    SymbolTable* symbols = nullptr;  // Non-owning
 
     Node() = default;
-    explicit Node(const std::string& id_) : id(id_) {}
+    explicit Node(const std::string& id_) { id = ElementId(id_, symbolTable()); }
+
+    // The table of symbols, created if none is set
+    SymbolTable& symbolTable() {
+        if (symbols == nullptr) {
+            ownedSymbols_ = std::make_unique<SymbolTable>();
+            symbols = ownedSymbols_.get();
+        }
+        return *symbols;
+    }
 
     // Factory methods for building graph
     Node* addChild(const std::string& childId = "") {
-        auto child = std::make_unique<Node>(childId);
+        auto child = makeElement<Node>();
+        child->id = ElementId(childId, symbolTable());
         child->parent = this;
+        child->arena = arena;
+        child->index = index;
+        child->symbols = symbols;
+        if (index != nullptr) index->addNode(child.get());
         children.push_back(std::move(child));
         return children.back().get();
     }
 
     Port* addPort(const std::string& portId = "", PortSide side = PortSide::UNDEFINED) {
-        auto port = std::make_unique<Port>(portId);
+        auto port = makeElement<Port>();
+        port->id = ElementId(portId, symbolTable());
         port->parent = this;
         port->side = side;
+        if (index != nullptr) index->addPort(port.get());
         ports.push_back(std::move(port));
         return ports.back().get();
     }
 
     Edge* addEdge(const std::string& edgeId = "") {
-        auto edge = std::make_unique<Edge>(edgeId);
+        auto edge = makeElement<Edge>();
+        edge->id = ElementId(edgeId, symbolTable());
         edge->containingNode = this;
+        if (index != nullptr) index->addEdge(edge.get());
         edges.push_back(std::move(edge));
         return edges.back().get();
     }
@@ -243,18 +276,24 @@ public:
                 parentPos.y + position.y + parent->padding.top};
     }
 
-    // Find nodes/ports/edges by ID
+    // Find nodes/ports/edges by ID, returning the first match of a
+    // depth-first walk of the tree. With an index attached this takes
+    // constant time, except for IDs the index has seen more than once,
+    // which are looked up by walking the tree.
     Node* findNode(const std::string& nodeId) {
         if (id == nodeId) return this;
-        for (auto& child : children) {
-            if (auto found = child->findNode(nodeId)) {
-                return found;
-            }
+        if (index != nullptr && !index->isNodeIdReused(nodeId)) {
+            Node* found = index->findNode(nodeId);
+            return (found != nullptr && isAncestorOf(found)) ? found : nullptr;
         }
-        return nullptr;
+        return findNodeInTree(nodeId);
     }
 
     Port* findPort(const std::string& portId) {
+        if (index != nullptr && !index->isPortIdReused(portId)) {
+            Port* found = index->findPort(portId);
+            return (found != nullptr && found->parent == this) ? found : nullptr;
+        }
         for (auto& port : ports) {
             if (port->id == portId) {
                 return port.get();
@@ -263,6 +302,14 @@ public:
         return nullptr;
     }
 
+    // True if node is this node or one of its descendants
+    bool isAncestorOf(const Node* node) const {
+        for (; node != nullptr; node = node->parent) {
+            if (node == this) return true;
+        }
+        return false;
+    }
+
     // Get all edges (including in child nodes)
     void collectAllEdges(std::vector<Edge*>& allEdges) {
         for (auto& edge : edges) {
@@ -293,6 +340,26 @@ public:
         }
         return bounds;
     }
+
+private:
+    std::unique_ptr<SymbolTable> ownedSymbols_;
+
+    // Descendant with the given ID, in the order of a depth-first walk
+    Node* findNodeInTree(const std::string& nodeId) {
+        for (auto& child : children) {
+            if (child->id == nodeId) return child.get();
+            if (Node* found = child->findNodeInTree(nodeId)) return found;
+        }
+        return nullptr;
+    }
+
+    template<typename T, typename... Args>
+    ElementPtr<T> makeElement(Args&&... args) const {
+        if (arena != nullptr) {
+            return ElementPtr<T>(arena->create<T>(std::forward<Args>(args)...), ElementDeleter{true});
+        }
+        return ElementPtr<T>(new T(std::forward<Args>(args)...));
+    }
 };
 
 // ============================================================================
@@ -0,0 +1,91 @@
+// Eclipse Layout Kernel - C++ Port
+// Bump allocator for graph elements
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace elk {
+
+// ============================================================================
+// GraphArena - Bump-allocated region for Node, Port and Edge objects
+// ============================================================================
+
+// All elements of one layout request are carved out of a few large blocks
+// instead of one heap allocation each. Elements allocated here are still
+// destructed individually (their labels, sections and property maps own heap
+// memory), so tearing a graph down stays O(n); but their storage is never
+// returned to the global heap one by one: release() drops all blocks at once.
+//
+// The arena must outlive every element allocated from it.
+class GraphArena {
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit GraphArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~GraphArena();
+
+    GraphArena(const GraphArena&) = delete;
+    GraphArena& operator=(const GraphArena&) = delete;
+
+    // Allocate raw storage; never returns nullptr
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    // Allocate and construct an object in the arena
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        void* mem = allocate(sizeof(T), alignof(T));
+        return new (mem) T(std::forward<Args>(args)...);
+    }
+
+    // Free every block. Objects created in the arena must already be destroyed.
+    void release();
+
+    // Statistics
+    std::size_t bytesAllocated() const { return bytesAllocated_; }
+    std::size_t bytesReserved() const { return bytesReserved_; }
+    std::size_t blockCount() const { return blockCount_; }
+
+private:
+    struct Block {
+        Block* next;
+        std::size_t size;  // Usable bytes following the header
+    };
+
+    void addBlock(std::size_t minSize);
+
+    std::size_t blockSize_;
+    Block* head_ = nullptr;
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+
+    std::size_t bytesAllocated_ = 0;
+    std::size_t bytesReserved_ = 0;
+    std::size_t blockCount_ = 0;
+};
+
+// ============================================================================
+// ElementDeleter - Deleter for graph elements that may live in a GraphArena
+// ============================================================================
+
+struct ElementDeleter {
+    bool arenaOwned = false;
+
+    template<typename T>
+    void operator()(T* ptr) const {
+        if (arenaOwned) {
+            ptr->~T();  // Storage is reclaimed by GraphArena::release()
+        } else {
+            delete ptr;
+        }
+    }
+};
+
+template<typename T>
+using ElementPtr = std::unique_ptr<T, ElementDeleter>;
+
+} // namespace elk
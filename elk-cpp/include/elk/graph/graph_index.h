@@ -0,0 +1,90 @@
+// Eclipse Layout Kernel - C++ Port
+// Hash index from element IDs to graph elements
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "symbol_table.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace elk {
+
+class Node;
+class Port;
+class Edge;
+
+// ============================================================================
+// GraphIndex - O(1) lookup of nodes, ports and edges by ID
+// ============================================================================
+
+// Either build() it once over a finished tree, or attach it to the root
+// (Node::index) before the graph is built so that addChild/addPort/addEdge
+// register every element as it is created. IDs are unique across the whole
+// hierarchy in ELK JSON; if one is reused, the element registered last
+// wins and the ID is remembered as reused, so that Node::findNode and
+// findPort can walk the tree for it instead. Elements with an empty ID are
+// not indexed. The index holds plain pointers: build() it again after
+// removing elements from the tree.
+// Keys are the interned symbols of the element IDs; string lookups resolve
+// the text in the graph's SymbolTable first and never allocate.
+class GraphIndex {
+public:
+    GraphIndex() = default;
+    explicit GraphIndex(Node* root) { build(root); }
+
+    // Clear and index every element below (and including) root
+    void build(Node* root);
+    void clear();
+
+    // Registration (used by the Node factory methods)
+    void addNode(Node* node);
+    void addPort(Port* port);
+    void addEdge(Edge* edge);
+
+    // Lookup; nullptr if the ID is unknown
+    Node* findNode(const std::string& id) const;
+    Port* findPort(const std::string& id) const;
+    Edge* findEdge(const std::string& id) const;
+
+    Node* findNode(const ElementId& id) const;
+    Port* findPort(const ElementId& id) const;
+    Edge* findEdge(const ElementId& id) const;
+
+    // True if more than one node (port) was registered with the ID
+    bool isNodeIdReused(const std::string& id) const { return isReused(reusedNodes_, id); }
+    bool isPortIdReused(const std::string& id) const { return isReused(reusedPorts_, id); }
+
+    std::size_t nodeCount() const { return nodes_.size(); }
+    std::size_t portCount() const { return ports_.size(); }
+    std::size_t edgeCount() const { return edges_.size(); }
+
+private:
+    void indexSubtree(Node* node);
+
+    // Symbol of id in table_ (adopting id's table if none is set yet)
+    Symbol keyFor(const ElementId& id);
+    bool lookup(const std::string& text, Symbol& symbol) const;
+    bool lookup(const ElementId& id, Symbol& symbol) const;
+
+    bool isReused(const std::unordered_set<Symbol>& reused, const std::string& id) const {
+        Symbol symbol;
+        return !reused.empty() && lookup(id, symbol) && reused.count(symbol) != 0;
+    }
+
+    template<typename T>
+    static T* get(const std::unordered_map<Symbol, T*>& map, Symbol symbol) {
+        auto it = map.find(symbol);
+        return it != map.end() ? it->second : nullptr;
+    }
+
+    SymbolTable* table_ = nullptr;
+    std::unordered_map<Symbol, Node*> nodes_;
+    std::unordered_map<Symbol, Port*> ports_;
+    std::unordered_map<Symbol, Edge*> edges_;
+    std::unordered_set<Symbol> reusedNodes_;
+    std::unordered_set<Symbol> reusedPorts_;
+};
+
+} // namespace elk
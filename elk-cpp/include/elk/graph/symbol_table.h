@@ -0,0 +1,149 @@
+// Eclipse Layout Kernel - C++ Port
+// String interning for element IDs
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace elk {
+
+using Symbol = std::uint32_t;
+
+// ============================================================================
+// SymbolTable - Interns ID strings into 32-bit symbols
+// ============================================================================
+
+// Each graph has its own table (Node::symbols, or one its root creates on
+// demand), so that each distinct ID text is stored once and freed with the
+// graph. Symbol 0 is always the empty string. Interning and lookup are
+// thread-safe; reading the text or hash of an interned symbol takes no lock,
+// as entries are stored in chunks that never move.
+class SymbolTable {
+public:
+    struct Entry {
+        std::string text;
+        std::size_t hash = 0;
+        Symbol symbol = 0;
+        SymbolTable* table = nullptr;
+    };
+
+    SymbolTable();
+    ~SymbolTable();
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // Return the symbol for text, adding it if needed
+    Symbol intern(std::string_view text);
+
+    // Look up text without adding it; false if it was never interned
+    bool find(std::string_view text, Symbol& symbol) const;
+
+    // Entry of a symbol returned by intern() or find()
+    const Entry& entry(Symbol symbol) const {
+        std::size_t offset = 0;
+        int chunk = chunkOf(symbol, offset);
+        return chunks_[chunk].load(std::memory_order_acquire)[offset];
+    }
+
+    // Text and precomputed hash of a symbol
+    const std::string& text(Symbol symbol) const { return entry(symbol).text; }
+    std::size_t hash(Symbol symbol) const { return entry(symbol).hash; }
+
+    std::size_t size() const;
+
+private:
+    // Chunk k holds FIRST_CHUNK << k entries, starting at symbol
+    // FIRST_CHUNK * ((1 << k) - 1); 25 chunks cover every 32-bit symbol
+    static constexpr std::uint64_t FIRST_CHUNK = 256;
+    static constexpr int MAX_CHUNKS = 25;
+
+    static int chunkOf(Symbol symbol, std::size_t& offset) {
+        std::uint64_t position = symbol / FIRST_CHUNK + 1;
+        int chunk = 0;
+        for (int shift = 16; shift > 0; shift >>= 1) {
+            if (position >> shift) {
+                position >>= shift;
+                chunk += shift;
+            }
+        }
+        offset = static_cast<std::size_t>(symbol - FIRST_CHUNK * ((std::uint64_t(1) << chunk) - 1));
+        return chunk;
+    }
+
+    mutable std::shared_mutex mutex_;
+    std::uint64_t size_ = 0;
+    std::array<std::atomic<Entry*>, MAX_CHUNKS> chunks_{};
+    std::unordered_map<std::string_view, Symbol> symbols_;  // Views into the entries
+};
+
+// ============================================================================
+// ElementId - Interned element ID (pointer to a symbol table entry)
+// ============================================================================
+
+// The size of a pointer. Comparison and hashing use the entry and the hash
+// cached in it; the text is only touched when str() is called (e.g. on
+// export) or when comparing IDs from two different tables. An ID is valid
+// as long as its table.
+class ElementId {
+public:
+    ElementId() = default;
+    ElementId(std::string_view text, SymbolTable& table) : entry_(&table.entry(table.intern(text))) {}
+
+    // Wrap a symbol already interned in table (e.g. by a reader that
+    // interns straight from its input buffer)
+    ElementId(SymbolTable* table, Symbol symbol) : entry_(table != nullptr ? &table->entry(symbol) : nullptr) {}
+
+    Symbol symbol() const { return entry_ != nullptr ? entry_->symbol : 0; }
+    SymbolTable* table() const { return entry_ != nullptr ? entry_->table : nullptr; }
+
+    bool empty() const { return entry_ == nullptr || entry_->symbol == 0; }
+
+    const std::string& str() const {
+        static const std::string emptyText;
+        return entry_ != nullptr ? entry_->text : emptyText;
+    }
+
+    std::size_t hash() const {
+        static const std::size_t emptyHash = std::hash<std::string_view>{}(std::string_view());
+        return entry_ != nullptr ? entry_->hash : emptyHash;
+    }
+
+    bool operator==(const ElementId& other) const {
+        if (entry_ == other.entry_) return true;
+        if (empty() || other.empty()) return empty() && other.empty();
+        return entry_->table != other.entry_->table && entry_->text == other.entry_->text;
+    }
+    bool operator!=(const ElementId& other) const { return !(*this == other); }
+
+    bool operator==(const std::string& text) const { return str() == text; }
+    bool operator!=(const std::string& text) const { return str() != text; }
+
+    // Orders by text so that sorted output does not depend on intern order
+    bool operator<(const ElementId& other) const { return str() < other.str(); }
+
+private:
+    const SymbolTable::Entry* entry_ = nullptr;
+};
+
+static_assert(sizeof(ElementId) == sizeof(void*), "ElementId is one entry pointer");
+
+inline std::ostream& operator<<(std::ostream& os, const ElementId& id) {
+    return os << id.str();
+}
+
+} // namespace elk
+
+template<>
+struct std::hash<elk::ElementId> {
+    std::size_t operator()(const elk::ElementId& id) const noexcept { return id.hash(); }
+};
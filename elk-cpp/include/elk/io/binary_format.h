@@ -0,0 +1,212 @@
+// Eclipse Layout Kernel - C++ Port
+// Memory-mappable binary format for graphs and layout results
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "graph_document.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace elk {
+namespace io {
+
+// ============================================================================
+// Binary graph format (".elkb")
+// ============================================================================
+
+// A file is a Header followed by flat tables of fixed-size records, each
+// starting at an 8-byte aligned offset. Records refer to each other by table
+// index and own contiguous runs of other tables through Ranges, so a mapped
+// file can be walked in place: nothing is decoded except the header.
+//
+// Nodes are stored breadth-first with the root at index 0, so every node's
+// children are contiguous; ports, edges, labels and options of an element
+// are contiguous as well. Strings (IDs, label text, option keys and values)
+// are stored once each in a character blob. Numbers are native-endian
+// IEEE doubles; files written on a machine with a different byte order are
+// rejected rather than converted.
+namespace binary {
+
+constexpr char MAGIC[8] = {'E', 'L', 'K', 'G', 'R', 'A', 'P', 'H'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+struct Range {
+    std::uint32_t first;
+    std::uint32_t count;
+};
+
+struct Table {
+    std::uint64_t offset;  // From the start of the file
+    std::uint64_t count;   // Number of records
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    Table nodes;
+    Table ports;
+    Table edges;
+    Table endpoints;
+    Table sections;
+    Table labels;
+    Table points;
+    Table options;
+    Table strings;
+    Table chars;  // Byte blob the strings point into
+};
+
+struct NodeRecord {
+    std::uint32_t id;      // String index
+    std::uint32_t parent;  // Node index, NONE for the root
+    Range children;
+    Range ports;
+    Range edges;
+    Range labels;
+    Range options;
+    double x, y, width, height;
+    double paddingTop, paddingRight, paddingBottom, paddingLeft;
+};
+
+struct PortRecord {
+    std::uint32_t id;
+    std::uint32_t node;  // Owning node index
+    std::uint32_t side;  // PortSide
+    std::int32_t index;
+    Range labels;
+    Range options;
+    double x, y, width, height;
+};
+
+enum class ShapeKind : std::uint32_t { NODE = 0, PORT = 1, NONE = 2 };
+
+struct EndpointRecord {
+    ShapeKind kind;
+    std::uint32_t index;  // Node or port index
+};
+
+struct EdgeRecord {
+    std::uint32_t id;
+    std::uint32_t container;  // Containing node index
+    Range sources;            // Endpoints
+    Range targets;            // Endpoints
+    Range sections;
+    Range junctionPoints;     // Points
+    Range labels;
+    Range options;
+};
+
+struct SectionRecord {
+    std::uint32_t id;
+    std::uint32_t reserved;
+    EndpointRecord incomingShape;
+    EndpointRecord outgoingShape;
+    Range bendPoints;  // Points
+    double startX, startY, endX, endY;
+};
+
+struct LabelRecord {
+    std::uint32_t id;
+    std::uint32_t text;  // String index
+    Range options;
+    double x, y, width, height;
+};
+
+struct PointRecord {
+    double x, y;
+};
+
+enum class OptionType : std::uint32_t { STRING = 0, NUMBER = 1, BOOLEAN = 2 };
+
+struct OptionRecord {
+    std::uint32_t key;  // String index (normalized "elk.*" key)
+    OptionType type;
+    std::uint32_t text;  // String index for STRING
+    std::uint32_t flag;  // 0/1 for BOOLEAN
+    double number;       // NUMBER
+};
+
+struct StringRecord {
+    std::uint32_t offset;  // Into the chars table
+    std::uint32_t length;
+};
+
+} // namespace binary
+
+// Thrown when a buffer is not a valid binary graph
+class BinaryFormatError : public std::runtime_error {
+public:
+    explicit BinaryFormatError(const std::string& message)
+        : std::runtime_error("Binary graph: " + message) {}
+};
+
+// ============================================================================
+// BinaryGraphView - Zero-copy access to a binary graph in memory
+// ============================================================================
+
+// Validates the header and that every table lies inside the buffer; record
+// contents are not checked (readElkBinary() does that while building). The
+// buffer must stay alive and 8-byte aligned (mmap and malloc both are).
+class BinaryGraphView {
+public:
+    explicit BinaryGraphView(std::string_view bytes);
+
+    const binary::Header& header() const { return *header_; }
+
+    std::size_t nodeCount() const { return header_->nodes.count; }
+    std::size_t portCount() const { return header_->ports.count; }
+    std::size_t edgeCount() const { return header_->edges.count; }
+    std::size_t stringCount() const { return header_->strings.count; }
+
+    const binary::NodeRecord& root() const { return nodes()[0]; }
+
+    const binary::NodeRecord* nodes() const { return table<binary::NodeRecord>(header_->nodes); }
+    const binary::PortRecord* ports() const { return table<binary::PortRecord>(header_->ports); }
+    const binary::EdgeRecord* edges() const { return table<binary::EdgeRecord>(header_->edges); }
+    const binary::EndpointRecord* endpoints() const { return table<binary::EndpointRecord>(header_->endpoints); }
+    const binary::SectionRecord* sections() const { return table<binary::SectionRecord>(header_->sections); }
+    const binary::LabelRecord* labels() const { return table<binary::LabelRecord>(header_->labels); }
+    const binary::PointRecord* points() const { return table<binary::PointRecord>(header_->points); }
+    const binary::OptionRecord* options() const { return table<binary::OptionRecord>(header_->options); }
+
+    // Text of a string index; throws BinaryFormatError if out of range
+    std::string_view string(std::uint32_t index) const;
+
+private:
+    template<typename T>
+    const T* table(const binary::Table& table) const {
+        return reinterpret_cast<const T*>(bytes_.data() + table.offset);
+    }
+
+    std::string_view bytes_;
+    const binary::Header* header_ = nullptr;
+};
+
+// ============================================================================
+// Reading and writing
+// ============================================================================
+
+// Append the graph (structure, options and layout results) to out
+void writeElkBinary(const Node& root, std::string& out);
+
+// Create or truncate path and write the graph to it
+void writeElkBinaryFile(const Node& root, const std::string& path);
+
+// Build a graph from a binary buffer. Throws BinaryFormatError on invalid
+// input. Option values keep their types (std::string, double, bool).
+GraphDocument readElkBinary(std::string_view bytes, const ReadOptions& options = {});
+
+// Map the file into memory and read it with readElkBinary()
+GraphDocument readElkBinaryFile(const std::string& path, const ReadOptions& options = {});
+
+// True if bytes start with the binary graph magic
+bool isElkBinary(std::string_view bytes);
+
+} // namespace io
+} // namespace elk
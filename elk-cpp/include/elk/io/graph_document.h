@@ -0,0 +1,39 @@
+// Eclipse Layout Kernel - C++ Port
+// Graph read from a file, with the storage it lives in
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "../graph/graph.h"
+#include <memory>
+
+namespace elk {
+namespace io {
+
+// ============================================================================
+// GraphDocument - A graph read from a file, with the storage it lives in
+// ============================================================================
+
+// Members are declared so that root is destroyed before the index, symbol
+// table and arena it points into.
+struct GraphDocument {
+    std::unique_ptr<GraphArena> arena;     // Null unless ReadOptions::useArena
+    std::unique_ptr<SymbolTable> symbols;  // Interned element IDs
+    std::unique_ptr<GraphIndex> index;     // Attached to every node (Node::index)
+    std::unique_ptr<Node> root;
+};
+
+struct ReadOptions {
+    // Allocate nodes, ports and edges from a GraphArena owned by the document
+    bool useArena = true;
+};
+
+// Empty document (root without an ID) with its storage set up per options;
+// the root's arena and symbols are set, the index is attached by the reader
+GraphDocument makeGraphDocument(const ReadOptions& options);
+
+// Build the document's index over the finished tree and attach it to every node
+void indexGraphDocument(GraphDocument& document);
+
+} // namespace io
+} // namespace elk
@@ -0,0 +1,55 @@
+// Eclipse Layout Kernel - C++ Port
+// Streaming reader for ELK JSON graphs
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "graph_document.h"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace elk {
+namespace io {
+
+// Thrown on malformed input or unresolvable edge endpoints
+class JsonReadError : public std::runtime_error {
+public:
+    JsonReadError(const std::string& message, std::size_t offset)
+        : std::runtime_error("JSON offset " + std::to_string(offset) + ": " + message),
+          offset_(offset) {}
+
+    // Byte offset into the input where the error was detected
+    std::size_t offset() const { return offset_; }
+
+private:
+    std::size_t offset_;
+};
+
+// ============================================================================
+// ELK JSON reader
+// ============================================================================
+
+// Builds the graph directly while scanning the input (no intermediate DOM).
+// Accepts the ELK JSON format as produced by netlistsvg (lib/elkGraph.ts)
+// and elkjs: nodes with id, x, y, width, height, children, ports, edges,
+// labels and layoutOptions (or the older "properties"); edges in both the
+// extended form (sources/targets arrays) and the primitive form
+// (source/sourcePort/target/targetPort), plus sections and junctionPoints
+// when reading a laid-out graph. Unknown members are skipped.
+//
+// IDs are interned straight from the input into the document's SymbolTable.
+// String layout option values are stored as std::string, numbers as double
+// and booleans as bool; "elk.port.side" also sets Port::side.
+//
+// Objects and arrays nested more than 4096 deep are rejected with a
+// JsonReadError rather than exhausting the stack.
+GraphDocument readElkJson(std::string_view json, const ReadOptions& options = {});
+
+// Map the file into memory and read it with readElkJson().
+// Throws std::runtime_error if the file cannot be opened.
+GraphDocument readElkJsonFile(const std::string& path, const ReadOptions& options = {});
+
+} // namespace io
+} // namespace elk
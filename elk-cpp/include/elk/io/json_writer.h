@@ -0,0 +1,49 @@
+// Eclipse Layout Kernel - C++ Port
+// Streaming writer for laid-out ELK JSON graphs
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "../graph/graph.h"
+#include <string>
+
+namespace elk {
+namespace io {
+
+struct JsonWriteOptions {
+    // Spaces per nesting level; 0 writes compact JSON. netlistsvg's
+    // dumpLayout uses 2.
+    int indent = 0;
+
+    // Write each element's string, numeric and boolean properties as
+    // "layoutOptions" (keys in their normalized "elk.*" spelling)
+    bool layoutOptions = true;
+};
+
+// ============================================================================
+// ELK JSON writer
+// ============================================================================
+
+// Serializes a graph in the shape elkjs returns from layout(): every node,
+// port and label with id, x, y, width and height; edges with sources and
+// targets, sections (startPoint, endPoint, bendPoints, incomingShape,
+// outgoingShape) and junctionPoints. Coordinates are written as stored, i.e.
+// relative to the parent node, which is what netlistsvg's drawModule expects.
+//
+// Output goes through a fixed-size buffer; numbers are formatted with
+// std::to_chars (shortest round-trip form) and no intermediate strings are
+// built. Non-finite numbers are written as null, as JSON.stringify does.
+
+// Append the graph to out
+void writeElkJson(const Node& root, std::string& out, const JsonWriteOptions& options = {});
+
+// Write the graph to an open file descriptor.
+// Throws std::runtime_error if a write fails.
+void writeElkJson(const Node& root, int fd, const JsonWriteOptions& options = {});
+
+// Create or truncate path and write the graph to it.
+// Throws std::runtime_error if the file cannot be written.
+void writeElkJsonFile(const Node& root, const std::string& path, const JsonWriteOptions& options = {});
+
+} // namespace io
+} // namespace elk
@@ -0,0 +1,49 @@
+// Eclipse Layout Kernel - C++ Port
+// Read-only memory-mapped file
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace elk {
+namespace io {
+
+// ============================================================================
+// MappedFile - Read-only view of a whole file
+// ============================================================================
+
+// Maps the file with mmap on POSIX systems so that readers can parse it in
+// place without copying it into a string first. On other platforms, or when
+// mapping fails (e.g. for pipes), the contents are read into memory instead.
+// Throws std::runtime_error if the file cannot be opened.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+
+    // True if the contents are mapped rather than copied
+    bool isMapped() const { return mapped_; }
+
+private:
+    void unmap();
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    std::string buffer_;  // Contents when not mapped
+};
+
+} // namespace io
+} // namespace elk
@@ -0,0 +1,147 @@
+// Eclipse Layout Kernel - C++ Port
+// Synthetic netlist graphs for tests and benchmarks
+// SPDX-License-Identifier: EPL-2.0
+
+#pragma once
+
+#include "../graph/graph.h"
+#include "../io/graph_document.h"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace elk {
+namespace testing {
+
+// Cell shapes of netlistsvg's default skin (lib/default.svg)
+enum class CellKind {
+    INPUT,      // inputExt: module input, pin Y
+    OUTPUT,     // outputExt: module output, pin A
+    CONSTANT,   // constant: pin Y
+    AND,        // and: A, B -> Y
+    OR,         // or: A, B -> Y
+    XOR,        // reduce_xor: A, B -> Y
+    NOT,        // not: A -> Y
+    MUX,        // mux: A, B, S (south) -> Y
+    ADD,        // add: A, B -> Y
+    EQ,         // eq: A, B -> Y
+    DFF         // dff: D, CLK -> Q; ARST (south)
+};
+
+// ============================================================================
+// NetlistBuilder - Adds skin-shaped cells and nets to a module node
+// ============================================================================
+
+// Cells get the size, pin positions and pin sides netlistsvg gives them, and
+// IDs in its style: cell "<prefix>$and$12", pin "<cell>.A", edge "<prefix>e7".
+// Module ports, constants and instances carry their name as a label, as
+// netlistsvg's "ref" text. A net with several riders becomes one edge per
+// rider, as netlistsvg emits them. Splits, joins and instances use the
+// generic skin shapes, which grow by 20 per pin beyond two.
+//
+// All random choices come from a std::mt19937_64 seeded by the caller and
+// avoid the implementation-defined standard distributions, so a seed yields
+// the same graph on every platform.
+class NetlistBuilder {
+public:
+    explicit NetlistBuilder(Node* module, std::uint64_t seed = 1, const std::string& prefix = "");
+
+    Node* module() const { return module_; }
+    std::mt19937_64& random() { return random_; }
+
+    // Uniform choice in [0, n); n must be positive
+    std::size_t pick(std::size_t n) { return static_cast<std::size_t>(random_() % n); }
+
+    Node* addCell(CellKind kind, const std::string& label = "");
+    Node* addInput(const std::string& name) { return addCell(CellKind::INPUT, name); }
+    Node* addOutput(const std::string& name) { return addCell(CellKind::OUTPUT, name); }
+    Node* addConstant(const std::string& value) { return addCell(CellKind::CONSTANT, value); }
+
+    // Bus split with pins in, out0..out<n-1>; join with in0..in<n-1>, out
+    Node* addSplit(std::size_t outputs);
+    Node* addJoin(std::size_t inputs);
+
+    // Submodule instance (generic skin) with pins in0.., out0..; fill it
+    // through a NetlistBuilder on the returned node
+    Node* addInstance(const std::string& name, std::size_t inputs, std::size_t outputs);
+
+    // Pin of a cell by its name in the skin (e.g. "Y", "out3")
+    static Port* pin(Node* cell, const std::string& name);
+    // Pins of splits and joins by bit
+    static Port* splitOutput(Node* split, std::size_t bit) { return split->ports[bit + 1].get(); }
+    static Port* joinInput(Node* join, std::size_t bit) { return join->ports[bit].get(); }
+
+    Edge* connect(Port* driver, Port* rider);
+
+    std::size_t cellCount() const { return cells_; }
+
+private:
+    std::string nextId(const std::string& type);
+
+    Node* module_;
+    std::mt19937_64 random_;
+    std::string prefix_;
+    std::size_t cells_ = 0;
+    std::size_t edges_ = 0;
+};
+
+// ============================================================================
+// Netlist fragments
+// ============================================================================
+
+// Each generator adds a self-contained fragment with its own module inputs
+// and outputs to the builder's module and returns the number of cells added.
+
+// Ripple carry chain as in examples/carry4whole.v, for any width: per bit a
+// carry mux and a sum xor; the DI and S buses are split into bits and the O
+// and CO buses joined
+std::size_t addCarryChain(NetlistBuilder& builder, std::size_t bits);
+
+// Balanced tree of 2:1 muxes over the given number of data inputs (some of
+// them constants); each tree level shares one select input
+std::size_t addMuxTree(NetlistBuilder& builder, std::size_t inputs);
+
+// Bank of registers x width flip-flops. Clock and reset each drive every
+// flip-flop; each bit holds its value through a write-enable mux, and a
+// read mux chain per bit feeds a joined read-data output
+std::size_t addRegisterFile(NetlistBuilder& builder, std::size_t registers, std::size_t width);
+
+// Bus split into single bits, passed through stages of per-bit gates that
+// mix in random neighbouring bits, and joined again
+std::size_t addBitBlastedBus(NetlistBuilder& builder, std::size_t width, std::size_t stages);
+
+// Chain of random gates with the given number of back edges from later to
+// earlier gates; every other loop goes through a flip-flop
+std::size_t addFeedbackLoops(NetlistBuilder& builder, std::size_t cells, std::size_t loops);
+
+// Chain of inverters from a module input to a module output; every cell
+// gets a layer of its own, the deepest graph for its size
+std::size_t addInverterChain(NetlistBuilder& builder, std::size_t cells);
+
+// ============================================================================
+// Complete graphs
+// ============================================================================
+
+// Documents with their own arena, symbol table and index, as the readers
+// return them; pass document.root to a layout provider
+io::GraphDocument carryChain(std::size_t bits, std::uint64_t seed = 1);
+io::GraphDocument muxTree(std::size_t inputs, std::uint64_t seed = 1);
+io::GraphDocument registerFile(std::size_t registers, std::size_t width, std::uint64_t seed = 1);
+io::GraphDocument bitBlastedBus(std::size_t width, std::size_t stages, std::uint64_t seed = 1);
+io::GraphDocument feedbackLoops(std::size_t cells, std::size_t loops, std::uint64_t seed = 1);
+io::GraphDocument inverterChain(std::size_t cells, std::uint64_t seed = 1);
+
+// Hierarchy of submodule instances: the top module holds `instances`
+// instances chained output to input, each containing a feedback-loop
+// fragment of about cellsPerModule cells and, below depth 1, instances of
+// its own. Lay it out with RecursiveLayoutEngine.
+io::GraphDocument hierarchicalDesign(std::size_t depth, std::size_t instances,
+                                     std::size_t cellsPerModule, std::uint64_t seed = 1);
+
+// Flat netlist of roughly the given number of cells, mixing fragments of
+// every kind above with seeded sizes
+io::GraphDocument netlist(std::size_t cells, std::uint64_t seed = 1);
+
+} // namespace testing
+} // namespace elk
@@ -32,9 +32,9 @@ std::vector<Comment> CommentProcessor::identifyComments(Node* graph) {
         bool isComment = false;
 
         // Check ID for comment pattern
-        if (child->id.find("comment") != std::string::npos ||
-            child->id.find("Comment") != std::string::npos ||
-            child->id.find("annotation") != std::string::npos) {
+        if (child->id.str().find("comment") != std::string::npos ||
+            child->id.str().find("Comment") != std::string::npos ||
+            child->id.str().find("annotation") != std::string::npos) {
             isComment = true;
         }
 
@@ -162,7 +162,7 @@ void NodeSpacingCalculator::applySpacing(
     for (const auto& cell : cells) {
         for (Node* node : cell.nodes) {
             // Store the required spacing as a property
-            node->setProperty("spacing.required", cell.requiredSpacing);
+            node->setProperty(LayoutOptions::REQUIRED_SPACING, cell.requiredSpacing);
         }
     }
 }
@@ -5,15 +5,19 @@
 #include "elk/alg/force/force_layout.h"
 #include <cmath>
 #include <algorithm>
-#include <chrono>
 
 namespace elk {
 namespace force {
 
-ForceLayoutProvider::ForceLayoutProvider() {
-    // Initialize random generator with time-based seed
-    auto seed = std::chrono::system_clock::now().time_since_epoch().count();
-    rng_.seed(static_cast<unsigned int>(seed));
+ForceLayoutProvider::ForceLayoutProvider() {}
+
+void ForceLayoutProvider::hashConfiguration(FingerprintHasher& hasher) const {
+    hasher.add(static_cast<int>(model_));
+    hasher.add(iterations_);
+    hasher.add(repulsion_);
+    hasher.add(springLength_);
+    hasher.add(temperature_);
+    hasher.add(static_cast<std::uint64_t>(randomSeed_));
 }
 
 void ForceLayoutProvider::layout(Node* graph, ProgressCallback progress) {
@@ -27,12 +31,16 @@ void ForceLayoutProvider::layout(Node* graph, ProgressCallback progress) {
 
     if (nodes.empty()) return;
 
+    // Random state belongs to this run, so concurrent runs do not interfere
+    // and the same input always gives the same layout
+    std::mt19937 random(randomSeed_);
+
     // Initialize random positions if needed
     std::uniform_real_distribution<double> dist(-100.0, 100.0);
     for (auto& node : nodes) {
         if (node.position.x == 0 && node.position.y == 0) {
-            node.position.x = dist(rng_);
-            node.position.y = dist(rng_);
+            node.position.x = dist(random);
+            node.position.y = dist(random);
         }
     }
 
@@ -42,7 +50,7 @@ void ForceLayoutProvider::layout(Node* graph, ProgressCallback progress) {
 
     for (int iter = 0; iter < iterations_; ++iter) {
         // Calculate forces
-        calculateForces(nodes, edges);
+        calculateForces(nodes, edges, random);
 
         // Update positions
         updatePositions(nodes, temp);
@@ -96,28 +104,29 @@ void ForceLayoutProvider::importGraph(Node* graph, std::vector<ForceNode>& nodes
     }
 }
 
-void ForceLayoutProvider::calculateForces(std::vector<ForceNode>& nodes, const std::vector<ForceEdge>& edges) {
+void ForceLayoutProvider::calculateForces(std::vector<ForceNode>& nodes, const std::vector<ForceEdge>& edges,
+                                          std::mt19937& random) {
     // Reset forces
     for (auto& node : nodes) {
         node.force = {0, 0};
     }
 
     // Calculate repulsive forces between all node pairs
-    calculateRepulsiveForces(nodes);
+    calculateRepulsiveForces(nodes, random);
 
     // Calculate attractive forces along edges
     calculateAttractiveForces(edges);
 }
 
-void ForceLayoutProvider::calculateRepulsiveForces(std::vector<ForceNode>& nodes) {
+void ForceLayoutProvider::calculateRepulsiveForces(std::vector<ForceNode>& nodes, std::mt19937& random) {
     for (size_t i = 0; i < nodes.size(); ++i) {
         for (size_t j = i + 1; j < nodes.size(); ++j) {
             Point force;
 
             if (model_ == ForceModel::EADES) {
-                force = calculateEadesRepulsion(nodes[i].position, nodes[j].position, repulsion_);
+                force = calculateEadesRepulsion(nodes[i].position, nodes[j].position, repulsion_, random);
             } else {
-                force = calculateFRRepulsion(nodes[i].position, nodes[j].position, springLength_);
+                force = calculateFRRepulsion(nodes[i].position, nodes[j].position, springLength_, random);
             }
 
             nodes[i].force += force;
@@ -0,0 +1,83 @@
+// Eclipse Layout Kernel - C++ Port
+// Batch layout implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/alg/layered/batch_layout.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+
+namespace elk {
+namespace layered {
+
+namespace {
+
+// Work estimate for scheduling; layout cost grows at least linearly in it
+std::size_t estimateSize(const Node& node) {
+    std::size_t size = 1 + node.ports.size() + node.edges.size();
+    for (const auto& child : node.children) {
+        size += estimateSize(*child);
+    }
+    return size;
+}
+
+} // namespace
+
+void layoutBatch(Node* const* graphs, std::size_t count,
+                 const LayeredLayoutProvider& options, unsigned threads) {
+    if (count == 0) return;
+
+    // Largest first, so that long layouts start early and the small ones
+    // fill in the gaps at the end
+    std::vector<std::pair<std::size_t, std::size_t>> order;  // (size, input index)
+    order.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        order.emplace_back(graphs[i] ? estimateSize(*graphs[i]) : 0, i);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<std::size_t> next{0};
+
+    auto worker = [&]() {
+        LayeredLayoutProvider provider(options);
+        LayoutSession session;
+        for (std::size_t k = next.fetch_add(1); k < count; k = next.fetch_add(1)) {
+            std::size_t index = order[k].second;
+            try {
+                provider.layout(graphs[index], session);
+            } catch (...) {
+                errors[index] = std::current_exception();
+            }
+        }
+    };
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t workerCount = std::min<std::size_t>(threads, count);
+
+    std::vector<std::thread> pool;
+    pool.reserve(workerCount - 1);
+    for (std::size_t i = 1; i < workerCount; i++) {
+        try {
+            pool.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break;  // Fewer workers; the ones running take the rest
+        }
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+} // namespace layered
+} // namespace elk
@@ -0,0 +1,190 @@
+// Eclipse Layout Kernel - C++ Port
+// Node promotion implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/alg/layered/intermediate/node_promotion.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace elk {
+namespace layered {
+
+bool NodePromotion::process(const std::vector<LNode*>& nodes, const LAdjacency& adjacency, bool keepWidth,
+                            int maxSweeps) {
+    nodeCount_ = static_cast<int>(nodes.size());
+    promotions_ = 0;
+    sweeps_ = 0;
+    dummies_ = 0;
+    dummiesBefore_ = dummiesAfter_ = 0;
+    if (nodeCount_ == 0) return false;
+
+    initialize(nodes, adjacency);
+    dummiesBefore_ = dummiesAfter_ = dummies_;
+
+    maxSweeps = std::max(maxSweeps, 1);
+    std::int64_t edgeCount = 0;
+    for (int node = 0; node < nodeCount_; node++) {
+        edgeCount += static_cast<std::int64_t>(adjacency.outgoing(node).size());
+    }
+    budget_ = maxSweeps * (nodeCount_ + edgeCount);
+
+    while (sweeps_ < maxSweeps && budget_ >= 0) {
+        sweeps_++;
+        std::int64_t promoted = 0;
+        for (int node : order_) {
+            if (budget_ < 0) break;
+            while (budget_ >= 0 && promote(node, adjacency, keepWidth)) promoted++;
+        }
+        promotions_ += promoted;
+        if (promoted == 0) break;
+    }
+    if (promotions_ == 0) return false;
+
+    // Remove the layers promotion emptied; edges only get shorter
+    std::vector<int>& layerIndex = moved_;
+    layerIndex.assign(width_.size(), 0);
+    for (int node = 0; node < nodeCount_; node++) {
+        layerIndex[layer_[node]] = 1;
+    }
+    int used = 0;
+    for (int& index : layerIndex) {
+        int occupied = index;
+        index = used;
+        used += occupied;
+    }
+    for (int node = 0; node < nodeCount_; node++) {
+        layer_[node] = layerIndex[layer_[node]];
+        nodes[node]->layerIndex = layer_[node];
+    }
+    dummiesAfter_ = countDummies(adjacency);
+    return true;
+}
+
+void NodePromotion::shrink() {
+    for (std::vector<int>* array : {&layer_, &inDegree_, &outDegree_, &width_, &order_, &moved_}) {
+        std::vector<int>().swap(*array);
+    }
+    std::vector<char>().swap(fixed_);
+    std::vector<std::pair<int, int>>().swap(stack_);
+}
+
+void NodePromotion::initialize(const std::vector<LNode*>& nodes, const LAdjacency& adjacency) {
+    int n = nodeCount_;
+    layer_.resize(n);
+    inDegree_.assign(n, 0);
+    outDegree_.assign(n, 0);
+    fixed_.assign(n, 0);
+    int layerCount = 0;
+    for (int node = 0; node < n; node++) {
+        layer_[node] = nodes[node]->layerIndex;
+        fixed_[node] = nodes[node]->layerConstraint != LayerConstraint::NONE;
+        layerCount = std::max(layerCount, layer_[node] + 1);
+    }
+
+    // Dummies per layer by differences over the layers each edge skips;
+    // the ends of edges that do not point forward are fixed
+    width_.assign(layerCount, 0);
+    std::vector<int>& skipping = moved_;
+    skipping.assign(layerCount + 1, 0);
+    for (int node = 0; node < n; node++) {
+        width_[layer_[node]]++;
+        for (int target : adjacency.outgoing(node)) {
+            if (target == node) continue;
+            outDegree_[node]++;
+            inDegree_[target]++;
+            int first = std::min(layer_[node], layer_[target]);
+            int last = std::max(layer_[node], layer_[target]);
+            if (layer_[target] <= layer_[node]) fixed_[node] = fixed_[target] = 1;
+            if (last - first > 1) {
+                skipping[first + 1]++;
+                skipping[last]--;
+                dummies_ += last - first - 1;
+            }
+        }
+    }
+    maxWidth_ = 0;
+    int crossing = 0;
+    for (int layer = 0; layer < layerCount; layer++) {
+        crossing += skipping[layer];
+        width_[layer] += crossing;
+        maxWidth_ = std::max(maxWidth_, width_[layer]);
+    }
+
+    // Movable nodes with incoming edges, in layer order
+    std::vector<int>& start = skipping;
+    start.assign(layerCount + 1, 0);
+    for (int node = 0; node < n; node++) {
+        if (inDegree_[node] > 0 && !fixed_[node]) start[layer_[node] + 1]++;
+    }
+    for (int layer = 0; layer < layerCount; layer++) {
+        start[layer + 1] += start[layer];
+    }
+    order_.resize(start[layerCount]);
+    for (int node = 0; node < n; node++) {
+        if (inDegree_[node] > 0 && !fixed_[node]) order_[start[layer_[node]]++] = node;
+    }
+}
+
+bool NodePromotion::promote(int node, const LAdjacency& adjacency, bool keepWidth) {
+    // Move the node and every predecessor it reaches back by one layer,
+    // then keep the moves only if they saved dummies
+    moved_.clear();
+    stack_.clear();
+    std::int64_t dummies = dummies_;
+    bool valid = move(node, adjacency, keepWidth);
+    while (valid && budget_ >= 0 && !stack_.empty()) {
+        std::pair<int, int> entry = stack_.back();
+        stack_.pop_back();
+        if (layer_[entry.first] >= entry.second) valid = move(entry.first, adjacency, keepWidth);
+    }
+    if (valid && budget_ >= 0 && dummies_ < dummies) return true;
+    undoMoves();
+    return false;
+}
+
+bool NodePromotion::move(int node, const LAdjacency& adjacency, bool keepWidth) {
+    int from = layer_[node];
+    int to = from - 1;
+    if (fixed_[node] || to < 0) return false;
+
+    // Its incoming edges get shorter and its outgoing edges longer
+    moved_.push_back(node);
+    layer_[node] = to;
+    dummies_ += outDegree_[node] - inDegree_[node];
+    width_[from] += outDegree_[node] - 1;
+    width_[to] += 1 - inDegree_[node];
+    budget_ -= 1 + inDegree_[node];
+    if (keepWidth && (width_[from] > maxWidth_ || width_[to] > maxWidth_)) return false;
+
+    for (int source : adjacency.incoming(node)) {
+        if (source != node && layer_[source] == to) stack_.emplace_back(source, to);
+    }
+    return true;
+}
+
+void NodePromotion::undoMoves() {
+    while (!moved_.empty()) {
+        int node = moved_.back();
+        moved_.pop_back();
+        int to = layer_[node];
+        int from = to + 1;
+        layer_[node] = from;
+        dummies_ -= outDegree_[node] - inDegree_[node];
+        width_[from] -= outDegree_[node] - 1;
+        width_[to] -= 1 - inDegree_[node];
+    }
+}
+
+std::int64_t NodePromotion::countDummies(const LAdjacency& adjacency) const {
+    std::int64_t dummies = 0;
+    for (int node = 0; node < nodeCount_; node++) {
+        for (int target : adjacency.outgoing(node)) {
+            int span = std::abs(layer_[target] - layer_[node]);
+            if (span > 1) dummies += span - 1;
+        }
+    }
+    return dummies;
+}
+
+} // namespace layered
+} // namespace elk
@@ -4,36 +4,104 @@
 
 #include "elk/alg/layered/layered_layout.h"
 #include "elk/alg/layered/p5edges/orthogonal_edge_router.h"
+#include "elk/core/trace.h"
 #include <algorithm>
+#include <functional>
+#include <map>
 #include <queue>
 #include <limits>
-#include <iostream>
 
 namespace elk {
 namespace layered {
 
+namespace {
+
+// Layering strategy for graph: its elk.layered.layering.strategy option if
+// set to a known value, otherwise the configured one
+LayeringStrategy layeringStrategyFor(const Node* graph, LayeringStrategy configured) {
+    if (!graph->hasProperty(LayoutOptions::LAYERING_STRATEGY)) return configured;
+    std::string strategy = graph->getProperty(LayoutOptions::LAYERING_STRATEGY);
+    if (strategy == "LONGEST_PATH") return LayeringStrategy::LONGEST_PATH;
+    if (strategy == "NETWORK_SIMPLEX") return LayeringStrategy::NETWORK_SIMPLEX;
+    if (strategy == "COFFMAN_GRAHAM") return LayeringStrategy::COFFMAN_GRAHAM;
+    return configured;
+}
+
+// Coffman-Graham layer bound for graph: its
+// elk.layered.layering.coffmanGraham.layerBound option if set to a positive
+// number, otherwise the configured one
+int layerBoundFor(const Node* graph, int configured) {
+    double bound = graph->getProperty(LayoutOptions::COFFMAN_GRAHAM_LAYER_BOUND);
+    if (bound < 1) return configured;
+    return bound < std::numeric_limits<int>::max() ? static_cast<int>(bound) : std::numeric_limits<int>::max();
+}
+
+// Node promotion strategy for graph: its
+// elk.layered.layering.nodePromotion.strategy option if set to a known
+// value, otherwise the configured one
+NodePromotionStrategy nodePromotionFor(const Node* graph, NodePromotionStrategy configured) {
+    if (!graph->hasProperty(LayoutOptions::NODE_PROMOTION_STRATEGY)) return configured;
+    std::string strategy = graph->getProperty(LayoutOptions::NODE_PROMOTION_STRATEGY);
+    if (strategy == "NONE") return NodePromotionStrategy::NONE;
+    if (strategy == "NIKOLOV") return NodePromotionStrategy::NIKOLOV;
+    if (strategy == "NO_BOUNDARY") return NodePromotionStrategy::NO_BOUNDARY;
+    return configured;
+}
+
+// Most node promotion sweeps for graph: its
+// elk.layered.layering.nodePromotion.maxIterations option if set to a
+// positive number, otherwise the configured one
+int promotionIterationsFor(const Node* graph, int configured) {
+    double iterations = graph->getProperty(LayoutOptions::NODE_PROMOTION_MAX_ITERATIONS);
+    if (iterations < 1) return configured;
+    return iterations < std::numeric_limits<int>::max() ? static_cast<int>(iterations)
+                                                        : std::numeric_limits<int>::max();
+}
+
+} // namespace
+
 LayeredLayoutProvider::LayeredLayoutProvider() {}
 
+void LayeredLayoutProvider::hashConfiguration(FingerprintHasher& hasher) const {
+    hasher.add(static_cast<int>(direction_));
+    hasher.add(nodeSpacing_);
+    hasher.add(layerSpacing_);
+    hasher.add(static_cast<int>(layeringStrategy_));
+    hasher.add(layerBound_);
+    hasher.add(static_cast<int>(nodePromotion_));
+    hasher.add(promotionIterations_);
+    hasher.add(static_cast<int>(crossingStrategy_));
+    hasher.add(static_cast<int>(nodeStrategy_));
+    hasher.add(mergeLongEdges_);
+}
+
 void LayeredLayoutProvider::layout(Node* graph, ProgressCallback progress) {
+    LayoutSession session;
+    layout(graph, session, progress);
+}
+
+void LayeredLayoutProvider::layout(Node* graph, LayoutSession& session, ProgressCallback progress) {
     if (!graph) return;
 
-    std::vector<LNode*> nodes;
-    std::vector<LEdge*> edges;
-    std::vector<Layer> layers;
+    session.reset();
+    session.layoutCount_++;
+    std::vector<LNode*>& nodes = session.nodes;
+    std::vector<LEdge*>& edges = session.edges;
 
     // Phase 1: Import
     if (progress) progress("Importing graph", 0.0);
-    importGraph(graph, nodes, edges);
+    importGraph(graph, session);
 
     if (nodes.empty()) return;
 
     // Phase 2: Break cycles
     if (progress) progress("Breaking cycles", 0.15);
-    breakCycles(nodes, edges);
+    breakCycles(session);
 
     // Phase 3: Assign layers
     if (progress) progress("Assigning layers", 0.30);
-    assignLayers(nodes, layers);
+    assignLayers(graph, session);
+    promoteNodes(graph, session);
 
     // Phase 3.5: Calculate node margins (for ports extending beyond bounds)
     if (progress) progress("Calculating margins", 0.35);
@@ -41,48 +109,60 @@ void LayeredLayoutProvider::layout(Node* graph, ProgressCallback progress) {
 
     // Phase 4: Insert dummy nodes
     if (progress) progress("Processing long edges", 0.45);
-    insertDummyNodes(nodes, edges, layers);
+    insertDummyNodes(session);
 
     // Phase 5: Minimize crossings
     if (progress) progress("Minimizing crossings", 0.60);
-    minimizeCrossings(layers);
+    minimizeCrossings(session);
+    if (ELK_TRACE_COUNTING()) {
+        std::int64_t crossings = 0;
+        for (size_t i = 0; i + 1 < session.layers.size(); ++i) {
+            crossings += countCrossings(session.layers[i], session.layers[i + 1], session);
+        }
+        ELK_TRACE_COUNT(CROSSINGS, crossings);
+    }
 
     // Phase 6: Assign coordinates
     if (progress) progress("Placing nodes", 0.75);
-    assignCoordinates(layers);
+    assignCoordinates(session);
 
     // Phase 7: Edge routing is now done inside assignCoordinates() via OrthogonalEdgeRouter
     // No need to call routeEdges() separately - it would clear the bend points!
 
-    // Apply back to original graph
-    applyLayout(nodes, edges);
+    {
+        ELK_TRACE_PHASE("apply");
 
-    // Calculate and set graph size
-    calculateGraphSize(graph, nodes);
+        // Apply back to original graph
+        applyLayout(nodes, edges);
 
-    // Cleanup
-    cleanup(nodes, edges);
+        // Calculate and set graph size
+        calculateGraphSize(graph, nodes);
+
+        // Cleanup
+        cleanup(session);
+    }
 
     if (progress) progress("Layout complete", 1.0);
 }
 
-void LayeredLayoutProvider::importGraph(Node* graph, std::vector<LNode*>& nodes, std::vector<LEdge*>& edges) {
-    std::unordered_map<Node*, LNode*> nodeMap;
-    std::unordered_map<Port*, LPort*> portMap;
+void LayeredLayoutProvider::importGraph(Node* graph, LayoutSession& session) {
+    std::vector<std::pair<Port*, LPort*>>& portMap = session.portMap;
 
-    std::cerr << "\n=== IMPORT GRAPH ===\n";
-    std::cerr << "Graph has " << graph->children.size() << " children, " << graph->edges.size() << " edges\n";
+    ELK_TRACE_PHASE("import");
+    ELK_TRACE_INFO("\n=== IMPORT GRAPH ===\n");
+    ELK_TRACE_INFO("Graph has " << graph->children.size() << " children, " << graph->edges.size() << " edges\n");
 
     // Create LNode for each child
     for (auto& child : graph->children) {
-        LNode* lnode = new LNode();
+        LNode* lnode = session.graph.addNode();
         lnode->originalNode = child.get();
+        lnode->id = child->id;
         lnode->size = child->size;
         lnode->position = child->position;
 
         // Read layer constraint property if set
-        if (child->hasProperty("org.eclipse.elk.layered.layering.layerConstraint")) {
-            std::string constraint = child->getProperty<std::string>("org.eclipse.elk.layered.layering.layerConstraint");
+        if (child->hasProperty(LayoutOptions::LAYER_CONSTRAINT)) {
+            std::string constraint = child->getProperty(LayoutOptions::LAYER_CONSTRAINT);
             if (constraint == "FIRST") {
                 lnode->layerConstraint = LayerConstraint::FIRST;
             } else if (constraint == "FIRST_SEPARATE") {
@@ -94,20 +174,17 @@ void LayeredLayoutProvider::importGraph(Node* graph, std::vector<LNode*>& nodes,
             }
         }
 
-        nodes.push_back(lnode);
-        nodeMap[child.get()] = lnode;
-
-        std::cerr << "  Node " << child->id << " has " << child->ports.size() << " ports\n";
+        ELK_TRACE_DEBUG("  Node " << child->id << " has " << child->ports.size() << " ports\n");
 
         // Create LPorts for each port
         for (auto& port : child->ports) {
-            LPort* lport = new LPort();
+            LPort* lport = session.graph.addPort(lnode);
             lport->originalPort = port.get();
+            lport->id = port->id;
             lport->side = port->side;
             lport->size = port->size;
             lport->position = port->position;
-            lport->node = lnode;
-            std::cerr << "    Port " << port->id << " side=" << (int)port->side << " -> LPort side=" << (int)lport->side << "\n";
+            ELK_TRACE_DEBUG("    Port " << port->id << " side=" << (int)port->side << " -> LPort side=" << (int)lport->side << "\n");
 
             // Copy port labels
             for (const auto& label : port->labels) {
@@ -119,37 +196,55 @@ void LayeredLayoutProvider::importGraph(Node* graph, std::vector<LNode*>& nodes,
             }
 
             lnode->ports.push_back(lport);
-            portMap[port.get()] = lport;
+            portMap.emplace_back(port.get(), lport);
         }
     }
 
-    // Create LEdge for each edge - edges connect ports, not nodes!
+    // Sort the port pairs so that edges find their ports by binary search
+    auto byPort = [](const std::pair<Port*, LPort*>& a, const std::pair<Port*, LPort*>& b) {
+        return std::less<Port*>()(a.first, b.first);
+    };
+    std::sort(portMap.begin(), portMap.end(), byPort);
+    auto findPort = [&portMap, &byPort](Port* port) -> LPort* {
+        auto it = std::lower_bound(portMap.begin(), portMap.end(), std::make_pair(port, nullptr), byPort);
+        return it != portMap.end() && it->first == port ? it->second : nullptr;
+    };
+
+    // Create LEdge for each edge - edges connect ports, not nodes! A net with
+    // several terminals becomes one LEdge per source/target pair, all sharing
+    // the original edge; dummy insertion threads them through one chain.
     int edgeCount = 0;
     for (auto& edge : graph->edges) {
         if (edge->sourcePorts.empty() || edge->targetPorts.empty()) {
-            std::cerr << "  Edge skipped (no ports)\n";
+            ELK_TRACE_WARN("  Edge skipped (no ports)\n");
             continue;
         }
 
-        Port* srcPort = edge->sourcePorts[0];
-        Port* tgtPort = edge->targetPorts[0];
-
-        auto srcIt = portMap.find(srcPort);
-        auto tgtIt = portMap.find(tgtPort);
-
-        if (srcIt != portMap.end() && tgtIt != portMap.end()) {
-            LEdge* ledge = new LEdge();
-            ledge->setSource(srcIt->second);  // Use setter to maintain port edge lists
-            ledge->setTarget(tgtIt->second);
-            ledge->originalEdge = edge.get();
-            edges.push_back(ledge);
-            edgeCount++;
-        } else {
-            if (srcIt == portMap.end()) std::cerr << "  Edge skipped (source port not found)\n";
-            if (tgtIt == portMap.end()) std::cerr << "  Edge skipped (target port not found)\n";
+        for (Port* srcPort : edge->sourcePorts) {
+            LPort* source = findPort(srcPort);
+            if (source == nullptr) {
+                ELK_TRACE_WARN("  Edge skipped (source port not found)\n");
+                continue;
+            }
+            for (Port* tgtPort : edge->targetPorts) {
+                LPort* target = findPort(tgtPort);
+                if (target == nullptr) {
+                    ELK_TRACE_WARN("  Edge skipped (target port not found)\n");
+                    continue;
+                }
+                LEdge* ledge = session.graph.addEdge();
+                ledge->setSource(source);  // Use setter to maintain port edge lists
+                ledge->setTarget(target);
+                ledge->originalEdge = edge.get();
+                ledge->id = edge->id;
+                edgeCount++;
+            }
         }
     }
-    std::cerr << "Created " << edgeCount << " edges\n";
+    ELK_TRACE_INFO("Created " << edgeCount << " edges\n");
+    ELK_TRACE_COUNT(NODE_ALLOCATIONS, session.nodes.size());
+    ELK_TRACE_COUNT(PORT_ALLOCATIONS, portMap.size());
+    ELK_TRACE_COUNT(EDGE_ALLOCATIONS, edgeCount);
 
     // Set port types based on edge connectivity (matching Java ELK's PortType)
     for (auto& pair : portMap) {
@@ -167,158 +262,170 @@ void LayeredLayoutProvider::importGraph(Node* graph, std::vector<LNode*>& nodes,
             // No edges connected
             lport->portType = PortType::UNDEFINED;
         }
-        std::cerr << "  Port " << (lport->originalPort ? lport->originalPort->id : "?")
-                  << " type=" << (int)lport->portType
-                  << " side=" << (int)lport->side
-                  << " incoming=" << lport->incomingEdges.size()
-                  << " outgoing=" << lport->outgoingEdges.size() << "\n";
+        ELK_TRACE_DEBUG("  Port " << (lport->originalPort ? lport->originalPort->id.str() : "?")
+                        << " type=" << (int)lport->portType
+                        << " side=" << (int)lport->side
+                        << " incoming=" << lport->incomingEdges.size()
+                        << " outgoing=" << lport->outgoingEdges.size() << "\n");
     }
 
     // Debug: Check edge connectivity for a few nodes
-    for (auto& child : graph->children) {
-        auto it = nodeMap.find(child.get());
-        if (it != nodeMap.end()) {
-            LNode* lnode = it->second;
-            auto incoming = lnode->getIncomingEdges();
-            auto outgoing = lnode->getOutgoingEdges();
-            if ((incoming.size() > 0 || outgoing.size() > 0) && child->id.find("$sub") != std::string::npos) {
-                std::cerr << "  " << child->id << ": in=" << incoming.size() << " out=" << outgoing.size() << "\n";
-                for (LPort* port : lnode->ports) {
-                    std::cerr << "    Port (side=" << (int)port->side << "): in=" << port->getIncomingEdges().size()
-                              << " out=" << port->getOutgoingEdges().size() << "\n";
-                }
+    if (!ELK_TRACE_ENABLED(trace::Level::DEBUG)) return;
+    for (LNode* lnode : session.nodes) {
+        Node* child = lnode->originalNode;
+        auto incoming = lnode->getIncomingEdges();
+        auto outgoing = lnode->getOutgoingEdges();
+        if ((incoming.size() > 0 || outgoing.size() > 0) && child->id.str().find("$sub") != std::string::npos) {
+            ELK_TRACE_DEBUG("  " << child->id << ": in=" << incoming.size() << " out=" << outgoing.size() << "\n");
+            for (LPort* port : lnode->ports) {
+                ELK_TRACE_DEBUG("    Port (side=" << (int)port->side << "): in=" << port->getIncomingEdges().size()
+                                << " out=" << port->getOutgoingEdges().size() << "\n");
             }
         }
     }
 }
 
-void LayeredLayoutProvider::breakCycles(std::vector<LNode*>& nodes, std::vector<LEdge*>& edges) {
-    std::cerr << "\n=== BREAK CYCLES (Greedy Algorithm) ===\n";
+void LayeredLayoutProvider::breakCycles(LayoutSession& session) {
+    ELK_TRACE_PHASE("cycle breaking");
+    ELK_TRACE_INFO("\n=== BREAK CYCLES (Greedy Algorithm) ===\n");
 
     // Greedy cycle breaking algorithm based on Java ELK's GreedyCycleBreaker
-    // Assigns ordering marks to nodes, then reverses edges that point backwards
+    // Assigns ordering marks to nodes, then reverses edges that point backwards.
+    // Nodes not yet marked wait in buckets by outflow (outdegree minus
+    // indegree), so picking one of maximum outflow when the sources and
+    // sinks run out, and moving a neighbour whose degree dropped, take
+    // constant time: the whole run is linear in nodes and edges.
 
+    std::vector<LNode*>& nodes = session.nodes;
     int nodeCount = nodes.size();
-    std::vector<int> indeg(nodeCount, 0);
-    std::vector<int> outdeg(nodeCount, 0);
-    std::vector<int> mark(nodeCount, 0);
-    std::deque<LNode*> sources;
-    std::deque<LNode*> sinks;
-    std::unordered_map<LNode*, int> nodeIndex;
-
-    // Assign indices and calculate degrees
+    LAdjacency& adjacency = session.adjacency;
+    adjacency.build(nodes);
+    std::vector<int>& indeg = session.indegree;
+    std::vector<int>& outdeg = session.outdegree;
+    std::vector<int>& mark = session.mark;
+    std::vector<int>& sources = session.sources;
+    std::vector<int>& sinks = session.sinks;
+    indeg.assign(nodeCount, 0);
+    outdeg.assign(nodeCount, 0);
+    mark.assign(nodeCount, 0);
+
+    // Calculate degrees, ignoring self-loops; every edge counts once, as
+    // edge priorities are not supported
+    int maxIndeg = 0;
+    int maxOutdeg = 0;
     for (int i = 0; i < nodeCount; i++) {
-        nodeIndex[nodes[i]] = i;
-
-        for (LPort* port : nodes[i]->getPorts()) {
-            for (LEdge* edge : port->incomingEdges) {
-                LNode* sourceNode = edge->getSource()->getNode();
-                if (sourceNode != nodes[i]) {  // ignore self-loops
-                    // Get priority from edge properties (default 0)
-                    int priority = 0;  // TODO: read from edge properties if available
-                    indeg[i] += priority > 0 ? priority + 1 : 1;
-                }
-            }
-
-            for (LEdge* edge : port->outgoingEdges) {
-                LNode* targetNode = edge->getTarget()->getNode();
-                if (targetNode != nodes[i]) {  // ignore self-loops
-                    int priority = 0;  // TODO: read from edge properties if available
-                    outdeg[i] += priority > 0 ? priority + 1 : 1;
-                }
-            }
+        for (int source : adjacency.incoming(i)) {
+            if (source != i) indeg[i]++;
+        }
+        for (int target : adjacency.outgoing(i)) {
+            if (target != i) outdeg[i]++;
         }
+        maxIndeg = std::max(maxIndeg, indeg[i]);
+        maxOutdeg = std::max(maxOutdeg, outdeg[i]);
 
         // Collect initial sources and sinks
         if (outdeg[i] == 0) {
-            sinks.push_back(nodes[i]);
+            sinks.push_back(i);
         } else if (indeg[i] == 0) {
-            sources.push_back(nodes[i]);
+            sources.push_back(i);
         }
     }
 
-    std::cerr << "Initial: " << sources.size() << " sources, " << sinks.size() << " sinks\n";
+    ELK_TRACE_INFO("Initial: " << sources.size() << " sources, " << sinks.size() << " sinks\n");
+
+    // Outflow buckets, doubly linked through the nodes. A node joins the
+    // front of its bucket, so ties go to the neighbour of the latest marked
+    // nodes, and before any node is marked to the lowest index.
+    std::vector<int>& bucketFirst = session.bucketFirst;
+    std::vector<int>& bucketLast = session.bucketLast;
+    std::vector<int>& bucketNext = session.bucketNext;
+    std::vector<int>& bucketPrevious = session.bucketPrevious;
+    bucketFirst.assign(maxIndeg + maxOutdeg + 1, -1);
+    bucketLast.assign(maxIndeg + maxOutdeg + 1, -1);
+    bucketNext.assign(nodeCount, -1);
+    bucketPrevious.assign(nodeCount, -1);
+    int topBucket = 0;  // No bucket above it holds a node
+
+    auto link = [&](int i) {
+        int bucket = outdeg[i] - indeg[i] + maxIndeg;
+        bucketNext[i] = bucketFirst[bucket];
+        bucketPrevious[i] = -1;
+        if (bucketFirst[bucket] >= 0) {
+            bucketPrevious[bucketFirst[bucket]] = i;
+        } else {
+            bucketLast[bucket] = i;
+        }
+        bucketFirst[bucket] = i;
+        topBucket = std::max(topBucket, bucket);
+    };
+    auto unlink = [&](int i) {
+        int bucket = outdeg[i] - indeg[i] + maxIndeg;
+        if (bucketPrevious[i] >= 0) {
+            bucketNext[bucketPrevious[i]] = bucketNext[i];
+        } else {
+            bucketFirst[bucket] = bucketNext[i];
+        }
+        if (bucketNext[i] >= 0) {
+            bucketPrevious[bucketNext[i]] = bucketPrevious[i];
+        } else {
+            bucketLast[bucket] = bucketPrevious[i];
+        }
+    };
+    for (int i = nodeCount - 1; i >= 0; i--) {
+        link(i);
+    }
 
     // Assign marks to nodes
     int nextRight = -1;
     int nextLeft = 1;
     int unprocessedCount = nodeCount;
 
-    auto updateNeighbors = [&](LNode* node) {
-        for (LPort* port : node->getPorts()) {
-            // Check both incoming and outgoing edges
-            for (LEdge* edge : port->incomingEdges) {
-                LNode* endpoint = edge->getSource()->getNode();
-                if (node == endpoint) continue;  // exclude self-loops
-
-                int priority = 0;  // TODO: read from properties
-                int idx = nodeIndex[endpoint];
-
-                if (mark[idx] == 0) {  // unprocessed node
-                    outdeg[idx] -= priority + 1;
-                    if (outdeg[idx] <= 0 && indeg[idx] > 0) {
-                        sinks.push_back(endpoint);
-                    }
-                }
+    auto markNode = [&](int i, int value) {
+        mark[i] = value;
+        unlink(i);
+        unprocessedCount--;
+
+        // Check both incoming and outgoing edges
+        for (int idx : adjacency.incoming(i)) {
+            if (idx == i || mark[idx] != 0) continue;  // self-loop or processed node
+            unlink(idx);
+            outdeg[idx]--;
+            link(idx);
+            if (outdeg[idx] <= 0 && indeg[idx] > 0) {
+                sinks.push_back(idx);
             }
+        }
 
-            for (LEdge* edge : port->outgoingEdges) {
-                LNode* endpoint = edge->getTarget()->getNode();
-                if (node == endpoint) continue;  // exclude self-loops
-
-                int priority = 0;  // TODO: read from properties
-                int idx = nodeIndex[endpoint];
-
-                if (mark[idx] == 0) {  // unprocessed node
-                    indeg[idx] -= priority + 1;
-                    if (indeg[idx] <= 0 && outdeg[idx] > 0) {
-                        sources.push_back(endpoint);
-                    }
-                }
+        for (int idx : adjacency.outgoing(i)) {
+            if (idx == i || mark[idx] != 0) continue;  // self-loop or processed node
+            unlink(idx);
+            indeg[idx]--;
+            link(idx);
+            if (indeg[idx] <= 0 && outdeg[idx] > 0) {
+                sources.push_back(idx);
             }
         }
     };
 
+    std::size_t nextSink = 0;
+    std::size_t nextSource = 0;
     while (unprocessedCount > 0) {
         // Process sinks (place to the right)
-        while (!sinks.empty()) {
-            LNode* sink = sinks.front();
-            sinks.pop_front();
-            mark[nodeIndex[sink]] = nextRight--;
-            updateNeighbors(sink);
-            unprocessedCount--;
+        while (nextSink < sinks.size()) {
+            markNode(sinks[nextSink++], nextRight--);
         }
 
         // Process sources (place to the left)
-        while (!sources.empty()) {
-            LNode* source = sources.front();
-            sources.pop_front();
-            mark[nodeIndex[source]] = nextLeft++;
-            updateNeighbors(source);
-            unprocessedCount--;
+        while (nextSource < sources.size()) {
+            markNode(sources[nextSource++], nextLeft++);
         }
 
-        // Process remaining nodes with maximum outflow
+        // Process a remaining node with maximum outflow
         if (unprocessedCount > 0) {
-            int maxOutflow = INT_MIN;
-            LNode* maxNode = nullptr;
-
-            for (LNode* node : nodes) {
-                int idx = nodeIndex[node];
-                if (mark[idx] == 0) {
-                    int outflow = outdeg[idx] - indeg[idx];
-                    if (outflow > maxOutflow) {
-                        maxOutflow = outflow;
-                        maxNode = node;
-                    }
-                }
-            }
-
-            if (maxNode) {
-                mark[nodeIndex[maxNode]] = nextLeft++;
-                updateNeighbors(maxNode);
-                unprocessedCount--;
+            while (bucketFirst[topBucket] < 0) {
+                topBucket--;
             }
+            markNode(bucketFirst[topBucket], nextLeft++);
         }
     }
 
@@ -331,65 +438,70 @@ void LayeredLayoutProvider::breakCycles(std::vector<LNode*>& nodes, std::vector<
     }
 
     // Debug: print marks
-    std::cerr << "Node ordering marks:\n";
+    ELK_TRACE_DEBUG("Node ordering marks:\n");
     for (int i = 0; i < std::min(10, nodeCount); i++) {
-        std::cerr << "  " << (nodes[i]->originalNode ? nodes[i]->originalNode->id : "?")
-                  << " mark=" << mark[i] << "\n";
+        ELK_TRACE_DEBUG("  " << (nodes[i]->originalNode ? nodes[i]->originalNode->id.str() : "?")
+                        << " mark=" << mark[i] << "\n");
     }
 
-    // Reverse edges that point left (source mark > target mark)
-    int reversedCount = 0;
-    for (LNode* node : nodes) {
-        // Copy port list to avoid modification during iteration
-        std::vector<LPort*> portsCopy(node->getPorts().begin(), node->getPorts().end());
-
-        for (LPort* port : portsCopy) {
-            // Copy edge list to avoid modification during iteration
-            std::vector<LEdge*> outgoingCopy(port->outgoingEdges.begin(), port->outgoingEdges.end());
-
-            for (LEdge* edge : outgoingCopy) {
-                LNode* targetNode = edge->getTarget()->getNode();
-                int nodeIdx = nodeIndex[node];
-                int targetIdx = nodeIndex[targetNode];
-
-                if (mark[nodeIdx] > mark[targetIdx]) {
-                    // This edge points backwards, reverse it
-                    LPort* oldSource = edge->source;
-                    LPort* oldTarget = edge->target;
-
-                    std::cerr << "  Reversing: "
-                              << (oldSource->getNode()->originalNode ? oldSource->getNode()->originalNode->id : "?")
-                              << " (mark=" << mark[nodeIdx] << ") -> "
-                              << (oldTarget->getNode()->originalNode ? oldTarget->getNode()->originalNode->id : "?")
-                              << " (mark=" << mark[targetIdx] << ")\n";
-
-                    // Remove from old port lists
-                    auto& srcOut = oldSource->outgoingEdges;
-                    srcOut.erase(std::remove(srcOut.begin(), srcOut.end(), edge), srcOut.end());
-
-                    auto& tgtIn = oldTarget->incomingEdges;
-                    tgtIn.erase(std::remove(tgtIn.begin(), tgtIn.end(), edge), tgtIn.end());
-
-                    // Swap source and target
-                    edge->source = oldTarget;
-                    edge->target = oldSource;
-                    edge->reversed = true;
-
-                    // Add to new port lists
-                    oldTarget->outgoingEdges.push_back(edge);
-                    oldSource->incomingEdges.push_back(edge);
-
-                    reversedCount++;
-                }
+    // Flag the edges that point left (source mark > target mark). The rows
+    // are a snapshot, so every edge is looked at once.
+    std::vector<LEdge*>& reversed = session.reversedEdges;
+    for (int nodeIdx = 0; nodeIdx < nodeCount; nodeIdx++) {
+        LAdjacency::Row targets = adjacency.outgoing(nodeIdx);
+        LEdge* const* outgoing = adjacency.outgoingEdges(nodeIdx);
+        for (std::size_t k = 0; k < targets.size(); k++) {
+            int targetIdx = targets.first[k];
+            if (mark[nodeIdx] > mark[targetIdx]) {
+                LEdge* edge = outgoing[k];
+                ELK_TRACE_DEBUG("  Reversing: "
+                                << (nodes[nodeIdx]->originalNode ? nodes[nodeIdx]->originalNode->id.str() : "?")
+                                << " (mark=" << mark[nodeIdx] << ") -> "
+                                << (nodes[targetIdx]->originalNode ? nodes[targetIdx]->originalNode->id.str() : "?")
+                                << " (mark=" << mark[targetIdx] << ")\n");
+                edge->reversed = true;
+                reversed.push_back(edge);
+            }
+        }
+    }
+
+    // Take them out of the port lists with one pass over each node they
+    // touch, then swap their ends and append them to the lists of their
+    // new ports in the order they were found
+    std::vector<int>& unlisted = indeg;
+    unlisted.assign(nodeCount, 0);
+    auto isReversed = [](const LEdge* edge) { return edge->reversed; };
+    for (LEdge* edge : reversed) {
+        for (LPort* end : {edge->source, edge->target}) {
+            int node = end->getNode()->graphIndex;
+            if (unlisted[node]) continue;
+            unlisted[node] = 1;
+            for (LPort* port : nodes[node]->ports) {
+                auto& outgoing = port->outgoingEdges;
+                auto& incoming = port->incomingEdges;
+                outgoing.erase(std::remove_if(outgoing.begin(), outgoing.end(), isReversed), outgoing.end());
+                incoming.erase(std::remove_if(incoming.begin(), incoming.end(), isReversed), incoming.end());
             }
         }
     }
+    for (LEdge* edge : reversed) {
+        std::swap(edge->source, edge->target);
+        edge->source->outgoingEdges.push_back(edge);
+        edge->target->incomingEdges.push_back(edge);
+    }
 
-    std::cerr << "Reversed " << reversedCount << " edges to break cycles\n";
+    int reversedCount = static_cast<int>(reversed.size());
+    if (reversedCount > 0) {
+        adjacency.build(nodes);
+    }
+
+    ELK_TRACE_INFO("Reversed " << reversedCount << " edges to break cycles\n");
+    ELK_TRACE_COUNT(REVERSED_EDGES, reversedCount);
 }
 
 void LayeredLayoutProvider::calculateNodeMargins(std::vector<LNode*>& nodes) {
-    std::cerr << "\n=== CALCULATE NODE MARGINS ===\n";
+    ELK_TRACE_PHASE("margins");
+    ELK_TRACE_INFO("\n=== CALCULATE NODE MARGINS ===\n");
 
     int nodesWithMargins = 0;
     double maxMarginLeft = 0.0, maxMarginRight = 0.0;
@@ -462,19 +574,37 @@ void LayeredLayoutProvider::calculateNodeMargins(std::vector<LNode*>& nodes) {
             maxMarginRight = std::max(maxMarginRight, rightExtent);
 
             if (leftExtent > 10 || rightExtent > 10) {
-                std::cerr << "  Node " << (node->originalNode ? node->originalNode->id : "?")
-                          << " margins: L=" << leftExtent << " R=" << rightExtent
-                          << " nodeWidth=" << node->size.width << "\n";
+                ELK_TRACE_DEBUG("  Node " << (node->originalNode ? node->originalNode->id.str() : "?")
+                                << " margins: L=" << leftExtent << " R=" << rightExtent
+                                << " nodeWidth=" << node->size.width << "\n");
             }
         }
     }
 
-    std::cerr << "Nodes with calculated margins: " << nodesWithMargins << " / " << nodes.size() << "\n";
-    std::cerr << "Max margins: left=" << maxMarginLeft << ", right=" << maxMarginRight << "\n";
+    ELK_TRACE_INFO("Nodes with calculated margins: " << nodesWithMargins << " / " << nodes.size() << "\n");
+    ELK_TRACE_INFO("Max margins: left=" << maxMarginLeft << ", right=" << maxMarginRight << "\n");
 }
 
-void LayeredLayoutProvider::assignLayers(std::vector<LNode*>& nodes, std::vector<Layer>& layers) {
-    std::vector<LNode*> sorted = assignLayersLongestPath(nodes);
+void LayeredLayoutProvider::assignLayers(const Node* graph, LayoutSession& session) {
+    ELK_TRACE_PHASE("layering");
+    std::vector<LNode*>& nodes = session.nodes;
+    std::vector<Layer>& layers = session.layers;
+    switch (layeringStrategyFor(graph, layeringStrategy_)) {
+    case LayeringStrategy::NETWORK_SIMPLEX:
+        ELK_TRACE_INFO("\n=== NETWORK SIMPLEX LAYERING ===\n");
+        session.networkSimplex.process(nodes, session.adjacency);
+        ELK_TRACE_INFO("Tree edge exchanges: " << session.networkSimplex.exchangeCount() << "\n");
+        break;
+    case LayeringStrategy::COFFMAN_GRAHAM: {
+        int bound = layerBoundFor(graph, layerBound_);
+        ELK_TRACE_INFO("\n=== COFFMAN-GRAHAM LAYERING (bound " << bound << ") ===\n");
+        session.coffmanGraham.process(nodes, session.adjacency, bound);
+        break;
+    }
+    default:
+        assignLayersLongestPath(session);
+        break;
+    }
 
     // Calculate max layer from nodes
     int maxLayer = 0;
@@ -482,119 +612,139 @@ void LayeredLayoutProvider::assignLayers(std::vector<LNode*>& nodes, std::vector
         maxLayer = std::max(maxLayer, node->layerIndex);
     }
 
-    // Create layer structures
-    layers.resize(maxLayer + 1);
-
-    // Assign nodes to layers in topological order (to match Java behavior)
-    for (LNode* node : sorted) {
-        if (node->layerIndex >= 0 && node->layerIndex <= maxLayer) {
-            layers[node->layerIndex].nodes.push_back(node);
+    // Enforce layer constraints (FIRST, LAST, etc.)
+    ELK_TRACE_DEBUG("\nEnforcing layer constraints:\n");
+    for (LNode* node : nodes) {
+        if (node->layerConstraint == LayerConstraint::FIRST ||
+            node->layerConstraint == LayerConstraint::FIRST_SEPARATE) {
+            // Force to leftmost layer (layer 0)
+            node->layerIndex = 0;
+            if (node->originalNode) {
+                ELK_TRACE_DEBUG("  " << node->originalNode->id << " -> FIRST (layer 0)\n");
+            }
+        } else if (node->layerConstraint == LayerConstraint::LAST ||
+                   node->layerConstraint == LayerConstraint::LAST_SEPARATE) {
+            // Force to rightmost layer
+            node->layerIndex = maxLayer;
+            if (node->originalNode) {
+                ELK_TRACE_DEBUG("  " << node->originalNode->id << " -> LAST (layer " << maxLayer << ")\n");
+            }
         }
     }
 
+    fillLayers(session, maxLayer + 1);
+
     // Debug: Print layer assignment
-    std::cerr << "\n=== LAYER ASSIGNMENT ===\n";
-    std::cerr << "Total layers: " << layers.size() << "\n";
+    ELK_TRACE_INFO("\n=== LAYER ASSIGNMENT ===\n");
+    ELK_TRACE_INFO("Total layers: " << layers.size() << "\n");
     for (size_t i = 0; i < layers.size(); ++i) {
-        std::cerr << "Layer " << i << ": " << layers[i].nodes.size() << " nodes\n";
+        ELK_TRACE_DEBUG("Layer " << i << ": " << layers[i].nodes.size() << " nodes\n");
     }
 }
 
-std::vector<LNode*> LayeredLayoutProvider::assignLayersLongestPath(std::vector<LNode*>& nodes) {
-    std::cerr << "\n=== LONGEST PATH LAYERING (to sink) ===\n";
-
-    // Initialize all nodes with unvisited marker (-1)
-    std::unordered_map<LNode*, int> nodeHeights;
-    for (LNode* node : nodes) {
-        nodeHeights[node] = -1;
-    }
+void LayeredLayoutProvider::fillLayers(LayoutSession& session, int layerCount) {
+    std::vector<Layer>& layers = session.layers;
+    session.resizeLayers(0);
+    session.resizeLayers(layerCount);
 
-    // Visit function: calculates longest path to any sink
-    std::function<int(LNode*)> visit = [&](LNode* node) -> int {
-        int height = nodeHeights[node];
-        if (height >= 0) {
-            // Already visited
-            return height;
+    // Assign nodes to layers in node order (to match Java behavior)
+    for (LNode* node : session.nodes) {
+        if (node->layerIndex >= 0 && node->layerIndex < layerCount) {
+            layers[node->layerIndex].nodes.push_back(node);
         }
+    }
+}
 
-        int maxHeight = 1;  // Minimum height is 1
-
-        // Check all outgoing edges to find longest path to sink
-        for (LPort* port : node->getPorts()) {
-            for (LEdge* edge : port->outgoingEdges) {
-                LNode* targetNode = edge->getTarget()->getNode();
+void LayeredLayoutProvider::promoteNodes(const Node* graph, LayoutSession& session) {
+    NodePromotionStrategy strategy = nodePromotionFor(graph, nodePromotion_);
+    if (strategy == NodePromotionStrategy::NONE) return;
+
+    ELK_TRACE_PHASE("promotion");
+    NodePromotion& promotion = session.nodePromotion;
+    int sweeps = promotionIterationsFor(graph, promotionIterations_);
+    bool moved = promotion.process(session.nodes, session.adjacency, strategy == NodePromotionStrategy::NIKOLOV, sweeps);
+
+    ELK_TRACE_INFO("\n=== NODE PROMOTION ===\n");
+    ELK_TRACE_INFO("Promotions: " << promotion.promotionCount() << " in " << promotion.sweepCount() << " sweeps\n");
+    ELK_TRACE_INFO("Dummy nodes: " << promotion.dummiesBefore() << " before, " << promotion.dummiesAfter()
+                                   << " after\n");
+    ELK_TRACE_COUNT(SAVED_DUMMIES, promotion.dummiesBefore() - promotion.dummiesAfter());
+    if (!moved) return;
+
+    int layerCount = 0;
+    for (LNode* node : session.nodes) {
+        layerCount = std::max(layerCount, node->layerIndex + 1);
+    }
+    fillLayers(session, layerCount);
+}
 
-                // Ignore self-loops
-                if (node != targetNode && targetNode) {
-                    int targetHeight = visit(targetNode);
-                    maxHeight = std::max(maxHeight, targetHeight + 1);
-                }
-            }
+void LayeredLayoutProvider::assignLayersLongestPath(LayoutSession& session) {
+    ELK_TRACE_INFO("\n=== LONGEST PATH LAYERING (to sink) ===\n");
+
+    std::vector<LNode*>& nodes = session.nodes;
+    const LAdjacency& adjacency = session.adjacency;
+
+    // Height of a node: number of nodes on the longest path from it to a
+    // sink. Heights are final once all successors have theirs, so nodes are
+    // taken in reverse topological order (Kahn's algorithm from the sinks),
+    // which needs no recursion however deep the graph is. Cycle breaking
+    // left only self-loops, which are ignored.
+    int nodeCount = static_cast<int>(nodes.size());
+    std::vector<int>& nodeHeights = session.heights;
+    std::vector<int>& unplaced = session.unplacedSuccessors;
+    std::vector<int>& ready = session.layeringQueue;
+    nodeHeights.assign(nodeCount, 1);  // Minimum height is 1
+    unplaced.assign(nodeCount, 0);
+    ready.clear();
+    for (int i = 0; i < nodeCount; i++) {
+        for (int target : adjacency.outgoing(i)) {
+            if (target != i) unplaced[i]++;
         }
+        if (unplaced[i] == 0) ready.push_back(i);
+    }
 
-        nodeHeights[node] = maxHeight;
+    int maxHeight = 0;
+    for (std::size_t next = 0; next < ready.size(); next++) {
+        int node = ready[next];
+        int height = nodeHeights[node];
+        maxHeight = std::max(maxHeight, height);
 
-        if (node->originalNode) {
-            std::cerr << "  " << node->originalNode->id << " height=" << maxHeight << "\n";
+        if (nodes[node]->originalNode) {
+            ELK_TRACE_DEBUG("  " << nodes[node]->originalNode->id << " height=" << height << "\n");
         }
 
-        return maxHeight;
-    };
-
-    // Visit all nodes to calculate heights
-    int maxHeight = 0;
-    for (LNode* node : nodes) {
-        if (nodeHeights[node] < 0) {
-            int height = visit(node);
-            maxHeight = std::max(maxHeight, height);
+        for (int source : adjacency.incoming(node)) {
+            if (source == node) continue;
+            nodeHeights[source] = std::max(nodeHeights[source], height + 1);
+            if (--unplaced[source] == 0) ready.push_back(source);
         }
     }
 
-    std::cerr << "Max height: " << maxHeight << "\n";
+    ELK_TRACE_INFO("Max height: " << maxHeight << "\n");
 
     // Convert heights to layer indices
     // Java formula: layerIndex = totalLayers - height
     // where totalLayers = maxHeight
-    std::cerr << "\nConverting heights to layers:\n";
+    ELK_TRACE_DEBUG("\nConverting heights to layers:\n");
     for (LNode* node : nodes) {
-        int height = nodeHeights[node];
+        int height = nodeHeights[node->graphIndex];
         node->layerIndex = maxHeight - height;
 
         if (node->originalNode) {
-            std::cerr << "  " << node->originalNode->id
-                      << " height=" << height
-                      << " -> layer=" << node->layerIndex << "\n";
-        }
-    }
-
-    // Enforce layer constraints (FIRST, LAST, etc.)
-    std::cerr << "\nEnforcing layer constraints:\n";
-    int maxLayer = maxHeight - 1;  // maxHeight - 1 is the rightmost layer
-
-    for (LNode* node : nodes) {
-        if (node->layerConstraint == LayerConstraint::FIRST ||
-            node->layerConstraint == LayerConstraint::FIRST_SEPARATE) {
-            // Force to leftmost layer (layer 0)
-            node->layerIndex = 0;
-            if (node->originalNode) {
-                std::cerr << "  " << node->originalNode->id << " -> FIRST (layer 0)\n";
-            }
-        } else if (node->layerConstraint == LayerConstraint::LAST ||
-                   node->layerConstraint == LayerConstraint::LAST_SEPARATE) {
-            // Force to rightmost layer
-            node->layerIndex = maxLayer;
-            if (node->originalNode) {
-                std::cerr << "  " << node->originalNode->id << " -> LAST (layer " << maxLayer << ")\n";
-            }
+            ELK_TRACE_DEBUG("  " << node->originalNode->id
+                            << " height=" << height
+                            << " -> layer=" << node->layerIndex << "\n");
         }
     }
-
-    return nodes;  // Return nodes vector (order doesn't matter for this algorithm)
 }
 
-void LayeredLayoutProvider::insertDummyNodes(std::vector<LNode*>& nodes, std::vector<LEdge*>& edges,
-                                             std::vector<Layer>& layers) {
-    std::vector<LEdge*> longEdges;
+void LayeredLayoutProvider::insertDummyNodes(LayoutSession& session) {
+    std::vector<LNode*>& nodes = session.nodes;
+    std::vector<LEdge*>& edges = session.edges;
+    std::vector<LEdge*>& longEdges = session.longEdges;
+
+    ELK_TRACE_PHASE("dummies");
+    std::size_t dummyCount = 0;
 
     // Find edges spanning multiple layers
     for (LEdge* edge : edges) {
@@ -608,7 +758,12 @@ void LayeredLayoutProvider::insertDummyNodes(std::vector<LNode*>& nodes, std::ve
         }
     }
 
-    // Insert dummy nodes for long edges
+    // Turn long edges into chains of order slots. The LEdges of a
+    // multi-terminal net that leave the same port share one chain, which
+    // grows to the farthest target; nearer targets leave it at the slot in
+    // the layer before them, the last layer their paths share. With
+    // mergeLongEdges_ all forward edges leaving a port share its chain.
+    std::map<std::pair<LPort*, Edge*>, LongEdgeChain*> shared;
     for (LEdge* edge : longEdges) {
         LNode* srcNode = edge->getSource()->getNode();
         LNode* tgtNode = edge->getTarget()->getNode();
@@ -616,129 +771,244 @@ void LayeredLayoutProvider::insertDummyNodes(std::vector<LNode*>& nodes, std::ve
         int startLayer = std::min(srcNode->layerIndex, tgtNode->layerIndex);
         int endLayer = std::max(srcNode->layerIndex, tgtNode->layerIndex);
 
-        LPort* prevPort = edge->getSource();
-        for (int layer = startLayer + 1; layer < endLayer; ++layer) {
-            // Create dummy node
-            LNode* dummy = new LNode();
-            dummy->type = NodeType::LONG_EDGE;
-            dummy->layerIndex = layer;
-            dummy->size = Size(1, 1);  // Minimal size
-            nodes.push_back(dummy);
-            layers[layer].nodes.push_back(dummy);
-
-            // Create ports for dummy (in and out)
-            LPort* dummyIn = new LPort();
-            dummyIn->node = dummy;
-            dummyIn->side = PortSide::WEST;
-            // Link dummy port back to original source port for rendering
-            if (prevPort && prevPort->originalPort) {
-                dummyIn->originalPort = prevPort->originalPort;
+        LongEdgeChain* chain = nullptr;
+        Edge* net = edge->originalEdge;
+        if (srcNode->layerIndex < tgtNode->layerIndex) {
+            LongEdgeChain** entry = nullptr;
+            if (mergeLongEdges_ && !edge->reversed) {
+                entry = &shared[{edge->getSource(), nullptr}];
+            } else if (net && net->isHyperedge()) {
+                entry = &shared[{edge->getSource(), net}];
             }
-            dummy->ports.push_back(dummyIn);
-
-            LPort* dummyOut = new LPort();
-            dummyOut->node = dummy;
-            dummyOut->side = PortSide::EAST;
-            // Link dummy port back to original source port for rendering
-            if (prevPort && prevPort->originalPort) {
-                dummyOut->originalPort = prevPort->originalPort;
+            if (entry) {
+                if (!*entry) *entry = session.newChain(edge->getSource(), startLayer + 1);
+                chain = *entry;
             }
-            dummy->ports.push_back(dummyOut);
+        }
+        if (!chain) {
+            chain = session.newChain(edge->getSource(), startLayer + 1);
+        }
 
-            // Create edge segment
-            LEdge* segment = new LEdge();
-            segment->setSource(prevPort);
-            segment->setTarget(dummyIn);
-            edges.push_back(segment);
+        while (static_cast<int>(chain->slots.size()) < endLayer - startLayer - 1) {
+            appendLongEdgeSlot(chain, session);
+        }
 
-            prevPort = dummyOut;
+        // Update original edge to leave from its last slot
+        edge->setSource(leaveLongEdge(chain->slots[endLayer - startLayer - 2], session));
+    }
+
+    std::size_t portCount = 0;
+    std::size_t edgeCount = 0;
+    for (std::size_t i = 0; i < session.chainsInUse; ++i) {
+        for (LNode* slot : session.chainPool[i]->slots) {
+            dummyCount++;
+            for (LPort* port : slot->ports) {
+                portCount++;
+                if (port->side == PortSide::WEST) edgeCount++;
+            }
         }
+    }
 
-        // Update original edge to connect from last dummy
-        edge->setSource(prevPort);
+    session.adjacency.build(nodes);
+
+    ELK_TRACE_COUNT(DUMMY_NODES, dummyCount);
+    ELK_TRACE_COUNT(NODE_ALLOCATIONS, dummyCount);
+    ELK_TRACE_COUNT(PORT_ALLOCATIONS, portCount);
+    ELK_TRACE_COUNT(EDGE_ALLOCATIONS, edgeCount);
+}
+
+LNode* LayeredLayoutProvider::appendLongEdgeSlot(LongEdgeChain* chain, LayoutSession& session) {
+    int layer = chain->firstLayer + static_cast<int>(chain->slots.size());
+
+    LNode* slot = session.graph.addNode();
+    slot->type = NodeType::LONG_EDGE;
+    slot->layerIndex = layer;
+    slot->size = Size(1, 1);  // Minimal size
+    slot->longEdge = chain;
+    session.layers[layer].nodes.push_back(slot);
+
+    // Only the first slot and slots after an exit are connected by edges
+    if (chain->slots.empty()) {
+        connectLongEdgeSlot(chain->source, slot, session);
+    } else {
+        LNode* previous = chain->slots.back();
+        for (LPort* port : previous->ports) {
+            if (port->side == PortSide::EAST) {
+                connectLongEdgeSlot(port, slot, session);
+            }
+        }
+    }
+    chain->slots.push_back(slot);
+    return slot;
+}
+
+LPort* LayeredLayoutProvider::leaveLongEdge(LNode* slot, LayoutSession& session) {
+    for (LPort* port : slot->ports) {
+        if (port->side == PortSide::EAST) return port;
+    }
+
+    LPort* output = session.graph.addPort(slot);
+    output->side = PortSide::EAST;
+    // Link dummy port back to original source port for rendering
+    output->originalPort = slot->longEdge->source->originalPort;
+    slot->ports.push_back(output);
+
+    // The chain continues from here as an edge now
+    if (LNode* next = slot->longEdge->next(slot)) {
+        connectLongEdgeSlot(output, next, session);
     }
+    return output;
+}
+
+void LayeredLayoutProvider::connectLongEdgeSlot(LPort* from, LNode* slot, LayoutSession& session) {
+    LPort* input = session.graph.addPort(slot);
+    input->side = PortSide::WEST;
+    // Link dummy port back to original source port for rendering
+    input->originalPort = from->originalPort;
+    slot->ports.insert(slot->ports.begin(), input);
+
+    LEdge* segment = session.graph.addEdge();
+    segment->setSource(from);
+    segment->setTarget(input);
 }
 
-void LayeredLayoutProvider::minimizeCrossings(std::vector<Layer>& layers) {
-    if (crossingStrategy_ == CrossingMinimizationStrategy::NONE) return;
+void LayeredLayoutProvider::minimizeCrossings(LayoutSession& session) {
+    std::vector<Layer>& layers = session.layers;
+    ELK_TRACE_PHASE("crossing minimization");
+
+    ELK_TRACE_INFO("\n=== MINIMIZE CROSSINGS ===\n");
 
-    std::cerr << "\n=== MINIMIZE CROSSINGS ===\n";
+    // Positions of the nodes in their layers, by graphIndex; unordered
+    // nodes have none yet
+    session.order.assign(session.nodes.size(), -1);
 
     // Simple layer sweep with barycenter heuristic
     int iterations = 5;
     for (int iter = 0; iter < iterations; ++iter) {
         // Forward sweep
         for (size_t i = 1; i < layers.size(); ++i) {
-            barycenterHeuristic(layers[i], true);  // Use incoming edges
+            barycenterHeuristic(layers[i], true, session);  // Use incoming edges
         }
         // Backward sweep
         for (int i = static_cast<int>(layers.size()) - 2; i >= 0; --i) {
-            barycenterHeuristic(layers[i], false);  // Use outgoing edges
+            barycenterHeuristic(layers[i], false, session);  // Use outgoing edges
         }
     }
 
     // Log final node order
-    for (size_t i = 0; i < layers.size(); ++i) {
-        std::cerr << "Layer " << i << " final order: ";
-        for (LNode* node : layers[i].nodes) {
-            std::cerr << (node->originalNode ? node->originalNode->id : "dummy") << " ";
+    if (ELK_TRACE_ENABLED(trace::Level::DEBUG)) {
+        for (size_t i = 0; i < layers.size(); ++i) {
+            std::string order;
+            for (LNode* node : layers[i].nodes) {
+                order += (node->originalNode ? node->originalNode->id.str() : "dummy") + " ";
+            }
+            ELK_TRACE_DEBUG("Layer " << i << " final order: " << order << "\n");
         }
-        std::cerr << "\n";
     }
 }
 
-void LayeredLayoutProvider::barycenterHeuristic(Layer& layer, bool useIncoming) {
-    struct NodeWithBarycenter {
-        LNode* node;
-        double barycenter;
-    };
+int LayeredLayoutProvider::countCrossings(const Layer& upperLayer, const Layer& lowerLayer,
+                                          const LayoutSession& session) {
+    // Edges ordered by (source position, target position) cross exactly
+    // where their target positions are inverted; count inversions with a
+    // Fenwick tree over target positions. Edges sharing a node never count.
+    if (upperLayer.nodes.empty() || lowerLayer.nodes.empty()) return 0;
+
+    for (size_t i = 0; i < upperLayer.nodes.size(); ++i) {
+        upperLayer.nodes[i]->scratchIndex = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < lowerLayer.nodes.size(); ++i) {
+        lowerLayer.nodes[i]->scratchIndex = static_cast<int>(i);
+    }
+
+    std::vector<std::pair<int, int>> ends;
+    int lowerIndex = lowerLayer.nodes.front()->layerIndex;
+    for (LNode* node : upperLayer.nodes) {
+        for (int j : session.adjacency.outgoing(node->graphIndex)) {
+            const LNode* target = session.nodes[j];
+            if (target->layerIndex == lowerIndex) {
+                ends.emplace_back(node->scratchIndex, target->scratchIndex);
+            }
+        }
+    }
+    std::sort(ends.begin(), ends.end());
+
+    int crossings = 0;
+    std::vector<int> tree(lowerLayer.nodes.size() + 1, 0);
+    for (size_t k = 0; k < ends.size(); ++k) {
+        // Earlier edges whose target lies right of this one
+        int notRight = 0;
+        for (int i = ends[k].second + 1; i > 0; i -= i & -i) {
+            notRight += tree[i];
+        }
+        crossings += static_cast<int>(k) - notRight;
+        for (size_t i = ends[k].second + 1; i < tree.size(); i += i & -i) {
+            tree[i]++;
+        }
+    }
+    return crossings;
+}
 
-    std::vector<NodeWithBarycenter> nodePositions;
+void LayeredLayoutProvider::barycenterHeuristic(Layer& layer, bool useIncoming, LayoutSession& session) {
+    std::vector<std::pair<double, int>>& nodePositions = session.barycenters;
+    nodePositions.clear();
+    const LAdjacency& adjacency = session.adjacency;
+    std::vector<int>& order = session.order;
 
-    std::cerr << "  Barycenter (layer " << layer.index << ", " << (useIncoming ? "incoming" : "outgoing") << "):\n";
+    ELK_TRACE_DEBUG("  Barycenter (layer " << layer.index << ", " << (useIncoming ? "incoming" : "outgoing") << "):\n");
 
     for (LNode* node : layer.nodes) {
         double sum = 0.0;
         int count = 0;
 
-        const auto& edges = useIncoming ? node->getIncomingEdges() : node->getOutgoingEdges();
-        for (LEdge* edge : edges) {
-            LNode* other = useIncoming ? edge->getSource()->getNode() : edge->getTarget()->getNode();
-            if (other && other->orderInLayer >= 0) {
-                sum += other->orderInLayer;
+        int i = node->graphIndex;
+        for (int j : useIncoming ? adjacency.incoming(i) : adjacency.outgoing(i)) {
+            if (order[j] >= 0) {
+                sum += order[j];
                 count++;
-                std::cerr << "      " << (node->originalNode ? node->originalNode->id : "dummy")
-                          << " connects to " << (other->originalNode ? other->originalNode->id : "dummy")
-                          << " at position " << other->orderInLayer << "\n";
+                ELK_TRACE_DEBUG("      " << (node->originalNode ? node->originalNode->id.str() : "dummy")
+                                << " connects to "
+                                << (session.nodes[j]->originalNode ? session.nodes[j]->originalNode->id.str() : "dummy")
+                                << " at position " << order[j] << "\n");
             }
         }
 
         double barycenter = (count > 0) ? sum / count : node->orderInLayer;
-        std::cerr << "    Node " << (node->originalNode ? node->originalNode->id : "dummy")
-                  << ": sum=" << sum << ", count=" << count << ", barycenter=" << barycenter << "\n";
-        nodePositions.push_back({node, barycenter});
+        ELK_TRACE_DEBUG("    Node " << (node->originalNode ? node->originalNode->id.str() : "dummy")
+                        << ": sum=" << sum << ", count=" << count << ", barycenter=" << barycenter << "\n");
+        nodePositions.push_back({barycenter, static_cast<int>(nodePositions.size())});
     }
 
-    // Sort by barycenter (use stable_sort to match Java Collections.sort behavior)
-    std::stable_sort(nodePositions.begin(), nodePositions.end(),
-                     [](const auto& a, const auto& b) { return a.barycenter < b.barycenter; });
+    // Sort by barycenter, keeping the layer order among equal ones like Java's stable
+    // Collections.sort; unlike std::stable_sort, sorting by position as well needs no buffer
+    std::sort(nodePositions.begin(), nodePositions.end());
 
-    std::cerr << "    After sort: ";
+    std::vector<LNode*>& sortedLayer = session.sortedLayer;
+    sortedLayer.clear();
     for (const auto& np : nodePositions) {
-        std::cerr << (np.node->originalNode ? np.node->originalNode->id : "dummy") << "(" << np.barycenter << ") ";
+        sortedLayer.push_back(layer.nodes[np.second]);
+    }
+
+    if (ELK_TRACE_ENABLED(trace::Level::DEBUG)) {
+        std::ostringstream order;
+        for (size_t i = 0; i < sortedLayer.size(); ++i) {
+            order << (sortedLayer[i]->originalNode ? sortedLayer[i]->originalNode->id.str() : "dummy")
+                  << "(" << nodePositions[i].first << ") ";
+        }
+        ELK_TRACE_DEBUG("    After sort: " << order.str() << "\n");
     }
-    std::cerr << "\n";
 
     // Update layer and order
-    layer.nodes.clear();
-    for (size_t i = 0; i < nodePositions.size(); ++i) {
-        nodePositions[i].node->orderInLayer = static_cast<int>(i);
-        layer.nodes.push_back(nodePositions[i].node);
+    layer.nodes.assign(sortedLayer.begin(), sortedLayer.end());
+    for (size_t i = 0; i < sortedLayer.size(); ++i) {
+        sortedLayer[i]->orderInLayer = static_cast<int>(i);
+        order[sortedLayer[i]->graphIndex] = static_cast<int>(i);
     }
 }
 
-void LayeredLayoutProvider::assignCoordinates(std::vector<Layer>& layers) {
-    std::cerr << "\n=== ASSIGN COORDINATES ===\n";
+void LayeredLayoutProvider::assignCoordinates(LayoutSession& session) {
+    std::vector<Layer>& layers = session.layers;
+    ELK_TRACE_INFO("\n=== ASSIGN COORDINATES ===\n");
 
     // For DOWN direction, layers go top-to-bottom (along Y)
     // For RIGHT direction, layers go left-to-right (along X)
@@ -746,6 +1016,8 @@ void LayeredLayoutProvider::assignCoordinates(std::vector<Layer>& layers) {
     // For DOWN, we need to transform: swap layer axis and node axis
 
     if (direction_ == Direction::DOWN || direction_ == Direction::UP) {
+        ELK_TRACE_PHASE("placement");
+
         // For DOWN: layers along Y, nodes within layer along X
         // Need to account for port extents just like the old algorithm
 
@@ -756,7 +1028,7 @@ void LayeredLayoutProvider::assignCoordinates(std::vector<Layer>& layers) {
             double maxPortExtentAbove = 0.0;
 
             for (LNode* node : layer.nodes) {
-                for (LPort* port : node->ports) {
+                for (LPort* port : session.adjacency.ports(node->graphIndex)) {
                     double extentBelow = port->position.y - node->size.height;
                     double extentAbove = -port->position.y;
                     maxPortExtentBelow = std::max(maxPortExtentBelow, extentBelow);
@@ -795,51 +1067,52 @@ void LayeredLayoutProvider::assignCoordinates(std::vector<Layer>& layers) {
         // For RIGHT/LEFT: layers along X, nodes within layer along Y
         // Use LinearSegmentsNodePlacer for Y, then assign layer X
 
-        // Port of LinearSegmentsNodePlacer.place() (Java line 206)
-        // Phase 1: Sort linear segments with dependency graph
-        std::vector<LinearSegment*> linearSegments = sortLinearSegments(layers);
+        {
+            ELK_TRACE_PHASE("placement");
 
-        // Phase 2: Create unbalanced placement (assigns Y within layers)
-        createUnbalancedPlacement(layers, linearSegments);
+            // Port of LinearSegmentsNodePlacer.place() (Java line 206)
+            // Phase 1: Sort linear segments with dependency graph
+            sortLinearSegments(session);
 
-        // Phase 3: Balance placement (SKIPPED for now - can add later)
-        // balancePlacement(layers, linearSegments);
+            // Phase 2: Create unbalanced placement (assigns Y within layers)
+            createUnbalancedPlacement(session);
 
-        // Calculate layer sizes (width) based on Java's LayerSizeAndGraphHeightCalculator
-        // Layer width = max(node.width + node.margin.left + node.margin.right)
-        std::vector<double> layerWidths(layers.size(), 0.0);
-        for (size_t i = 0; i < layers.size(); i++) {
-            Layer& layer = layers[i];
-            for (LNode* node : layer.nodes) {
-                double nodeWidth = node->size.width + node->margin.left + node->margin.right;
-                layerWidths[i] = std::max(layerWidths[i], nodeWidth);
+            // Phase 3: Balance placement (SKIPPED for now - can add later)
+            // balancePlacement(layers, linearSegments);
+
+            // Calculate layer sizes (width) based on Java's LayerSizeAndGraphHeightCalculator
+            // Layer width = max(node.width + node.margin.left + node.margin.right)
+            std::vector<double>& layerWidths = session.layerWidths;
+            layerWidths.assign(layers.size(), 0.0);
+            for (size_t i = 0; i < layers.size(); i++) {
+                Layer& layer = layers[i];
+                for (LNode* node : layer.nodes) {
+                    double nodeWidth = node->size.width + node->margin.left + node->margin.right;
+                    layerWidths[i] = std::max(layerWidths[i], nodeWidth);
+                }
             }
         }
 
         // Use OrthogonalEdgeRouter to assign X coordinates with dynamic spacing
-        std::cerr << "\nUsing OrthogonalEdgeRouter for dynamic layer spacing:\n";
+        ELK_TRACE_DEBUG("\nUsing OrthogonalEdgeRouter for dynamic layer spacing:\n");
         double edgeEdgeSpacing = 10.0;  // Spacing between routing slots
         double edgeNodeSpacing = 10.0;  // Spacing between edges and nodes
 
         double finalWidth = p5edges::OrthogonalEdgeRouter::process(
-            layers, layerSpacing_, edgeEdgeSpacing, edgeNodeSpacing);
-
-        std::cerr << "Final graph width (with dynamic spacing): " << finalWidth << "\n";
+            layers, session.routingGraph, session.routingGenerator,
+            layerSpacing_, edgeEdgeSpacing, edgeNodeSpacing);
 
-        // Cleanup segments
-        for (LinearSegment* seg : linearSegments) {
-            delete seg;
-        }
+        ELK_TRACE_INFO("Final graph width (with dynamic spacing): " << finalWidth << "\n");
     }
 
-    std::cerr << "Coordinate assignment complete\n";
+    ELK_TRACE_INFO("Coordinate assignment complete\n");
 }
 
 void LayeredLayoutProvider::linearSegmentPlacement(std::vector<Layer>& layers) {
-    std::cerr << "\n=== LINEAR SEGMENT PLACEMENT ===\n";
-    std::cerr << "Number of layers: " << layers.size() << "\n";
-    std::cerr << "Direction: " << (int)direction_ << " (0=RIGHT, 1=LEFT, 2=DOWN, 3=UP)\n";
-    std::cerr << "Node spacing: " << nodeSpacing_ << ", Layer spacing: " << layerSpacing_ << "\n";
+    ELK_TRACE_INFO("\n=== LINEAR SEGMENT PLACEMENT ===\n");
+    ELK_TRACE_INFO("Number of layers: " << layers.size() << "\n");
+    ELK_TRACE_INFO("Direction: " << (int)direction_ << " (0=RIGHT, 1=LEFT, 2=DOWN, 3=UP)\n");
+    ELK_TRACE_INFO("Node spacing: " << nodeSpacing_ << ", Layer spacing: " << layerSpacing_ << "\n");
 
     // Different logic based on direction
     if (direction_ == Direction::DOWN || direction_ == Direction::UP) {
@@ -870,15 +1143,15 @@ void LayeredLayoutProvider::linearSegmentPlacement(std::vector<Layer>& layers) {
             double currentX = 0.0;
             double maxHeight = 0.0;
 
-            std::cerr << "Layer " << layerIdx << " has " << layer.nodes.size() << " nodes, Y=" << currentY << "\n";
+            ELK_TRACE_DEBUG("Layer " << layerIdx << " has " << layer.nodes.size() << " nodes, Y=" << currentY << "\n");
 
             for (LNode* node : layer.nodes) {
                 node->position.x = currentX;
                 node->position.y = currentY;
 
-                std::cerr << "  Node " << (node->originalNode ? node->originalNode->id : "dummy")
-                          << " at (" << currentX << ", " << currentY << ") size="
-                          << node->size.width << "x" << node->size.height << "\n";
+                ELK_TRACE_DEBUG("  Node " << (node->originalNode ? node->originalNode->id.str() : "dummy")
+                                << " at (" << currentX << ", " << currentY << ") size="
+                                << node->size.width << "x" << node->size.height << "\n");
 
                 currentX += node->size.width + nodeSpacing_;
                 maxHeight = std::max(maxHeight, node->size.height);
@@ -891,13 +1164,13 @@ void LayeredLayoutProvider::linearSegmentPlacement(std::vector<Layer>& layers) {
                 effectiveSpacing += layers[layerIdx + 1].maxPortExtentAbove;  // Next layer's ports extending up
             }
 
-            std::cerr << "  Layer maxHeight=" << maxHeight
-                      << ", portExtentBelow=" << layer.maxPortExtentBelow;
+            ELK_TRACE_DEBUG("  Layer maxHeight=" << maxHeight
+                            << ", portExtentBelow=" << layer.maxPortExtentBelow);
             if (layerIdx + 1 < layers.size()) {
-                std::cerr << ", nextLayerPortExtentAbove=" << layers[layerIdx + 1].maxPortExtentAbove;
+                ELK_TRACE_DEBUG(", nextLayerPortExtentAbove=" << layers[layerIdx + 1].maxPortExtentAbove);
             }
-            std::cerr << ", effectiveSpacing=" << effectiveSpacing
-                      << ", next Y=" << (currentY + maxHeight + effectiveSpacing) << "\n";
+            ELK_TRACE_DEBUG(", effectiveSpacing=" << effectiveSpacing
+                            << ", next Y=" << (currentY + maxHeight + effectiveSpacing) << "\n");
 
             currentY += maxHeight + effectiveSpacing;
         }
@@ -910,21 +1183,21 @@ void LayeredLayoutProvider::linearSegmentPlacement(std::vector<Layer>& layers) {
             double currentY = 0.0;
             double maxWidth = 0.0;
 
-            std::cerr << "Layer " << layerIdx << " has " << layer.nodes.size() << " nodes, X=" << currentX << "\n";
+            ELK_TRACE_DEBUG("Layer " << layerIdx << " has " << layer.nodes.size() << " nodes, X=" << currentX << "\n");
 
             for (LNode* node : layer.nodes) {
                 node->position.x = currentX;
                 node->position.y = currentY;
 
-                std::cerr << "  Node " << (node->originalNode ? node->originalNode->id : "dummy")
-                          << " at (" << currentX << ", " << currentY << ") size="
-                          << node->size.width << "x" << node->size.height << "\n";
+                ELK_TRACE_DEBUG("  Node " << (node->originalNode ? node->originalNode->id.str() : "dummy")
+                                << " at (" << currentX << ", " << currentY << ") size="
+                                << node->size.width << "x" << node->size.height << "\n");
 
                 currentY += node->size.height + nodeSpacing_;
                 maxWidth = std::max(maxWidth, node->size.width);
             }
 
-            std::cerr << "  Layer maxWidth=" << maxWidth << ", next X=" << (currentX + maxWidth + layerSpacing_) << "\n";
+            ELK_TRACE_DEBUG("  Layer maxWidth=" << maxWidth << ", next X=" << (currentX + maxWidth + layerSpacing_) << "\n");
             currentX += maxWidth + layerSpacing_;
         }
     }
@@ -955,8 +1228,8 @@ void LayeredLayoutProvider::routeEdges(const std::vector<Layer>& layers, std::ve
 }
 
 void LayeredLayoutProvider::applyLayout(const std::vector<LNode*>& nodes, const std::vector<LEdge*>& edges) {
-    std::cerr << "\n=== APPLY LAYOUT ===\n";
-    std::cerr << "Total nodes: " << nodes.size() << "\n";
+    ELK_TRACE_INFO("\n=== APPLY LAYOUT ===\n");
+    ELK_TRACE_INFO("Total nodes: " << nodes.size() << "\n");
 
     // ELK uses 12px default padding/insets for graphs
     const double graphPadding = 12.0;
@@ -980,34 +1253,33 @@ void LayeredLayoutProvider::applyLayout(const std::vector<LNode*>& nodes, const
             appliedCount++;
         } else {
             if (lnode->originalNode) {
-                std::cerr << "  Skipped node " << lnode->originalNode->id
-                          << " (type=" << (int)lnode->type << ")\n";
+                ELK_TRACE_DEBUG("  Skipped node " << lnode->originalNode->id
+                                << " (type=" << (int)lnode->type << ")\n");
             }
             skippedCount++;
         }
     }
-    std::cerr << "Applied layout to " << appliedCount << " nodes, skipped " << skippedCount << "\n";
+    ELK_TRACE_INFO("Applied layout to " << appliedCount << " nodes, skipped " << skippedCount << "\n");
 
     // Apply edge layout (transpiled from ElkGraphLayoutTransferrer.applyEdgeLayout)
-    std::cerr << "\nApplying edge layout for " << edges.size() << " edges\n";
+    ELK_TRACE_INFO("\nApplying edge layout for " << edges.size() << " edges\n");
+    // Each LEdge adds one section to its original edge: one for a two-terminal
+    // edge, one per source/target pair for a multi-terminal net
     for (const LEdge* ledge : edges) {
-        std::cerr << "  LEdge pointer: " << ledge << "\n";
+        if (ledge->originalEdge) {
+            ledge->originalEdge->sections.clear();
+        }
+    }
+    for (const LEdge* ledge : edges) {
+        ELK_TRACE_DEBUG("  LEdge pointer: " << ledge << "\n");
         if (ledge->originalEdge) {
             LPort* srcPort = ledge->getSource();
             LPort* tgtPort = ledge->getTarget();
 
             if (srcPort && tgtPort) {
-                // Get bendPoints from LEdge (Java line 238)
+                // Bend points of the LEdge (Java line 238)
                 // IMPORTANT: These bend points are in LAYERED GRAPH space (before padding offset)
-                std::vector<Point> bendPoints = ledge->bendPoints;
-                std::cerr << "    Edge " << ledge->originalEdge->id << " has " << bendPoints.size() << " bend points\n";
-
-                // Transform bend points from layered graph space to original graph space
-                // by adding the graphPadding offset
-                for (Point& bp : bendPoints) {
-                    bp.x += graphPadding;
-                    bp.y += graphPadding;
-                }
+                ELK_TRACE_DEBUG("    Edge " << ledge->originalEdge->id << " has " << ledge->bendPoints.size() << " bend points\n");
 
                 // Add source port absolute anchor using ORIGINAL port (not layered port!)
                 // The LPort has coordinates in layered graph space, but we need original graph space
@@ -1016,17 +1288,17 @@ void LayeredLayoutProvider::applyLayout(const std::vector<LNode*>& nodes, const
                 // If no originalPort, this might be a dummy port - trace back through incoming edges
                 if (!origSrc) {
                     if (srcPort->node) {
-                        std::cerr << "    Source port node type: " << (int)srcPort->node->type << "\n";
+                        ELK_TRACE_DEBUG("    Source port node type: " << (int)srcPort->node->type << "\n");
                         if (srcPort->node->type == NodeType::LONG_EDGE) {
                             // For dummy nodes, follow incoming edge to find real source port
-                            std::cerr << "    Source port is on LONG_EDGE dummy, incomingEdges count: " << srcPort->incomingEdges.size() << "\n";
+                            ELK_TRACE_DEBUG("    Source port is on LONG_EDGE dummy, incomingEdges count: " << srcPort->incomingEdges.size() << "\n");
                             if (!srcPort->incomingEdges.empty()) {
                                 LEdge* inEdge = srcPort->incomingEdges.front();
                                 LPort* prevSrc = inEdge ? inEdge->getSource() : nullptr;
-                                std::cerr << "    Incoming edge source port: " << prevSrc << "\n";
+                                ELK_TRACE_DEBUG("    Incoming edge source port: " << prevSrc << "\n");
                                 if (prevSrc) {
                                     origSrc = prevSrc->originalPort;
-                                    std::cerr << "    Traced dummy source back to originalPort: " << origSrc << "\n";
+                                    ELK_TRACE_DEBUG("    Traced dummy source back to originalPort: " << origSrc << "\n");
                                 }
                             }
                         }
@@ -1034,19 +1306,18 @@ void LayeredLayoutProvider::applyLayout(const std::vector<LNode*>& nodes, const
                 }
 
                 if (!origSrc) {
-                    std::cerr << "    WARNING: Source LPort has no originalPort pointer, skipping edge " << ledge->originalEdge->id << "\n";
+                    ELK_TRACE_WARN("    WARNING: Source LPort has no originalPort pointer, skipping edge " << ledge->originalEdge->id << "\n");
                     continue;
                 }
                 if (!origSrc->parent) {
-                    std::cerr << "    WARNING: Source originalPort has no parent (port id=" << origSrc->id << "), skipping edge " << ledge->originalEdge->id << "\n";
+                    ELK_TRACE_WARN("    WARNING: Source originalPort has no parent (port id=" << origSrc->id << "), skipping edge " << ledge->originalEdge->id << "\n");
                     continue;
                 }
                 Point sourcePoint{
                     origSrc->parent->position.x + origSrc->position.x,
                     origSrc->parent->position.y + origSrc->position.y
                 };
-                std::cerr << "    Source port absolute position: (" << sourcePoint.x << ", " << sourcePoint.y << ")\n";
-                bendPoints.insert(bendPoints.begin(), sourcePoint);
+                ELK_TRACE_DEBUG("    Source port absolute position: (" << sourcePoint.x << ", " << sourcePoint.y << ")\n");
 
                 // Add target port absolute anchor using ORIGINAL port
                 Port* origTgt = tgtPort->originalPort;
@@ -1058,37 +1329,43 @@ void LayeredLayoutProvider::applyLayout(const std::vector<LNode*>& nodes, const
                         LEdge* outEdge = tgtPort->outgoingEdges.front();
                         if (outEdge->getTarget()) {
                             origTgt = outEdge->getTarget()->originalPort;
-                            std::cerr << "    Traced dummy target forward to original port\n";
+                            ELK_TRACE_DEBUG("    Traced dummy target forward to original port\n");
                         }
                     }
                 }
 
                 if (!origTgt) {
-                    std::cerr << "    WARNING: Target LPort has no originalPort pointer, skipping edge " << ledge->originalEdge->id << "\n";
+                    ELK_TRACE_WARN("    WARNING: Target LPort has no originalPort pointer, skipping edge " << ledge->originalEdge->id << "\n");
                     continue;
                 }
                 if (!origTgt->parent) {
-                    std::cerr << "    WARNING: Target originalPort has no parent (port id=" << origTgt->id << "), skipping edge " << ledge->originalEdge->id << "\n";
+                    ELK_TRACE_WARN("    WARNING: Target originalPort has no parent (port id=" << origTgt->id << "), skipping edge " << ledge->originalEdge->id << "\n");
                     continue;
                 }
                 Point targetPoint{
                     origTgt->parent->position.x + origTgt->position.x,
                     origTgt->parent->position.y + origTgt->position.y
                 };
-                std::cerr << "    Target port absolute position: (" << targetPoint.x << ", " << targetPoint.y << ")\n";
-                bendPoints.push_back(targetPoint);
+                ELK_TRACE_DEBUG("    Target port absolute position: (" << targetPoint.x << ", " << targetPoint.y << ")\n");
 
-                // Create edge section with bendPoints (Java lines 273-276)
-                EdgeSection section;
-                section.startPoint = bendPoints.front();
-                section.endPoint = bendPoints.back();
+                // Create edge section with bendPoints (Java lines 273-276), built in place
+                Edge* net = ledge->originalEdge;
+                EdgeSection& section = net->sections.emplace_back();
+                section.startPoint = sourcePoint;
+                section.endPoint = targetPoint;
 
-                // Copy intermediate bendPoints (exclude start and end)
-                if (bendPoints.size() > 2) {
-                    section.bendPoints.assign(bendPoints.begin() + 1, bendPoints.end() - 1);
+                // Transform bend points from layered graph space to original graph space
+                // by adding the graphPadding offset
+                section.bendPoints.reserve(ledge->bendPoints.size());
+                for (const Point& bp : ledge->bendPoints) {
+                    section.bendPoints.push_back({bp.x + graphPadding, bp.y + graphPadding});
                 }
 
-                ledge->originalEdge->sections = {section};
+                // Sections of a net name the terminals they connect
+                if (net->isHyperedge()) {
+                    section.setIncomingPort(origSrc);
+                    section.setOutgoingPort(origTgt);
+                }
             }
         }
     }
@@ -1121,23 +1398,9 @@ void LayeredLayoutProvider::calculateGraphSize(Node* graph, const std::vector<LN
     graph->size.height = maxY + (2 * graphPadding);
 }
 
-void LayeredLayoutProvider::cleanup(std::vector<LNode*>& nodes, std::vector<LEdge*>& edges) {
-    // Delete ports first
-    for (LNode* node : nodes) {
-        for (LPort* port : node->ports) {
-            delete port;
-        }
-    }
-
-    // Delete nodes
-    for (LNode* node : nodes) {
-        delete node;
-    }
-
-    // Delete edges
-    for (LEdge* edge : edges) {
-        delete edge;
-    }
+void LayeredLayoutProvider::cleanup(LayoutSession& session) {
+    // The graph's pools free every node, port and edge at once
+    session.graph.clear();
 }
 
 // ============================================================================
@@ -1145,27 +1408,27 @@ void LayeredLayoutProvider::cleanup(std::vector<LNode*>& nodes, std::vector<LEdg
 // Source: org.eclipse.elk.alg.layered.p4nodes.LinearSegmentsNodePlacer
 // ============================================================================
 
-std::vector<LinearSegment*> LayeredLayoutProvider::sortLinearSegments(std::vector<Layer>& layers) {
-    std::cerr << "\n=== SORT LINEAR SEGMENTS ===\n";
+void LayeredLayoutProvider::sortLinearSegments(LayoutSession& session) {
+    ELK_TRACE_INFO("\n=== SORT LINEAR SEGMENTS ===\n");
+
+    std::vector<Layer>& layers = session.layers;
+    std::vector<LinearSegment*>& segmentList = session.segments;
 
     // Step 1: Set identifier and input/output priority for all nodes (Java lines 217-236)
-    std::vector<LinearSegment*> segmentList;
     for (Layer& layer : layers) {
         for (LNode* node : layer.nodes) {
             node->segmentId = -1;
             int inprio = INT_MIN, outprio = INT_MIN;
 
-            for (LPort* port : node->ports) {
-                for (LEdge* edge : port->incomingEdges) {
-                    // PRIORITY_STRAIGHTNESS default is 0 (LayeredOptions.java)
-                    // In netlistsvg, edges don't have priority property, so use default
-                    int prio = 0;  // edge->getProperty(PRIORITY_STRAIGHTNESS) would be 0
-                    inprio = std::max(inprio, prio);
-                }
-                for (LEdge* edge : port->outgoingEdges) {
-                    int prio = 0;  // Default PRIORITY_STRAIGHTNESS
-                    outprio = std::max(outprio, prio);
-                }
+            // PRIORITY_STRAIGHTNESS default is 0 (LayeredOptions.java)
+            // In netlistsvg, edges don't have priority property, so use default
+            if (!session.adjacency.incoming(node->graphIndex).empty()) {
+                int prio = 0;  // edge->getProperty(PRIORITY_STRAIGHTNESS) would be 0
+                inprio = std::max(inprio, prio);
+            }
+            if (!session.adjacency.outgoing(node->graphIndex).empty()) {
+                int prio = 0;  // Default PRIORITY_STRAIGHTNESS
+                outprio = std::max(outprio, prio);
             }
 
             node->inputPriority = inprio;
@@ -1179,27 +1442,33 @@ std::vector<LinearSegment*> LayeredLayoutProvider::sortLinearSegments(std::vecto
         for (LNode* node : layer.nodes) {
             // Test for node ID; fillSegment calls may have set it
             if (node->segmentId < 0) {
-                LinearSegment* segment = new LinearSegment();
-                segment->id = nextLinearSegmentID++;
-                fillSegment(node, segment);
+                LinearSegment* segment = session.newSegment(nextLinearSegmentID++);
+                fillSegment(node, segment, session.adjacency);
                 segmentList.push_back(segment);
 
-                std::cerr << "  Segment " << segment->id << ": " << segment->nodes.size() << " nodes, type=" << (int)segment->nodeType << "\n";
+                ELK_TRACE_DEBUG("  Segment " << segment->id << ": " << segment->nodes.size() << " nodes, type=" << (int)segment->nodeType << "\n");
             }
         }
     }
 
-    std::cerr << "Created " << segmentList.size() << " linear segments\n";
+    ELK_TRACE_INFO("Created " << segmentList.size() << " linear segments\n");
 
     // Step 3: Create and initialize segment ordering graph (Java lines 253-259)
-    std::vector<std::vector<LinearSegment*>> outgoingList(segmentList.size());
-    std::vector<int> incomingCountList(segmentList.size(), 0);
+    // (successor lists are cleared between runs but kept allocated)
+    std::vector<std::vector<LinearSegment*>>& outgoingList = session.segmentSuccessors;
+    std::vector<int>& incomingCountList = session.segmentPredecessorCounts;
+    if (outgoingList.size() < segmentList.size()) {
+        outgoingList.resize(segmentList.size());
+    }
+    incomingCountList.assign(segmentList.size(), 0);
 
     // Step 4: Create edges for segment ordering graph (Java line 262)
-    createDependencyGraphEdges(layers, segmentList, outgoingList, incomingCountList, nextLinearSegmentID);
+    createDependencyGraphEdges(session, nextLinearSegmentID);
 
     // Step 5: Gather sources of segment ordering graph (Java lines 276-282)
-    std::vector<LinearSegment*> noIncoming;
+    // A vector walked from the front keeps its capacity for the next run
+    std::vector<LinearSegment*>& noIncoming = session.segmentQueue;
+    noIncoming.clear();
     for (size_t i = 0; i < segmentList.size(); ++i) {
         if (incomingCountList[i] == 0) {
             noIncoming.push_back(segmentList[i]);
@@ -1208,26 +1477,27 @@ std::vector<LinearSegment*> LayeredLayoutProvider::sortLinearSegments(std::vecto
 
     // Step 6: Topological sort (Java lines 284-298)
     int nextRank = 0;
-    std::vector<int> newRanks(segmentList.size());
+    std::vector<int>& newRanks = session.segmentRanks;
+    newRanks.assign(segmentList.size(), 0);
 
-    while (!noIncoming.empty()) {
-        LinearSegment* segment = noIncoming.front();
-        noIncoming.erase(noIncoming.begin());
+    for (std::size_t next = 0; next < noIncoming.size(); next++) {
+        LinearSegment* segment = noIncoming[next];
         newRanks[segment->id] = nextRank++;
 
-        while (!outgoingList[segment->id].empty()) {
-            LinearSegment* target = outgoingList[segment->id].front();
-            outgoingList[segment->id].erase(outgoingList[segment->id].begin());
+        std::vector<LinearSegment*>& successors = outgoingList[segment->id];
+        for (LinearSegment* target : successors) {
             incomingCountList[target->id]--;
 
             if (incomingCountList[target->id] == 0) {
                 noIncoming.push_back(target);
             }
         }
+        successors.clear();
     }
 
     // Step 7: Apply new ordering (Java lines 300-311)
-    std::vector<LinearSegment*> sortedSegments(segmentList.size());
+    std::vector<LinearSegment*>& sortedSegments = session.sortedSegments;
+    sortedSegments.assign(segmentList.size(), nullptr);
     for (size_t i = 0; i < segmentList.size(); ++i) {
         LinearSegment* ls = segmentList[i];
         int rank = newRanks[i];
@@ -1238,11 +1508,10 @@ std::vector<LinearSegment*> LayeredLayoutProvider::sortLinearSegments(std::vecto
         }
     }
 
-    std::cerr << "Sorted " << sortedSegments.size() << " segments\n";
-    return sortedSegments;
+    ELK_TRACE_INFO("Sorted " << sortedSegments.size() << " segments\n");
 }
 
-bool LayeredLayoutProvider::fillSegment(LNode* node, LinearSegment* segment) {
+bool LayeredLayoutProvider::fillSegment(LNode* node, LinearSegment* segment, const LAdjacency& adjacency) {
     // Faithful port from Java lines 461-505
     NodeType nodeType = node->type;
 
@@ -1256,11 +1525,16 @@ bool LayeredLayoutProvider::fillSegment(LNode* node, LinearSegment* segment) {
     }
     segment->nodeType = nodeType;
 
-    // For LONG_EDGE and NORTH_SOUTH_PORT dummies, try to extend segment (Java lines 474-502)
-    if (nodeType == NodeType::LONG_EDGE || nodeType == NodeType::NORTH_SOUTH_PORT) {
-        for (LPort* sourcePort : node->ports) {
+    // For LONG_EDGE and NORTH_SOUTH_PORT dummies, try to extend segment (Java lines 474-502).
+    // A long-edge slot's only dummy successor is the next slot of its chain.
+    if (node->longEdge) {
+        if (LNode* next = node->longEdge->next(node)) {
+            fillSegment(next, segment, adjacency);
+        }
+    } else if (nodeType == NodeType::LONG_EDGE || nodeType == NodeType::NORTH_SOUTH_PORT) {
+        for (LPort* sourcePort : adjacency.ports(node->graphIndex)) {
             // Get successor ports (ports connected via outgoing edges)
-            for (LEdge* edge : sourcePort->outgoingEdges) {
+            for (LEdge* edge : adjacency.portOutgoing(sourcePort->graphIndex)) {
                 LPort* targetPort = edge->target;
                 if (!targetPort) continue;
 
@@ -1274,7 +1548,7 @@ bool LayeredLayoutProvider::fillSegment(LNode* node, LinearSegment* segment) {
                     // Check if target is also LONG_EDGE or NORTH_SOUTH_PORT (Java lines 491-492)
                     if (targetNodeType == NodeType::LONG_EDGE ||
                         targetNodeType == NodeType::NORTH_SOUTH_PORT) {
-                        if (fillSegment(targetNode, segment)) {
+                        if (fillSegment(targetNode, segment, adjacency)) {
                             // Added another node to segment
                             return true;
                         }
@@ -1287,15 +1561,14 @@ bool LayeredLayoutProvider::fillSegment(LNode* node, LinearSegment* segment) {
     return true;
 }
 
-void LayeredLayoutProvider::createDependencyGraphEdges(
-        std::vector<Layer>& layers,
-        std::vector<LinearSegment*>& segmentList,
-        std::vector<std::vector<LinearSegment*>>& outgoingList,
-        std::vector<int>& incomingCountList,
-        int& nextLinearSegmentID) {
+void LayeredLayoutProvider::createDependencyGraphEdges(LayoutSession& session, int& nextLinearSegmentID) {
+    std::vector<Layer>& layers = session.layers;
+    std::vector<LinearSegment*>& segmentList = session.segments;
+    std::vector<std::vector<LinearSegment*>>& outgoingList = session.segmentSuccessors;
+    std::vector<int>& incomingCountList = session.segmentPredecessorCounts;
 
     // Faithful port from Java lines 332-449
-    std::cerr << "Creating dependency graph edges\n";
+    ELK_TRACE_DEBUG("Creating dependency graph edges\n");
 
     int layerIndex = 0;
     for (Layer& layer : layers) {
@@ -1332,15 +1605,20 @@ void LayeredLayoutProvider::createDependencyGraphEdges(
                     // Update dependencies before split
                     if (previousNode != nullptr) {
                         incomingCountList[currentNode->segmentId]--;
+                        // Segments adjacent in several layers depend on each other
+                        // once per layer; drop only this layer's dependency, as
+                        // Java's List.remove does
                         auto& prevOut = outgoingList[previousNode->segmentId];
-                        prevOut.erase(std::remove(prevOut.begin(), prevOut.end(), currentSegment),
-                                     prevOut.end());
+                        prevOut.erase(std::find(prevOut.begin(), prevOut.end(), currentSegment));
                     }
 
                     // Split segment at current node
-                    LinearSegment* newSegment = currentSegment->split(currentNode, nextLinearSegmentID++);
+                    LinearSegment* newSegment = currentSegment->split(
+                        currentNode, session.newSegment(nextLinearSegmentID++));
                     segmentList.push_back(newSegment);
-                    outgoingList.push_back(std::vector<LinearSegment*>());
+                    if (outgoingList.size() < segmentList.size()) {
+                        outgoingList.resize(segmentList.size());
+                    }
 
                     if (previousNode != nullptr) {
                         outgoingList[previousNode->segmentId].push_back(newSegment);
@@ -1373,22 +1651,24 @@ void LayeredLayoutProvider::createDependencyGraphEdges(
     }
 }
 
-void LayeredLayoutProvider::createUnbalancedPlacement(
-        std::vector<Layer>& layers,
-        const std::vector<LinearSegment*>& linearSegments) {
+void LayeredLayoutProvider::createUnbalancedPlacement(LayoutSession& session) {
+    std::vector<Layer>& layers = session.layers;
+    const std::vector<LinearSegment*>& linearSegments = session.sortedSegments;
 
     // Faithful port from Java lines 516-559
-    std::cerr << "\n=== CREATE UNBALANCED PLACEMENT ===\n";
+    ELK_TRACE_INFO("\n=== CREATE UNBALANCED PLACEMENT ===\n");
 
     // Track how many nodes are placed in each layer (Java line 518)
-    std::vector<int> nodeCount(layers.size(), 0);
+    std::vector<int>& nodeCount = session.placedCounts;
+    nodeCount.assign(layers.size(), 0);
 
-    // Track most recent node type and node in each layer (Java lines 521-522)
-    std::vector<NodeType> recentNodeType(layers.size(), NodeType::NORMAL);
-    std::vector<LNode*> recentNode(layers.size(), nullptr);
+    // Track most recent node in each layer (Java lines 521-522)
+    std::vector<LNode*>& recentNode = session.recentNodes;
+    recentNode.assign(layers.size(), nullptr);
 
     // Track layer size (accumulated Y in each layer) - Java uses layer.getSize().y
-    std::vector<double> layerSize(layers.size(), 0.0);
+    std::vector<double>& layerSize = session.layerExtents;
+    layerSize.assign(layers.size(), 0.0);
 
     // Iterate through linear segments in sorted order (Java line 525)
     for (LinearSegment* segment : linearSegments) {
@@ -1429,15 +1709,14 @@ void LayeredLayoutProvider::createUnbalancedPlacement(
             // layer.getSize().y = uppermostPlace + margin.top + node.size + margin.bottom
             layerSize[layerIndex] = uppermostPlace + node->margin.top + node->size.height + node->margin.bottom;
 
-            recentNodeType[layerIndex] = node->type;
             recentNode[layerIndex] = node;
 
-            std::cerr << "  Segment " << segment->id << ", node at layer " << layerIndex
-                      << ", Y=" << node->position.y << ", layerSize=" << layerSize[layerIndex] << "\n";
+            ELK_TRACE_DEBUG("  Segment " << segment->id << ", node at layer " << layerIndex
+                            << ", Y=" << node->position.y << ", layerSize=" << layerSize[layerIndex] << "\n");
         }
     }
 
-    std::cerr << "Unbalanced placement complete\n";
+    ELK_TRACE_INFO("Unbalanced placement complete\n");
 }
 
 } // namespace layered
@@ -0,0 +1,141 @@
+// Eclipse Layout Kernel - C++ Port
+// Layout session implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/alg/layered/layout_session.h"
+
+namespace elk {
+namespace layered {
+
+void LayoutSession::reset() {
+    graph.clear();
+    resizeLayers(0);
+    adjacency.clear();
+
+    portMap.clear();
+
+    indegree.clear();
+    outdegree.clear();
+    mark.clear();
+    sources.clear();
+    sinks.clear();
+    bucketFirst.clear();
+    bucketLast.clear();
+    bucketNext.clear();
+    bucketPrevious.clear();
+    reversedEdges.clear();
+
+    heights.clear();
+    unplacedSuccessors.clear();
+    layeringQueue.clear();
+
+    longEdges.clear();
+    chainsInUse = 0;
+    barycenters.clear();
+    sortedLayer.clear();
+    order.clear();
+
+    segmentsInUse = 0;
+    segments.clear();
+    sortedSegments.clear();
+    for (auto& successors : segmentSuccessors) {
+        successors.clear();
+    }
+    segmentPredecessorCounts.clear();
+    segmentRanks.clear();
+    segmentQueue.clear();
+    placedCounts.clear();
+    recentNodes.clear();
+    layerExtents.clear();
+    layerWidths.clear();
+}
+
+void LayoutSession::shrink() {
+    reset();
+    graph.shrink();
+    layers.shrink_to_fit();
+    spareLayerNodes.clear();
+    spareLayerNodes.shrink_to_fit();
+    adjacency.shrink();
+    portMap.shrink_to_fit();
+    indegree.shrink_to_fit();
+    outdegree.shrink_to_fit();
+    mark.shrink_to_fit();
+    sources.shrink_to_fit();
+    sinks.shrink_to_fit();
+    bucketFirst.shrink_to_fit();
+    bucketLast.shrink_to_fit();
+    bucketNext.shrink_to_fit();
+    bucketPrevious.shrink_to_fit();
+    reversedEdges.shrink_to_fit();
+    heights.shrink_to_fit();
+    unplacedSuccessors.shrink_to_fit();
+    layeringQueue.shrink_to_fit();
+    networkSimplex.shrink();
+    coffmanGraham.shrink();
+    nodePromotion.shrink();
+    longEdges.shrink_to_fit();
+    chainPool.clear();
+    chainPool.shrink_to_fit();
+    barycenters.shrink_to_fit();
+    sortedLayer.shrink_to_fit();
+    order.shrink_to_fit();
+    segmentPool.clear();
+    segmentPool.shrink_to_fit();
+    segments.shrink_to_fit();
+    sortedSegments.shrink_to_fit();
+    segmentSuccessors.clear();
+    segmentSuccessors.shrink_to_fit();
+    segmentPredecessorCounts.shrink_to_fit();
+    segmentRanks.shrink_to_fit();
+    segmentQueue.shrink_to_fit();
+    placedCounts.shrink_to_fit();
+    recentNodes.shrink_to_fit();
+    layerExtents.shrink_to_fit();
+    layerWidths.shrink_to_fit();
+    routingGenerator.shrink();
+}
+
+void LayoutSession::resizeLayers(std::size_t count) {
+    // Park the node vectors of dropped layers instead of freeing them
+    while (layers.size() > count) {
+        std::vector<LNode*> parked = std::move(layers.back().nodes);
+        parked.clear();
+        spareLayerNodes.push_back(std::move(parked));
+        layers.pop_back();
+    }
+    while (layers.size() < count) {
+        layers.emplace_back();
+        if (!spareLayerNodes.empty()) {
+            layers.back().nodes = std::move(spareLayerNodes.back());
+            spareLayerNodes.pop_back();
+        }
+    }
+}
+
+LinearSegment* LayoutSession::newSegment(int id) {
+    if (segmentsInUse == segmentPool.size()) {
+        segmentPool.push_back(std::make_unique<LinearSegment>());
+    }
+    LinearSegment* segment = segmentPool[segmentsInUse++].get();
+    std::vector<LNode*> kept = std::move(segment->nodes);
+    kept.clear();
+    *segment = LinearSegment();
+    segment->nodes = std::move(kept);
+    segment->id = id;
+    return segment;
+}
+
+LongEdgeChain* LayoutSession::newChain(LPort* source, int firstLayer) {
+    if (chainsInUse == chainPool.size()) {
+        chainPool.push_back(std::make_unique<LongEdgeChain>());
+    }
+    LongEdgeChain* chain = chainPool[chainsInUse++].get();
+    chain->slots.clear();
+    chain->source = source;
+    chain->firstLayer = firstLayer;
+    return chain;
+}
+
+} // namespace layered
+} // namespace elk
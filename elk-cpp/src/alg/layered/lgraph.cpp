@@ -3,9 +3,9 @@
 // SPDX-License-Identifier: EPL-2.0
 
 #include "elk/alg/layered/lgraph.h"
+#include "elk/core/trace.h"
 #include <algorithm>
 #include <stdexcept>
-#include <iostream>
 
 namespace elk {
 namespace layered {
@@ -14,6 +14,20 @@ namespace layered {
 // LNode Implementation
 // ============================================================================
 
+void LNode::reset() {
+    std::vector<LPort*> keptPorts = std::move(ports);
+    std::vector<LLabel> keptLabels = std::move(labels);
+    auto keptSideIndices = std::move(portSideIndices);
+    keptPorts.clear();
+    keptLabels.clear();
+    keptSideIndices.clear();
+    clearProperties();
+    *this = LNode();
+    ports = std::move(keptPorts);
+    labels = std::move(keptLabels);
+    portSideIndices = std::move(keptSideIndices);
+}
+
 void LNode::setLayer(Layer* l) {
     if (layer != nullptr) {
         auto& layerNodes = layer->getNodes();
@@ -145,7 +159,7 @@ std::string LNode::getDesignation() const {
         return labels[0].getText();
     }
     if (!id.empty()) {
-        return id;
+        return id.str();
     }
     return std::to_string(getIndex());
 }
@@ -154,9 +168,24 @@ std::string LNode::getDesignation() const {
 // LPort Implementation
 // ============================================================================
 
+void LPort::reset() {
+    std::vector<LLabel> keptLabels = std::move(labels);
+    std::vector<LEdge*> keptIncoming = std::move(incomingEdges);
+    std::vector<LEdge*> keptOutgoing = std::move(outgoingEdges);
+    keptLabels.clear();
+    keptIncoming.clear();
+    keptOutgoing.clear();
+    clearProperties();
+    *this = LPort();
+    labels = std::move(keptLabels);
+    incomingEdges = std::move(keptIncoming);
+    outgoingEdges = std::move(keptOutgoing);
+}
+
 void LPort::setNode(LNode* n) {
     if (node != nullptr) {
-        node->getPorts().remove(this);
+        auto& ports = node->getPorts();
+        ports.erase(std::remove(ports.begin(), ports.end(), this), ports.end());
     }
 
     node = n;
@@ -202,10 +231,10 @@ Point LPort::getAbsoluteAnchor() const {
         node->getPosition().x + position.x + anchor.x,
         node->getPosition().y + position.y + anchor.y
     };
-    std::cerr << "      LPort::getAbsoluteAnchor: node=(" << node->getPosition().x << "," << node->getPosition().y
-              << ") port=(" << position.x << "," << position.y
-              << ") anchor=(" << anchor.x << "," << anchor.y
-              << ") result=(" << result.x << "," << result.y << ")\n";
+    ELK_TRACE_DEBUG("      LPort::getAbsoluteAnchor: node=(" << node->getPosition().x << "," << node->getPosition().y
+                    << ") port=(" << position.x << "," << position.y
+                    << ") anchor=(" << anchor.x << "," << anchor.y
+                    << ") result=(" << result.x << "," << result.y << ")\n");
     return result;
 }
 
@@ -246,7 +275,7 @@ std::string LPort::getDesignation() const {
         return labels[0].getText();
     }
     if (!id.empty()) {
-        return id;
+        return id.str();
     }
     return std::to_string(getIndex());
 }
@@ -255,9 +284,24 @@ std::string LPort::getDesignation() const {
 // LEdge Implementation
 // ============================================================================
 
+void LEdge::reset() {
+    std::vector<Point> keptBendPoints = std::move(bendPoints);
+    std::vector<Point> keptJunctionPoints = std::move(junctionPoints);
+    std::vector<LLabel> keptLabels = std::move(labels);
+    keptBendPoints.clear();
+    keptJunctionPoints.clear();
+    keptLabels.clear();
+    clearProperties();
+    *this = LEdge();
+    bendPoints = std::move(keptBendPoints);
+    junctionPoints = std::move(keptJunctionPoints);
+    labels = std::move(keptLabels);
+}
+
 void LEdge::setSource(LPort* src) {
     if (source != nullptr) {
-        source->getOutgoingEdges().remove(this);
+        auto& edges = source->getOutgoingEdges();
+        edges.erase(std::remove(edges.begin(), edges.end(), this), edges.end());
     }
 
     source = src;
@@ -273,7 +317,8 @@ void LEdge::setSource(LPort* src) {
 
 void LEdge::setTarget(LPort* tgt) {
     if (target != nullptr) {
-        target->getIncomingEdges().remove(this);
+        auto& edges = target->getIncomingEdges();
+        edges.erase(std::remove(edges.begin(), edges.end(), this), edges.end());
     }
 
     target = tgt;
@@ -285,16 +330,15 @@ void LEdge::setTarget(LPort* tgt) {
 
 void LEdge::setTargetAndInsertAtIndex(LPort* tgt, int index) {
     if (target != nullptr) {
-        target->getIncomingEdges().remove(this);
+        auto& edges = target->getIncomingEdges();
+        edges.erase(std::remove(edges.begin(), edges.end(), this), edges.end());
     }
 
     target = tgt;
 
     if (target != nullptr) {
         auto& edges = target->getIncomingEdges();
-        auto it = edges.begin();
-        std::advance(it, index);
-        edges.insert(it, this);
+        edges.insert(edges.begin() + index, this);
     }
 }
 
@@ -357,8 +401,7 @@ void LEdge::reverse(LGraph* graph, bool adaptPorts) {
     setTarget(oldSource);
 
     // Reverse REVERSED property
-    bool reversed = hasProperty("REVERSED") ? getProperty<bool>("REVERSED") : false;
-    setProperty("REVERSED", !reversed);
+    setProperty(LayoutOptions::REVERSED, !getProperty(LayoutOptions::REVERSED));
 
     // Reverse bend points
     std::reverse(bendPoints.begin(), bendPoints.end());
@@ -370,7 +413,88 @@ std::string LEdge::getDesignation() const {
     if (!labels.empty() && !labels[0].getText().empty()) {
         return labels[0].getText();
     }
-    return id;
+    return id.str();
+}
+
+// ============================================================================
+// LAdjacency Implementation
+// ============================================================================
+
+void LAdjacency::build(const std::vector<LNode*>& nodes) {
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i]->graphIndex = static_cast<int>(i);
+    }
+
+    clear();
+    inStart.reserve(nodes.size() + 1);
+    outStart.reserve(nodes.size() + 1);
+    portStart.reserve(nodes.size() + 1);
+    inStart.push_back(0);
+    outStart.push_back(0);
+    portStart.push_back(0);
+    portInStart.push_back(0);
+    portOutStart.push_back(0);
+    for (LNode* node : nodes) {
+        for (LPort* port : node->ports) {
+            port->graphIndex = static_cast<int>(portList.size());
+            portList.push_back(port);
+            for (LEdge* edge : port->incomingEdges) {
+                inNodes.push_back(edge->getSource()->getNode()->graphIndex);
+                portInEdges.push_back(edge);
+            }
+            portInStart.push_back(static_cast<int>(portInEdges.size()));
+        }
+        portStart.push_back(static_cast<int>(portList.size()));
+        if (inNodes.size() == static_cast<std::size_t>(inStart.back()) && node->longEdge) {
+            inNodes.push_back(node->longEdge->previous(node)->graphIndex);
+        }
+        inStart.push_back(static_cast<int>(inNodes.size()));
+
+        for (LPort* port : node->ports) {
+            for (LEdge* edge : port->outgoingEdges) {
+                outNodes.push_back(edge->getTarget()->getNode()->graphIndex);
+                outEdges.push_back(edge);
+                portOutEdges.push_back(edge);
+            }
+            portOutStart.push_back(static_cast<int>(portOutEdges.size()));
+        }
+        if (outNodes.size() == static_cast<std::size_t>(outStart.back()) && node->longEdge) {
+            if (LNode* next = node->longEdge->next(node)) {
+                outNodes.push_back(next->graphIndex);
+                outEdges.push_back(nullptr);
+            }
+        }
+        outStart.push_back(static_cast<int>(outNodes.size()));
+    }
+}
+
+void LAdjacency::clear() {
+    inStart.clear();
+    inNodes.clear();
+    outStart.clear();
+    outNodes.clear();
+    outEdges.clear();
+    portStart.clear();
+    portList.clear();
+    portInStart.clear();
+    portInEdges.clear();
+    portOutStart.clear();
+    portOutEdges.clear();
+}
+
+void LAdjacency::shrink() {
+    clear();
+    inStart.shrink_to_fit();
+    inNodes.shrink_to_fit();
+    outStart.shrink_to_fit();
+    outNodes.shrink_to_fit();
+    outEdges.shrink_to_fit();
+    portStart.shrink_to_fit();
+    portList.shrink_to_fit();
+    portInStart.shrink_to_fit();
+    portInEdges.shrink_to_fit();
+    portOutStart.shrink_to_fit();
+    portOutEdges.shrink_to_fit();
 }
 
 // ============================================================================
@@ -378,17 +502,22 @@ std::string LEdge::getDesignation() const {
 // ============================================================================
 
 LNode* LGraph::addNode() {
-    auto node = std::make_unique<LNode>(this);
-    LNode* ptr = node.get();
-    lnodes.push_back(std::move(node));
-    return ptr;
+    LNode* node = nodePool.create();
+    node->graph = this;
+    lnodes.push_back(node);
+    return node;
+}
+
+LPort* LGraph::addPort(LNode* node) {
+    LPort* port = portPool.create();
+    port->node = node;
+    return port;
 }
 
 LEdge* LGraph::addEdge() {
-    auto edge = std::make_unique<LEdge>();
-    LEdge* ptr = edge.get();
-    ledges.push_back(std::move(edge));
-    return ptr;
+    LEdge* edge = edgePool.create();
+    ledges.push_back(edge);
+    return edge;
 }
 
 Layer* LGraph::addLayer() {
@@ -418,5 +547,24 @@ Layer* LGraph::addLayer(int index) {
     return ptr;
 }
 
+void LGraph::clear() {
+    lnodes.clear();
+    ledges.clear();
+    layers.clear();
+    nodePool.reset();
+    portPool.reset();
+    edgePool.reset();
+}
+
+void LGraph::shrink() {
+    clear();
+    lnodes.shrink_to_fit();
+    ledges.shrink_to_fit();
+    layers.shrink_to_fit();
+    nodePool.shrink();
+    portPool.shrink();
+    edgePool.shrink();
+}
+
 } // namespace layered
 } // namespace elk
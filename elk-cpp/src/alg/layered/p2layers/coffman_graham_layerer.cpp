@@ -0,0 +1,180 @@
+// Eclipse Layout Kernel - C++ Port
+// Coffman-Graham layer assignment implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/alg/layered/p2layers/coffman_graham_layerer.h"
+#include <algorithm>
+
+namespace elk {
+namespace layered {
+namespace p2layers {
+
+void CoffmanGrahamLayerer::process(const std::vector<LNode*>& nodes, const LAdjacency& adjacency, int layerBound) {
+    nodeCount_ = static_cast<int>(nodes.size());
+    if (nodeCount_ == 0) return;
+
+    reduceTransitiveEdges(adjacency);
+    orderTopologically();
+    int layerCount = assignLayers(std::max(layerBound, 1));
+
+    // Layers were filled from the sinks
+    for (int i = 0; i < nodeCount_; i++) {
+        nodes[i]->layerIndex = layerCount - 1 - layerFromSinks_[i];
+    }
+}
+
+void CoffmanGrahamLayerer::shrink() {
+    for (std::vector<int>* array : {&successorStart_, &successors_, &predecessorStart_, &predecessors_, &number_,
+                                    &byNumber_, &predecessorNumbers_, &numberedPredecessors_, &remaining_,
+                                    &layerFromSinks_, &nearestSuccessor_, &seen_, &skipped_, &candidates_, &ready_}) {
+        std::vector<int>().swap(*array);
+    }
+}
+
+void CoffmanGrahamLayerer::reduceTransitiveEdges(const LAdjacency& adjacency) {
+    // Keep each distinct edge u -> w unless some other successor v of u
+    // has an edge v -> w
+    int n = nodeCount_;
+    seen_.assign(n, -1);
+    skipped_.assign(n, -1);
+    successorStart_.assign(n + 1, 0);
+    successors_.clear();
+    for (int node = 0; node < n; node++) {
+        successorStart_[node] = static_cast<int>(successors_.size());
+        candidates_.clear();
+        for (int target : adjacency.outgoing(node)) {
+            if (target == node || seen_[target] == node) continue;
+            seen_[target] = node;
+            candidates_.push_back(target);
+        }
+        for (int middle : candidates_) {
+            for (int target : adjacency.outgoing(middle)) {
+                if (target != middle && seen_[target] == node) skipped_[target] = node;
+            }
+        }
+        for (int target : candidates_) {
+            if (skipped_[target] != node) successors_.push_back(target);
+        }
+    }
+    successorStart_[n] = static_cast<int>(successors_.size());
+
+    // Predecessor rows by counting sort on the target
+    predecessorStart_.assign(n + 1, 0);
+    for (int target : successors_) {
+        predecessorStart_[target + 1]++;
+    }
+    for (int node = 0; node < n; node++) {
+        predecessorStart_[node + 1] += predecessorStart_[node];
+    }
+    predecessors_.resize(successors_.size());
+    remaining_.assign(n, 0);
+    for (int node = 0; node < n; node++) {
+        for (int k = successorStart_[node]; k < successorStart_[node + 1]; k++) {
+            int target = successors_[k];
+            predecessors_[predecessorStart_[target] + remaining_[target]++] = node;
+        }
+    }
+}
+
+bool CoffmanGrahamLayerer::numberedAfter(int a, int b) const {
+    // Compare the predecessor numbers from the highest down; a list that
+    // runs out first is smaller, and equal lists go by node index
+    int i = numberedPredecessors_[a];
+    int j = numberedPredecessors_[b];
+    const int* numbersA = predecessorNumbers_.data() + predecessorStart_[a];
+    const int* numbersB = predecessorNumbers_.data() + predecessorStart_[b];
+    while (i > 0 && j > 0) {
+        int numberA = numbersA[--i];
+        int numberB = numbersB[--j];
+        if (numberA != numberB) return numberA > numberB;
+    }
+    if (i == 0 && j == 0) return a > b;
+    return j == 0;
+}
+
+void CoffmanGrahamLayerer::orderTopologically() {
+    int n = nodeCount_;
+    number_.assign(n, -1);
+    byNumber_.assign(n, -1);
+    predecessorNumbers_.assign(predecessors_.size(), 0);
+    numberedPredecessors_.assign(n, 0);
+
+    // Heap of the nodes whose predecessors are all numbered, the next one
+    // to number on top
+    auto after = [this](int a, int b) { return numberedAfter(a, b); };
+    ready_.clear();
+    for (int node = 0; node < n; node++) {
+        remaining_[node] = predecessorStart_[node + 1] - predecessorStart_[node];
+        if (remaining_[node] == 0) ready_.push_back(node);
+    }
+    std::make_heap(ready_.begin(), ready_.end(), after);
+
+    int next = 0;
+    while (!ready_.empty()) {
+        std::pop_heap(ready_.begin(), ready_.end(), after);
+        int node = ready_.back();
+        ready_.pop_back();
+        number_[node] = next;
+        byNumber_[next] = node;
+        for (int k = successorStart_[node]; k < successorStart_[node + 1]; k++) {
+            int target = successors_[k];
+            predecessorNumbers_[predecessorStart_[target] + numberedPredecessors_[target]++] = next;
+            if (--remaining_[target] == 0) {
+                ready_.push_back(target);
+                std::push_heap(ready_.begin(), ready_.end(), after);
+            }
+        }
+        next++;
+    }
+}
+
+int CoffmanGrahamLayerer::assignLayers(int layerBound) {
+    // Heap of the nodes that may go into the current layer, keyed by the
+    // nearest layer of a successor and then by number, highest on top.
+    // Nodes whose last successor is placed in the current layer wait in
+    // candidates_ until the next one is started.
+    int n = nodeCount_;
+    layerFromSinks_.assign(n, -1);
+    nearestSuccessor_.assign(n, -1);
+    ready_.clear();
+    candidates_.clear();
+    for (int node = 0; node < n; node++) {
+        remaining_[node] = successorStart_[node + 1] - successorStart_[node];
+        if (remaining_[node] == 0) ready_.push_back(node);
+    }
+    auto placedLater = [this](int a, int b) {
+        if (nearestSuccessor_[a] != nearestSuccessor_[b]) return nearestSuccessor_[a] < nearestSuccessor_[b];
+        return number_[a] < number_[b];
+    };
+    std::make_heap(ready_.begin(), ready_.end(), placedLater);
+
+    int layer = 0;
+    int layerSize = 0;
+    while (!ready_.empty() || !candidates_.empty()) {
+        if (ready_.empty() || layerSize >= layerBound) {
+            for (int node : candidates_) {
+                ready_.push_back(node);
+                std::push_heap(ready_.begin(), ready_.end(), placedLater);
+            }
+            candidates_.clear();
+            layer++;
+            layerSize = 0;
+        }
+        std::pop_heap(ready_.begin(), ready_.end(), placedLater);
+        int node = ready_.back();
+        ready_.pop_back();
+        layerFromSinks_[node] = layer;
+        layerSize++;
+
+        for (int k = predecessorStart_[node]; k < predecessorStart_[node + 1]; k++) {
+            int source = predecessors_[k];
+            nearestSuccessor_[source] = layer;
+            if (--remaining_[source] == 0) candidates_.push_back(source);
+        }
+    }
+    return layer + 1;
+}
+
+} // namespace p2layers
+} // namespace layered
+} // namespace elk
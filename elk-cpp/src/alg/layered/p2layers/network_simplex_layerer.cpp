@@ -0,0 +1,501 @@
+// Eclipse Layout Kernel - C++ Port
+// Network simplex layer assignment implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/alg/layered/p2layers/network_simplex_layerer.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace elk {
+namespace layered {
+namespace p2layers {
+
+namespace {
+
+// Exchanges allowed per square root of a component's node count; ELK's
+// default thoroughness of 7 times its iteration limit factor of 4
+constexpr int EXCHANGES_PER_SQRT_NODES = 28;
+
+// Number of tree edges with negative cut value leaveEdge looks at before it
+// takes the most negative one
+constexpr int LEAVE_SEARCH_SIZE = 30;
+
+} // namespace
+
+void NetworkSimplexLayerer::process(const std::vector<LNode*>& nodes, const LAdjacency& adjacency) {
+    initialize(nodes, adjacency);
+    exchanges_ = 0;
+    if (nodeCount_ == 0) return;
+
+    initialRanking();
+    feasibleTree();
+    initCutValues();
+
+    // Pivot each component until no tree edge has a negative cut value or
+    // its exchange budget is spent
+    int first = 0;
+    for (std::size_t c = 0; c < componentRoots_.size(); c++) {
+        int last = componentEnds_[c];
+        int size = last - first + 1;
+        int limit = EXCHANGES_PER_SQRT_NODES * static_cast<int>(std::sqrt(static_cast<double>(size)));
+        searchStart_ = first;
+        for (int iteration = 0; iteration < limit; iteration++) {
+            int leaving = leaveEdge(first, last);
+            if (leaving < 0) break;
+            int entering = enterEdge(leaving);
+            if (entering < 0) break;
+            exchange(leaving, entering);
+            exchanges_++;
+        }
+        first = last;
+    }
+
+    normalize();
+    balance();
+    for (int i = 0; i < nodeCount_; i++) {
+        nodes[i]->layerIndex = rank_[i];
+    }
+}
+
+void NetworkSimplexLayerer::shrink() {
+    for (std::vector<int>* array : {&tail_, &head_, &cutValue_, &treeSlot_, &outStart_, &inStart_, &inEdges_,
+                                    &rank_, &treeAdjacency_, &treeCount_, &low_, &lim_, &parentEdge_, &component_,
+                                    &treeEdges_, &componentRoots_, &componentEnds_, &unionFind_, &treeSize_,
+                                    &stack_, &stackSlot_, &nodeList_, &filling_}) {
+        std::vector<int>().swap(*array);
+    }
+    std::vector<std::pair<int, int>>().swap(treeHeap_);
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+void NetworkSimplexLayerer::initialize(const std::vector<LNode*>& nodes, const LAdjacency& adjacency) {
+    nodeCount_ = static_cast<int>(nodes.size());
+    int n = nodeCount_;
+
+    // Out-edges are numbered by their source, so each node's are consecutive
+    tail_.clear();
+    head_.clear();
+    outStart_.assign(n + 1, 0);
+    for (int node = 0; node < n; node++) {
+        outStart_[node] = static_cast<int>(tail_.size());
+        for (int target : adjacency.outgoing(node)) {
+            if (target == node) continue;
+            tail_.push_back(node);
+            head_.push_back(target);
+        }
+    }
+    edgeCount_ = static_cast<int>(tail_.size());
+    outStart_[n] = edgeCount_;
+
+    // In-edges by counting sort on the target, with treeCount_ as cursor
+    inStart_.assign(n + 1, 0);
+    for (int edge = 0; edge < edgeCount_; edge++) {
+        inStart_[head_[edge] + 1]++;
+    }
+    for (int node = 0; node < n; node++) {
+        inStart_[node + 1] += inStart_[node];
+    }
+    inEdges_.resize(edgeCount_);
+    treeCount_.assign(n, 0);
+    for (int edge = 0; edge < edgeCount_; edge++) {
+        int target = head_[edge];
+        inEdges_[inStart_[target] + treeCount_[target]++] = edge;
+    }
+
+    cutValue_.assign(edgeCount_, 0);
+    treeSlot_.assign(edgeCount_, -1);
+    rank_.assign(n, 0);
+    treeAdjacency_.assign(2 * static_cast<std::size_t>(edgeCount_), -1);
+    treeCount_.assign(n, 0);
+    low_.assign(n, 0);
+    lim_.assign(n, 0);
+    parentEdge_.assign(n, -1);
+    component_.assign(n, -1);
+    treeEdges_.clear();
+    componentRoots_.clear();
+    componentEnds_.clear();
+}
+
+// ============================================================================
+// Feasible Tree
+// ============================================================================
+
+void NetworkSimplexLayerer::initialRanking() {
+    // Longest path from the sources, which makes every edge feasible
+    std::vector<int>& unranked = treeSize_;
+    std::vector<int>& ready = stack_;
+    unranked.assign(nodeCount_, 0);
+    ready.clear();
+    for (int node = 0; node < nodeCount_; node++) {
+        unranked[node] = inStart_[node + 1] - inStart_[node];
+        if (unranked[node] == 0) ready.push_back(node);
+    }
+    for (std::size_t next = 0; next < ready.size(); next++) {
+        int node = ready[next];
+        for (int edge = outStart_[node]; edge < outStart_[node + 1]; edge++) {
+            int target = head_[edge];
+            rank_[target] = std::max(rank_[target], rank_[node] + 1);
+            if (--unranked[target] == 0) ready.push_back(target);
+        }
+    }
+}
+
+void NetworkSimplexLayerer::feasibleTree() {
+    // Grow a tree of tight edges from every node not yet in one
+    unionFind_.assign(nodeCount_, -1);
+    treeSize_.assign(nodeCount_, 0);
+    treeHeap_.clear();
+    for (int root = 0; root < nodeCount_; root++) {
+        if (unionFind_[root] >= 0) continue;
+        unionFind_[root] = root;
+        int size = 1;
+        stack_.assign(1, root);
+        while (!stack_.empty()) {
+            int node = stack_.back();
+            stack_.pop_back();
+            auto grow = [&](int edge) {
+                int next = other(edge, node);
+                if (unionFind_[next] >= 0 || slack(edge) != 0) return;
+                unionFind_[next] = root;
+                addTreeEdge(edge);
+                stack_.push_back(next);
+                size++;
+            };
+            for (int edge = outStart_[node]; edge < outStart_[node + 1]; edge++) grow(edge);
+            for (int i = inStart_[node]; i < inStart_[node + 1]; i++) grow(inEdges_[i]);
+        }
+        treeSize_[root] = size;
+        treeHeap_.emplace_back(size, root);
+    }
+    std::make_heap(treeHeap_.begin(), treeHeap_.end(), std::greater<>());
+
+    // Take the smallest tree, shift it until its least-slack edge to another
+    // tree becomes tight and merge the two. A tree is searched only when it
+    // is the smallest, so it at least doubles before it is searched again.
+    while (!treeHeap_.empty()) {
+        std::pop_heap(treeHeap_.begin(), treeHeap_.end(), std::greater<>());
+        int size = treeHeap_.back().first;
+        int root = treeHeap_.back().second;
+        treeHeap_.pop_back();
+        if (unionFind_[root] != root || treeSize_[root] != size) continue;  // Merged or grown since
+
+        // Collect the tree's nodes, each with the edge it was reached by
+        nodeList_.assign(1, root);
+        stackSlot_.assign(1, -1);
+        for (std::size_t i = 0; i < nodeList_.size(); i++) {
+            int node = nodeList_[i];
+            for (int k = treeStart(node), end = k + treeCount_[node]; k < end; k++) {
+                int edge = treeAdjacency_[k];
+                if (edge == stackSlot_[i]) continue;
+                nodeList_.push_back(other(edge, node));
+                stackSlot_.push_back(edge);
+            }
+        }
+
+        int best = -1;
+        int bestSlack = std::numeric_limits<int>::max();
+        for (int node : nodeList_) {
+            auto consider = [&](int edge) {
+                if (findTree(other(edge, node)) == root) return;
+                int edgeSlack = slack(edge);
+                if (edgeSlack < bestSlack) {
+                    best = edge;
+                    bestSlack = edgeSlack;
+                }
+            };
+            for (int edge = outStart_[node]; edge < outStart_[node + 1]; edge++) consider(edge);
+            for (int i = inStart_[node]; i < inStart_[node + 1]; i++) consider(inEdges_[i]);
+        }
+        if (best < 0) continue;  // The tree spans its component
+
+        bool tailInside = findTree(tail_[best]) == root;
+        int delta = tailInside ? bestSlack : -bestSlack;
+        for (int node : nodeList_) {
+            rank_[node] += delta;
+        }
+        addTreeEdge(best);
+        int merged = findTree(tailInside ? head_[best] : tail_[best]);
+        unionFind_[root] = merged;
+        treeSize_[merged] += size;
+        treeHeap_.emplace_back(treeSize_[merged], merged);
+        std::push_heap(treeHeap_.begin(), treeHeap_.end(), std::greater<>());
+    }
+}
+
+int NetworkSimplexLayerer::findTree(int node) {
+    while (unionFind_[node] != node) {
+        unionFind_[node] = unionFind_[unionFind_[node]];
+        node = unionFind_[node];
+    }
+    return node;
+}
+
+void NetworkSimplexLayerer::addTreeEdge(int edge) {
+    for (int node : {tail_[edge], head_[edge]}) {
+        treeAdjacency_[treeStart(node) + treeCount_[node]++] = edge;
+    }
+}
+
+void NetworkSimplexLayerer::removeTreeEdge(int edge) {
+    for (int node : {tail_[edge], head_[edge]}) {
+        int* first = treeAdjacency_.data() + treeStart(node);
+        int* last = first + treeCount_[node];
+        *std::find(first, last, edge) = last[-1];
+        treeCount_[node]--;
+    }
+}
+
+// ============================================================================
+// Postorder Ranges and Cut Values
+// ============================================================================
+
+int NetworkSimplexLayerer::numberSubtree(int root, int parentEdge, int low) {
+    // Postorder numbers from low; every node gets the range [low, lim] of
+    // the numbers in its subtree. Nodes are appended to nodeList_ in
+    // postorder.
+    int next = low;
+    parentEdge_[root] = parentEdge;
+    low_[root] = next;
+    stack_.assign(1, root);
+    stackSlot_.assign(1, 0);
+    while (!stack_.empty()) {
+        int node = stack_.back();
+        if (stackSlot_.back() < treeCount_[node]) {
+            int edge = treeAdjacency_[treeStart(node) + stackSlot_.back()++];
+            if (edge == parentEdge_[node]) continue;
+            int child = other(edge, node);
+            parentEdge_[child] = edge;
+            low_[child] = next;
+            stack_.push_back(child);
+            stackSlot_.push_back(0);
+        } else {
+            lim_[node] = next++;
+            nodeList_.push_back(node);
+            stack_.pop_back();
+            stackSlot_.pop_back();
+        }
+    }
+    return next;
+}
+
+void NetworkSimplexLayerer::initCutValues() {
+    // Cut values bottom-up: a node's parent edge is computed from its own
+    // edges and the cut values of its child edges
+    int next = 1;
+    for (int root = 0; root < nodeCount_; root++) {
+        if (component_[root] >= 0) continue;
+        nodeList_.clear();
+        next = numberSubtree(root, -1, next);
+        for (int node : nodeList_) {
+            component_[node] = root;
+            int edge = parentEdge_[node];
+            if (edge < 0) continue;
+            cutValue_[edge] = cutValueOf(node);
+            treeSlot_[edge] = static_cast<int>(treeEdges_.size());
+            treeEdges_.push_back(edge);
+        }
+        componentRoots_.push_back(root);
+        componentEnds_.push_back(static_cast<int>(treeEdges_.size()));
+    }
+}
+
+int NetworkSimplexLayerer::cutValueOf(int node) const {
+    // Weight of edges from the tail component of the node's parent edge to
+    // its head component, less the weight of those going the other way
+    int parent = parentEdge_[node];
+    bool tailSide = tail_[parent] == node;
+    int sum = 0;
+    auto add = [&](int edge) {
+        int next = other(edge, node);
+        bool outside = lim_[next] < low_[node] || lim_[next] > lim_[node];
+        int value = outside ? 1 : (treeSlot_[edge] >= 0 ? cutValue_[edge] : 0) - 1;
+        bool positive = tailSide ? head_[edge] == node : tail_[edge] == node;
+        if (outside) positive = !positive;
+        sum += positive ? value : -value;
+    };
+    for (int edge = outStart_[node]; edge < outStart_[node + 1]; edge++) add(edge);
+    for (int i = inStart_[node]; i < inStart_[node + 1]; i++) add(inEdges_[i]);
+    return sum;
+}
+
+// ============================================================================
+// Pivoting
+// ============================================================================
+
+int NetworkSimplexLayerer::leaveEdge(int first, int last) {
+    // Most negative cut value among the next few negative ones, resuming
+    // where the previous search stopped
+    int count = last - first;
+    int best = -1;
+    int found = 0;
+    for (int k = 0; k < count; k++) {
+        int slot = searchStart_ + k;
+        if (slot >= last) slot -= count;
+        int edge = treeEdges_[slot];
+        if (cutValue_[edge] >= 0) continue;
+        if (best < 0 || cutValue_[edge] < cutValue_[best]) best = edge;
+        if (++found >= LEAVE_SEARCH_SIZE) {
+            searchStart_ = slot;
+            break;
+        }
+    }
+    return best;
+}
+
+int NetworkSimplexLayerer::enterEdge(int leaving) {
+    // Removing the leaving edge splits the tree; the side below it is the
+    // subtree of its endpoint with the lower lim. The entering edge is the
+    // non-tree edge of least slack from the head side to the tail side.
+    int tail = tail_[leaving];
+    int head = head_[leaving];
+    bool searchOut = lim_[tail] > lim_[head];
+    int subtree = searchOut ? head : tail;
+    int low = low_[subtree];
+    int lim = lim_[subtree];
+
+    int best = -1;
+    int bestSlack = std::numeric_limits<int>::max();
+    stack_.assign(1, subtree);
+    while (!stack_.empty() && bestSlack > 0) {
+        int node = stack_.back();
+        stack_.pop_back();
+        auto consider = [&](int edge) {
+            if (treeSlot_[edge] >= 0) return;
+            int next = other(edge, node);
+            if (lim_[next] >= low && lim_[next] <= lim) return;
+            int edgeSlack = slack(edge);
+            if (edgeSlack < bestSlack) {
+                best = edge;
+                bestSlack = edgeSlack;
+            }
+        };
+        if (searchOut) {
+            for (int edge = outStart_[node]; edge < outStart_[node + 1]; edge++) consider(edge);
+        } else {
+            for (int i = inStart_[node]; i < inStart_[node + 1]; i++) consider(inEdges_[i]);
+        }
+        for (int k = treeStart(node), end = k + treeCount_[node]; k < end; k++) {
+            int edge = treeAdjacency_[k];
+            if (edge != parentEdge_[node]) stack_.push_back(other(edge, node));
+        }
+    }
+    return best;
+}
+
+void NetworkSimplexLayerer::exchange(int leaving, int entering) {
+    // Make the entering edge tight by moving the side below the leaving edge
+    int delta = slack(entering);
+    if (delta > 0) {
+        int tail = tail_[leaving];
+        int head = head_[leaving];
+        if (lim_[tail] < lim_[head]) {
+            shiftSubtree(tail, -delta);
+        } else {
+            shiftSubtree(head, delta);
+        }
+    }
+
+    // Only the tree edges on the cycle the entering edge closes change
+    // their cut value
+    int cutValue = cutValue_[leaving];
+    int ancestor = updateCutValues(tail_[entering], head_[entering], cutValue, true);
+    updateCutValues(head_[entering], tail_[entering], cutValue, false);
+    cutValue_[entering] = -cutValue;
+    cutValue_[leaving] = 0;
+
+    removeTreeEdge(leaving);
+    addTreeEdge(entering);
+    int slot = treeSlot_[leaving];
+    treeSlot_[leaving] = -1;
+    treeSlot_[entering] = slot;
+    treeEdges_[slot] = entering;
+
+    // The cycle lies below the common ancestor, so only its subtree needs
+    // new postorder ranges
+    nodeList_.clear();
+    numberSubtree(ancestor, parentEdge_[ancestor], low_[ancestor]);
+}
+
+int NetworkSimplexLayerer::updateCutValues(int from, int to, int cutValue, bool direction) {
+    // Walk up from one end of the entering edge to the first ancestor of the
+    // other, adjusting the cut value of every parent edge on the way
+    while (lim_[to] < low_[from] || lim_[to] > lim_[from]) {
+        int edge = parentEdge_[from];
+        bool add = from == tail_[edge] ? direction : !direction;
+        cutValue_[edge] += add ? cutValue : -cutValue;
+        from = lim_[tail_[edge]] > lim_[head_[edge]] ? tail_[edge] : head_[edge];
+    }
+    return from;
+}
+
+void NetworkSimplexLayerer::shiftSubtree(int root, int delta) {
+    stack_.assign(1, root);
+    while (!stack_.empty()) {
+        int node = stack_.back();
+        stack_.pop_back();
+        rank_[node] += delta;
+        for (int k = treeStart(node), end = k + treeCount_[node]; k < end; k++) {
+            int edge = treeAdjacency_[k];
+            if (edge != parentEdge_[node]) stack_.push_back(other(edge, node));
+        }
+    }
+}
+
+// ============================================================================
+// Layers
+// ============================================================================
+
+void NetworkSimplexLayerer::normalize() {
+    // Every component starts in layer 0
+    std::vector<int>& lowest = treeSize_;
+    lowest.assign(nodeCount_, std::numeric_limits<int>::max());
+    for (int node = 0; node < nodeCount_; node++) {
+        int& componentLowest = lowest[component_[node]];
+        componentLowest = std::min(componentLowest, rank_[node]);
+    }
+    for (int node = 0; node < nodeCount_; node++) {
+        rank_[node] -= lowest[component_[node]];
+    }
+}
+
+void NetworkSimplexLayerer::balance() {
+    // A node with as many incoming as outgoing edges adds the same span
+    // anywhere between its neighbours, so it goes to the emptiest layer there
+    int layerCount = *std::max_element(rank_.begin(), rank_.end()) + 1;
+    filling_.assign(layerCount, 0);
+    for (int node = 0; node < nodeCount_; node++) {
+        filling_[rank_[node]]++;
+    }
+    for (int node = 0; node < nodeCount_; node++) {
+        int incoming = inStart_[node + 1] - inStart_[node];
+        int outgoing = outStart_[node + 1] - outStart_[node];
+        if (incoming == 0 || incoming != outgoing) continue;
+
+        int lowest = 0;
+        int highest = layerCount - 1;
+        for (int i = inStart_[node]; i < inStart_[node + 1]; i++) {
+            lowest = std::max(lowest, rank_[tail_[inEdges_[i]]] + 1);
+        }
+        for (int edge = outStart_[node]; edge < outStart_[node + 1]; edge++) {
+            highest = std::min(highest, rank_[head_[edge]] - 1);
+        }
+        int best = rank_[node];
+        for (int layer = lowest; layer <= highest; layer++) {
+            if (filling_[layer] < filling_[best]) best = layer;
+        }
+        if (filling_[best] < filling_[rank_[node]]) {
+            filling_[rank_[node]]--;
+            filling_[best]++;
+            rank_[node] = best;
+        }
+    }
+}
+
+} // namespace p2layers
+} // namespace layered
+} // namespace elk
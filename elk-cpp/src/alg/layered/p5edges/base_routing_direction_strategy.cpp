@@ -4,6 +4,7 @@
 
 #include "../../../../include/elk/alg/layered/p5edges/base_routing_direction_strategy.h"
 #include "../../../../include/elk/alg/layered/p5edges/west_to_east_routing_strategy.h"
+#include <algorithm>
 #include <stdexcept>
 #include <cmath>
 
@@ -39,7 +40,8 @@ void BaseRoutingDirectionStrategy::addJunctionPointIfNecessary(
     double p = vertical ? pos.y : pos.x;
 
     // If we already have this junction point, don't bother
-    if (createdJunctionPoints.find(pos) != createdJunctionPoints.end()) {
+    auto existing = std::lower_bound(createdJunctionPoints.begin(), createdJunctionPoints.end(), pos);
+    if (existing != createdJunctionPoints.end() && !(pos < *existing)) {
         return;
     }
 
@@ -67,7 +69,7 @@ void BaseRoutingDirectionStrategy::addJunctionPointIfNecessary(
         auto& junctionPoints = edge->junctionPoints;
 
         junctionPoints.push_back(pos);
-        createdJunctionPoints.insert(pos);
+        createdJunctionPoints.insert(existing, pos);
     }
 }
 
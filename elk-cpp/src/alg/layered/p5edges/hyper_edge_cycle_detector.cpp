@@ -3,7 +3,7 @@
 // SPDX-License-Identifier: EPL-2.0
 
 #include "../../../../include/elk/alg/layered/p5edges/hyper_edge_cycle_detector.h"
-#include <set>
+#include <algorithm>
 #include <climits>
 #include <random>
 
@@ -11,21 +11,18 @@ namespace elk {
 namespace layered {
 namespace p5edges {
 
-std::vector<HyperEdgeSegmentDependency*> HyperEdgeCycleDetector::detectCycles(
+const std::vector<HyperEdgeSegmentDependency*>& HyperEdgeCycleDetector::detectCycles(
         const std::vector<HyperEdgeSegment*>& segments,
         bool criticalOnly,
         std::mt19937& random) {
 
-    std::vector<HyperEdgeSegmentDependency*> result;
-
-    std::list<HyperEdgeSegment*> sources;
-    std::list<HyperEdgeSegment*> sinks;
+    result_.clear();
 
     // Initialize values for the algorithm
-    initialize(segments, sources, sinks, criticalOnly);
+    initialize(segments, criticalOnly);
 
     // Assign marks to all nodes
-    computeLinearOrderingMarks(segments, sources, sinks, criticalOnly, random);
+    computeLinearOrderingMarks(segments, criticalOnly, random);
 
     // Process edges that point left: remove those of zero weight, reverse the others
     for (HyperEdgeSegment* source : segments) {
@@ -33,20 +30,20 @@ std::vector<HyperEdgeSegmentDependency*> HyperEdgeCycleDetector::detectCycles(
             // Only consider critical dependencies, if required
             if (!criticalOnly || outDependency->getType() == HyperEdgeSegmentDependency::DependencyType::CRITICAL) {
                 if (source->mark > outDependency->getTarget()->mark) {
-                    result.push_back(outDependency);
+                    result_.push_back(outDependency);
                 }
             }
         }
     }
 
-    return result;
+    return result_;
 }
 
-void HyperEdgeCycleDetector::initialize(
-        const std::vector<HyperEdgeSegment*>& segments,
-        std::list<HyperEdgeSegment*>& sources,
-        std::list<HyperEdgeSegment*>& sinks,
-        bool criticalOnly) {
+void HyperEdgeCycleDetector::initialize(const std::vector<HyperEdgeSegment*>& segments, bool criticalOnly) {
+    sources_.clear();
+    sourcesHead_ = 0;
+    sinks_.clear();
+    sinksHead_ = 0;
 
     int nextMark = -1;
     for (HyperEdgeSegment* segment : segments) {
@@ -92,54 +89,68 @@ void HyperEdgeCycleDetector::initialize(
 
         // Add the segment to either sources or sinks if the corresponding weight is zero
         if (outWeight == 0) {
-            sinks.push_back(segment);
+            sinks_.push_back(segment);
         } else if (inWeight == 0) {
-            sources.push_back(segment);
+            sources_.push_back(segment);
         }
     }
 }
 
 void HyperEdgeCycleDetector::computeLinearOrderingMarks(
         const std::vector<HyperEdgeSegment*>& segments,
-        std::list<HyperEdgeSegment*>& sources,
-        std::list<HyperEdgeSegment*>& sinks,
         bool criticalOnly,
         std::mt19937& random) {
 
-    // Use std::set which keeps elements sorted (like Java's TreeSet)
-    std::set<HyperEdgeSegment*> unprocessed(segments.begin(), segments.end());
-    std::vector<HyperEdgeSegment*> maxSegments;
+    // Keep the unprocessed segments sorted by mark (like Java's TreeSet), not by address, so
+    // the choice among equal outflows is reproducible. Their marks are still the initial
+    // ones, which order them from the last segment to the first
+    int segmentCount = static_cast<int>(segments.size());
+    unprocessed_.clear();
+    for (int i = segmentCount - 1; i >= 0; i--) {
+        unprocessed_.push_back(i);
+    }
+    unprocessedFlags_.assign(segments.size(), 1);
+    unprocessedCount_ = segments.size();
+    maxSegments_.clear();
 
     // We'll mark sinks with marks < markBase and sources with marks > markBase. Sink marks will later be offset to
     // be higher than the source marks, but this way, the sink marks will reflect the order in which the sinks were
     // discovered and added.
-    int markBase = static_cast<int>(segments.size());
+    int markBase = segmentCount;
     int nextSinkMark = markBase - 1;
     int nextSourceMark = markBase + 1;
 
-    while (!unprocessed.empty()) {
-        while (!sinks.empty()) {
-            HyperEdgeSegment* sink = sinks.front();
-            sinks.pop_front();
-            unprocessed.erase(sink);
+    while (unprocessedCount_ > 0) {
+        while (sinksHead_ < sinks_.size()) {
+            HyperEdgeSegment* sink = sinks_[sinksHead_++];
+            markProcessed(sink->mark);
             sink->mark = nextSinkMark--;
-            updateNeighbors(sink, sources, sinks, criticalOnly);
+            updateNeighbors(sink, criticalOnly);
         }
+        sinks_.clear();
+        sinksHead_ = 0;
 
-        while (!sources.empty()) {
-            HyperEdgeSegment* source = sources.front();
-            sources.pop_front();
-            unprocessed.erase(source);
+        while (sourcesHead_ < sources_.size()) {
+            HyperEdgeSegment* source = sources_[sourcesHead_++];
+            markProcessed(source->mark);
             source->mark = nextSourceMark++;
-            updateNeighbors(source, sources, sinks, criticalOnly);
+            updateNeighbors(source, criticalOnly);
         }
+        sources_.clear();
+        sourcesHead_ = 0;
+
+        unprocessed_.erase(std::remove_if(unprocessed_.begin(), unprocessed_.end(),
+                                          [this](int i) { return !unprocessedFlags_[i]; }),
+                           unprocessed_.end());
 
         // If any segments are still unprocessed, they are neither source nor sink. Assemble the list of segments
         // with the highest out flow (out weight - in weight), to be placed among the sources. If we're looking at
         // both, critical and non-critical dependencies, we must be sure that critical dependencies will always
         // point rightwards; we thus stop immediately once we find one
         int maxOutflow = INT_MIN;
-        for (HyperEdgeSegment* segment : unprocessed) {
+        std::vector<HyperEdgeSegment*>& maxSegments = maxSegments_;
+        for (int i : unprocessed_) {
+            HyperEdgeSegment* segment = segments[i];
             // If we're not only regarding critical dependencies, we must ensure that critical dependencies will
             // always point to the right to prevent them from being reversed later on. Thus, once we find a single
             // segment that still has an outgoing critical dependency and no incoming ones, we'll take that and
@@ -164,9 +175,9 @@ void HyperEdgeCycleDetector::computeLinearOrderingMarks(
         if (!maxSegments.empty()) {
             std::uniform_int_distribution<int> dist(0, static_cast<int>(maxSegments.size()) - 1);
             HyperEdgeSegment* maxNode = maxSegments[dist(random)];
-            unprocessed.erase(maxNode);
+            markProcessed(maxNode->mark);
             maxNode->mark = nextSourceMark++;
-            updateNeighbors(maxNode, sources, sinks, criticalOnly);
+            updateNeighbors(maxNode, criticalOnly);
             maxSegments.clear();
         }
     }
@@ -180,11 +191,16 @@ void HyperEdgeCycleDetector::computeLinearOrderingMarks(
     }
 }
 
-void HyperEdgeCycleDetector::updateNeighbors(
-        HyperEdgeSegment* node,
-        std::list<HyperEdgeSegment*>& sources,
-        std::list<HyperEdgeSegment*>& sinks,
-        bool criticalOnly) {
+void HyperEdgeCycleDetector::markProcessed(int mark) {
+    // Only an unprocessed segment still has its initial mark -(index + 1)
+    int index = -mark - 1;
+    if (index >= 0 && index < static_cast<int>(unprocessedFlags_.size()) && unprocessedFlags_[index]) {
+        unprocessedFlags_[index] = 0;
+        unprocessedCount_--;
+    }
+}
+
+void HyperEdgeCycleDetector::updateNeighbors(HyperEdgeSegment* node, bool criticalOnly) {
 
     // Process following nodes
     for (HyperEdgeSegmentDependency* dep : node->getOutgoingSegmentDependencies()) {
@@ -198,7 +214,7 @@ void HyperEdgeCycleDetector::updateNeighbors(
                 }
 
                 if (target->getInWeight() <= 0 && target->getOutWeight() > 0) {
-                    sources.push_back(target);
+                    sources_.push_back(target);
                 }
             }
         }
@@ -216,7 +232,7 @@ void HyperEdgeCycleDetector::updateNeighbors(
                 }
 
                 if (source->getOutWeight() <= 0 && source->getInWeight() > 0) {
-                    sinks.push_back(source);
+                    sinks_.push_back(source);
                 }
             }
         }
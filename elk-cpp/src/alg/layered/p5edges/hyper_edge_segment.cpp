@@ -6,6 +6,7 @@
 #include "../../../../include/elk/alg/layered/p5edges/base_routing_direction_strategy.h"
 #include <algorithm>
 #include <sstream>
+#include <stdexcept>
 
 namespace elk {
 namespace layered {
@@ -18,8 +19,34 @@ HyperEdgeSegment::HyperEdgeSegment(BaseRoutingDirectionStrategy* routingStrategy
     : routingStrategy_(routingStrategy) {
 }
 
-void HyperEdgeSegment::addPortPositions(LPort* port, std::map<LPort*, HyperEdgeSegment*>& hyperEdgeSegmentMap) {
-    hyperEdgeSegmentMap[port] = this;
+void HyperEdgeSegment::reset() {
+    std::vector<LPort*> keptPorts = std::move(ports_);
+    std::vector<double> keptIncoming = std::move(incomingConnectionCoordinates_);
+    std::vector<double> keptOutgoing = std::move(outgoingConnectionCoordinates_);
+    std::vector<HyperEdgeSegmentDependency*> keptOutDependencies = std::move(outgoingSegmentDependencies_);
+    std::vector<HyperEdgeSegmentDependency*> keptInDependencies = std::move(incomingSegmentDependencies_);
+    keptPorts.clear();
+    keptIncoming.clear();
+    keptOutgoing.clear();
+    keptOutDependencies.clear();
+    keptInDependencies.clear();
+    *this = HyperEdgeSegment();
+    ports_ = std::move(keptPorts);
+    incomingConnectionCoordinates_ = std::move(keptIncoming);
+    outgoingConnectionCoordinates_ = std::move(keptOutgoing);
+    outgoingSegmentDependencies_ = std::move(keptOutDependencies);
+    incomingSegmentDependencies_ = std::move(keptInDependencies);
+}
+
+void HyperEdgeSegment::addPortPositions(LPort* port, std::vector<HyperEdgeSegment*>& segmentsByPort) {
+    if (port->graphIndex < 0) {
+        throw std::invalid_argument("Port is not numbered by LPort::graphIndex");
+    }
+    std::size_t index = static_cast<std::size_t>(port->graphIndex);
+    if (index >= segmentsByPort.size()) {
+        segmentsByPort.resize(index + 1, nullptr);
+    }
+    segmentsByPort[index] = this;
     ports_.push_back(port);
     double portPos = routingStrategy_->getPortPositionOnHyperNode(port);
 
@@ -33,15 +60,22 @@ void HyperEdgeSegment::addPortPositions(LPort* port, std::map<LPort*, HyperEdgeS
     // Update start and end coordinates
     recomputeExtent();
 
-    // Add connected ports recursively
-    for (LPort* otherPort : port->getConnectedPorts()) {
-        if (hyperEdgeSegmentMap.find(otherPort) == hyperEdgeSegmentMap.end()) {
-            addPortPositions(otherPort, hyperEdgeSegmentMap);
+    // Add connected ports recursively: sources of incoming edges, then targets of outgoing ones
+    for (LEdge* edge : port->incomingEdges) {
+        LPort* otherPort = edge->getSource();
+        if (otherPort != nullptr && segmentOf(otherPort, segmentsByPort) == nullptr) {
+            addPortPositions(otherPort, segmentsByPort);
+        }
+    }
+    for (LEdge* edge : port->outgoingEdges) {
+        LPort* otherPort = edge->getTarget();
+        if (otherPort != nullptr && segmentOf(otherPort, segmentsByPort) == nullptr) {
+            addPortPositions(otherPort, segmentsByPort);
         }
     }
 }
 
-void HyperEdgeSegment::insertSorted(std::list<double>& list, double value) {
+void HyperEdgeSegment::insertSorted(std::vector<double>& list, double value) {
     auto it = list.begin();
     while (it != list.end()) {
         double next = *it;
@@ -67,7 +101,7 @@ void HyperEdgeSegment::recomputeExtent() {
     recomputeExtent(outgoingConnectionCoordinates_);
 }
 
-void HyperEdgeSegment::recomputeExtent(const std::list<double>& positions) {
+void HyperEdgeSegment::recomputeExtent(const std::vector<double>& positions) {
     // This code assumes that the positions are sorted ascendingly
     if (!positions.empty()) {
         // Set new start position
@@ -89,9 +123,12 @@ void HyperEdgeSegment::recomputeExtent(const std::list<double>& positions) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Splitting
 
-std::pair<HyperEdgeSegment*, HyperEdgeSegment*> HyperEdgeSegment::simulateSplit() {
-    HyperEdgeSegment* newSplit = new HyperEdgeSegment(routingStrategy_);
-    HyperEdgeSegment* newSplitPartner = new HyperEdgeSegment(routingStrategy_);
+std::pair<HyperEdgeSegment*, HyperEdgeSegment*> HyperEdgeSegment::simulateSplit(
+        ElementPool<HyperEdgeSegment>& segmentPool) {
+    HyperEdgeSegment* newSplit = segmentPool.create();
+    HyperEdgeSegment* newSplitPartner = segmentPool.create();
+    newSplit->routingStrategy_ = routingStrategy_;
+    newSplitPartner->routingStrategy_ = routingStrategy_;
 
     newSplit->incomingConnectionCoordinates_ = incomingConnectionCoordinates_;
     newSplit->splitBy_ = splitBy_;
@@ -105,8 +142,9 @@ std::pair<HyperEdgeSegment*, HyperEdgeSegment*> HyperEdgeSegment::simulateSplit(
     return std::make_pair(newSplit, newSplitPartner);
 }
 
-HyperEdgeSegment* HyperEdgeSegment::splitAt(double splitPosition) {
-    splitPartner_ = new HyperEdgeSegment(routingStrategy_);
+HyperEdgeSegment* HyperEdgeSegment::splitAt(double splitPosition, ElementPool<HyperEdgeSegment>& segmentPool) {
+    splitPartner_ = segmentPool.create();
+    splitPartner_->setRoutingStrategy(routingStrategy_);
     splitPartner_->setSplitPartner(this);
 
     // Move all target positions over to the new segment
@@ -148,7 +186,7 @@ std::string HyperEdgeSegment::toString() const {
         // Try to get a meaningful name
         std::string name;
         if (node && node->originalNode) {
-            name = node->originalNode->id;
+            name = node->originalNode->id.str();
         } else if (node) {
             name = "n" + std::to_string(node->getIndex());
         } else {
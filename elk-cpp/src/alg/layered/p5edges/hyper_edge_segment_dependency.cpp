@@ -11,11 +11,12 @@ namespace layered {
 namespace p5edges {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Private Constructor
+// Initialization
 
-HyperEdgeSegmentDependency::HyperEdgeSegmentDependency(DependencyType type, HyperEdgeSegment* source,
-                                                       HyperEdgeSegment* target, int weight)
-    : type_(type), source_(nullptr), target_(nullptr), weight_(weight) {
+void HyperEdgeSegmentDependency::init(DependencyType type, HyperEdgeSegment* source,
+                                      HyperEdgeSegment* target, int weight) {
+    type_ = type;
+    weight_ = weight;
     setSource(source);
     setTarget(target);
 }
@@ -23,15 +24,23 @@ HyperEdgeSegmentDependency::HyperEdgeSegmentDependency(DependencyType type, Hype
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Static Factory Methods
 
-HyperEdgeSegmentDependency* HyperEdgeSegmentDependency::createAndAddRegular(HyperEdgeSegment* source,
-                                                                             HyperEdgeSegment* target,
-                                                                             int weight) {
-    return new HyperEdgeSegmentDependency(DependencyType::REGULAR, source, target, weight);
+HyperEdgeSegmentDependency* HyperEdgeSegmentDependency::createAndAddRegular(
+        ElementPool<HyperEdgeSegmentDependency>& pool,
+        HyperEdgeSegment* source,
+        HyperEdgeSegment* target,
+        int weight) {
+    HyperEdgeSegmentDependency* dependency = pool.create();
+    dependency->init(DependencyType::REGULAR, source, target, weight);
+    return dependency;
 }
 
-HyperEdgeSegmentDependency* HyperEdgeSegmentDependency::createAndAddCritical(HyperEdgeSegment* source,
-                                                                              HyperEdgeSegment* target) {
-    return new HyperEdgeSegmentDependency(DependencyType::CRITICAL, source, target, CRITICAL_DEPENDENCY_WEIGHT);
+HyperEdgeSegmentDependency* HyperEdgeSegmentDependency::createAndAddCritical(
+        ElementPool<HyperEdgeSegmentDependency>& pool,
+        HyperEdgeSegment* source,
+        HyperEdgeSegment* target) {
+    HyperEdgeSegmentDependency* dependency = pool.create();
+    dependency->init(DependencyType::CRITICAL, source, target, CRITICAL_DEPENDENCY_WEIGHT);
+    return dependency;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
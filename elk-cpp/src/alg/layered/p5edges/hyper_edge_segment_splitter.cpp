@@ -5,7 +5,6 @@
 #include "../../../../include/elk/alg/layered/p5edges/hyper_edge_segment_splitter.h"
 #include <algorithm>
 #include <vector>
-#include <set>
 
 // Forward declaration - OrthogonalRoutingGenerator will be defined later
 namespace elk {
@@ -22,13 +21,17 @@ namespace p5edges {
 
 // Forward declarations of methods from OrthogonalRoutingGenerator that we'll need
 // These will be properly linked when OrthogonalRoutingGenerator is implemented
-extern int countCrossings(const std::list<double>& connections, double start, double end);
+extern int countCrossings(const std::vector<double>& connections, double start, double end);
 extern void createDependencyIfNecessary(OrthogonalRoutingGenerator* gen,
                                         HyperEdgeSegment* seg1,
                                         HyperEdgeSegment* seg2);
 
-HyperEdgeSegmentSplitter::HyperEdgeSegmentSplitter(OrthogonalRoutingGenerator* routingGenerator)
-    : routingGenerator_(routingGenerator) {
+HyperEdgeSegmentSplitter::HyperEdgeSegmentSplitter(OrthogonalRoutingGenerator* routingGenerator,
+                                                   ElementPool<HyperEdgeSegment>& segmentPool,
+                                                   ElementPool<HyperEdgeSegmentDependency>& dependencyPool)
+    : routingGenerator_(routingGenerator)
+    , segmentPool_(segmentPool)
+    , dependencyPool_(dependencyPool) {
 }
 
 void HyperEdgeSegmentSplitter::splitSegments(
@@ -43,10 +46,12 @@ void HyperEdgeSegmentSplitter::splitSegments(
 
     // Collect all relevant spaces between horizontal segments that are large enough to house
     // another horizontal segment without causing additional conflicts
-    std::vector<FreeArea> freeAreas = findFreeAreas(segments, criticalConflictThreshold);
+    findFreeAreas(segments, criticalConflictThreshold);
+    std::vector<FreeArea>& freeAreas = freeAreas_;
 
     // For each dependency, choose which segment to split
-    std::vector<HyperEdgeSegment*> segmentsToSplit = decideWhichSegmentsToSplit(dependenciesToResolve);
+    decideWhichSegmentsToSplit(dependenciesToResolve);
+    std::vector<HyperEdgeSegment*>& segmentsToSplit = segmentsToSplit_;
 
     // Split the segments in order from smallest to largest. The smallest ones need to be split
     // first since they have fewer options for where to put their horizontal connecting segments.
@@ -63,14 +68,15 @@ void HyperEdgeSegmentSplitter::splitSegments(
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Finding Space
 
-std::vector<HyperEdgeSegmentSplitter::FreeArea> HyperEdgeSegmentSplitter::findFreeAreas(
-        const std::vector<HyperEdgeSegment*>& segments,
-        double criticalConflictThreshold) {
+void HyperEdgeSegmentSplitter::findFreeAreas(const std::vector<HyperEdgeSegment*>& segments,
+                                             double criticalConflictThreshold) {
 
-    std::vector<FreeArea> freeAreas;
+    std::vector<FreeArea>& freeAreas = freeAreas_;
+    freeAreas.clear();
 
     // Retrieve all positions where hyperedge segments connect to ports, and sort them
-    std::vector<double> allCoordinates;
+    std::vector<double>& allCoordinates = allCoordinates_;
+    allCoordinates.clear();
 
     for (const auto* segment : segments) {
         for (double coord : segment->getIncomingConnectionCoordinates()) {
@@ -92,18 +98,17 @@ std::vector<HyperEdgeSegmentSplitter::FreeArea> HyperEdgeSegmentSplitter::findFr
                 allCoordinates[i] - criticalConflictThreshold);
         }
     }
-
-    return freeAreas;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Split Segment Decisions
 
-std::vector<HyperEdgeSegment*> HyperEdgeSegmentSplitter::decideWhichSegmentsToSplit(
+void HyperEdgeSegmentSplitter::decideWhichSegmentsToSplit(
         const std::vector<HyperEdgeSegmentDependency*>& dependencies) {
 
     // Use vector to maintain insertion order (like Java's LinkedHashSet)
-    std::vector<HyperEdgeSegment*> segmentsToSplit;
+    std::vector<HyperEdgeSegment*>& segmentsToSplit = segmentsToSplit_;
+    segmentsToSplit.clear();
 
     for (HyperEdgeSegmentDependency* dependency : dependencies) {
         HyperEdgeSegment* sourceSegment = dependency->getSource();
@@ -136,8 +141,6 @@ std::vector<HyperEdgeSegment*> HyperEdgeSegmentSplitter::decideWhichSegmentsToSp
         segmentsToSplit.push_back(segmentToSplit);
         segmentToSplit->setSplitBy(segmentCausingSplit);
     }
-
-    return segmentsToSplit;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -150,7 +153,7 @@ void HyperEdgeSegmentSplitter::split(HyperEdgeSegment* segment,
 
     // Split the segment at the best position and add the new segment to our list
     double splitPosition = computePositionToSplitAndUpdateFreeAreas(segment, freeAreas, criticalConflictThreshold);
-    segments.push_back(segment->splitAt(splitPosition));
+    segments.push_back(segment->splitAt(splitPosition, segmentPool_));
 
     // Update the dependencies to reflect the new situation
     updateDependencies(segment, segments);
@@ -163,8 +166,8 @@ void HyperEdgeSegmentSplitter::updateDependencies(HyperEdgeSegment* segment,
 
     // The segment currently has no dependencies at all. We first need for the segments to be
     // ordered like this: segment ---> split-causing segment ---> split partner
-    HyperEdgeSegmentDependency::createAndAddCritical(segment, splitCausingSegment);
-    HyperEdgeSegmentDependency::createAndAddCritical(splitCausingSegment, splitPartner);
+    HyperEdgeSegmentDependency::createAndAddCritical(dependencyPool_, segment, splitCausingSegment);
+    HyperEdgeSegmentDependency::createAndAddCritical(dependencyPool_, splitCausingSegment, splitPartner);
 
     // Now we just need to re-introduce dependencies to other segments
     for (HyperEdgeSegment* otherSegment : segments) {
@@ -229,8 +232,9 @@ int HyperEdgeSegmentSplitter::chooseBestAreaIndex(HyperEdgeSegment* segment,
 
     if (fromIndex < toIndex) {
         // We have more areas to choose from, so rate them and find the best one. We need to simulate
-        // splitting the segment so that we can count potential crossings
-        auto splitSegments = segment->simulateSplit();
+        // splitting the segment so that we can count potential crossings. The simulated segments
+        // stay in the pool until the generator resets it
+        auto splitSegments = segment->simulateSplit(segmentPool_);
         HyperEdgeSegment* splitSegment = splitSegments.first;
         HyperEdgeSegment* splitPartner = splitSegments.second;
 
@@ -247,10 +251,6 @@ int HyperEdgeSegmentSplitter::chooseBestAreaIndex(HyperEdgeSegment* segment,
                 bestAreaIndex = i;
             }
         }
-
-        // Clean up simulated segments
-        delete splitSegment;
-        delete splitPartner;
     }
 
     return bestAreaIndex;
@@ -5,6 +5,7 @@
 #include "../../../../include/elk/alg/layered/p5edges/orthogonal_edge_router.h"
 #include "../../../../include/elk/alg/layered/p5edges/orthogonal_routing_generator.h"
 #include "../../../../include/elk/alg/layered/p5edges/routing_direction.h"
+#include "../../../../include/elk/core/trace.h"
 #include <algorithm>
 
 namespace elk {
@@ -15,22 +16,35 @@ double OrthogonalEdgeRouter::process(std::vector<Layer>& layers,
                                       double nodeNodeSpacing,
                                       double edgeEdgeSpacing,
                                       double edgeNodeSpacing) {
-    // Create a temporary LGraph for routing
-    static std::mt19937 random(42);  // Fixed seed for reproducibility
     LGraph tempGraph;
+    OrthogonalRoutingGenerator routingGenerator(RoutingDirection::WEST_TO_EAST, edgeEdgeSpacing, "");
+    return process(layers, tempGraph, routingGenerator, nodeNodeSpacing, edgeEdgeSpacing, edgeNodeSpacing);
+}
+
+double OrthogonalEdgeRouter::process(std::vector<Layer>& layers,
+                                      LGraph& tempGraph,
+                                      OrthogonalRoutingGenerator& routingGenerator,
+                                      double nodeNodeSpacing,
+                                      double edgeEdgeSpacing,
+                                      double edgeNodeSpacing) {
+    ELK_TRACE_PHASE("routing");
+
+    // The routing graph only carries spacings and the random generator
+    // (fixed seed for reproducibility)
     tempGraph.nodeNodeSpacing = nodeNodeSpacing;
     tempGraph.edgeEdgeSpacing = edgeEdgeSpacing;
     tempGraph.edgeNodeSpacing = edgeNodeSpacing;
-    tempGraph.random = random;
+    tempGraph.random.seed(RANDOM_SEED);
 
-    // Create the routing generator
-    OrthogonalRoutingGenerator routingGenerator(RoutingDirection::WEST_TO_EAST, edgeEdgeSpacing, "");
+    // Prepare the routing generator
+    routingGenerator.reset(edgeEdgeSpacing);
 
     double xpos = 0.0;
     const std::vector<LNode*>* leftLayerNodes = nullptr;
     const std::vector<LNode*>* rightLayerNodes = nullptr;
     int leftLayerIndex = -1;
     int rightLayerIndex = -1;
+    std::int64_t totalSlots = 0;
 
     // Iterate through all layers
     for (size_t layerIdx = 0; layerIdx <= layers.size(); layerIdx++) {
@@ -58,6 +72,7 @@ double OrthogonalEdgeRouter::process(std::vector<Layer>& layers,
         double startPos = (leftLayerNodes == nullptr) ? xpos : xpos + edgeNodeSpacing;
         slotsCount = routingGenerator.routeEdges(&tempGraph, leftLayerNodes, leftLayerIndex,
                                                  rightLayerNodes, startPos);
+        totalSlots += slotsCount;
 
         // Check if layers are external (containing only external west/east port dummies)
         bool isLeftLayerExternal = (leftLayerNodes == nullptr) ||
@@ -102,6 +117,8 @@ double OrthogonalEdgeRouter::process(std::vector<Layer>& layers,
         leftLayerIndex = rightLayerIndex;
     }
 
+    ELK_TRACE_COUNT(ROUTING_SLOTS, totalSlots);
+
     // Return the final graph width
     return xpos;
 }
@@ -6,10 +6,10 @@
 #include "../../../../include/elk/alg/layered/p5edges/base_routing_direction_strategy.h"
 #include "../../../../include/elk/alg/layered/p5edges/hyper_edge_segment_splitter.h"
 #include "../../../../include/elk/alg/layered/p5edges/hyper_edge_cycle_detector.h"
+#include "../../../../include/elk/core/trace.h"
 #include <algorithm>
 #include <limits>
 #include <cmath>
-#include <iostream>
 
 namespace elk {
 namespace layered {
@@ -19,7 +19,7 @@ namespace p5edges {
 // External functions for HyperEdgeSegmentSplitter
 
 // These are called from HyperEdgeSegmentSplitter
-int countCrossings(const std::list<double>& posis, double start, double end) {
+int countCrossings(const std::vector<double>& posis, double start, double end) {
     return OrthogonalRoutingGenerator::countCrossings(posis, start, end);
 }
 
@@ -48,6 +48,34 @@ OrthogonalRoutingGenerator::~OrthogonalRoutingGenerator() {
     delete routingStrategy_;
 }
 
+void OrthogonalRoutingGenerator::reset(double edgeSpacing) {
+    edgeSpacing_ = edgeSpacing;
+    conflictThreshold_ = CONFLICT_THRESHOLD_FACTOR * edgeSpacing;
+    criticalConflictThreshold_ = 0.0;
+
+    // An earlier call may have been left by an exception with ports still mapped
+    std::fill(segmentsByPort_.begin(), segmentsByPort_.end(), nullptr);
+    edgeSegments_.clear();
+    segmentPool_.reset();
+    dependencyPool_.reset();
+    routingStrategy_->clearCreatedJunctionPoints();
+}
+
+void OrthogonalRoutingGenerator::shrink() {
+    delete segmentSplitter_;
+    segmentSplitter_ = nullptr;
+    routingStrategy_->shrinkCreatedJunctionPoints();
+    segmentPool_.shrink();
+    dependencyPool_.shrink();
+    cycleDetector_ = HyperEdgeCycleDetector();
+    edgeSegments_ = {};
+    segmentsByPort_ = {};
+    incomingCoordinates_ = {};
+    outgoingCoordinates_ = {};
+    sources_ = {};
+    rightwardTargets_ = {};
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Edge Routing
 
@@ -57,19 +85,22 @@ int OrthogonalRoutingGenerator::routeEdges(LGraph* layeredGraph,
                                             const std::vector<LNode*>* targetLayerNodes,
                                             double startPos) {
 
-    std::cerr << "\nrouteEdges called: sourceLayer=" << (sourceLayerNodes ? std::to_string(sourceLayerNodes->size()) : "null")
-              << " nodes, targetLayer=" << (targetLayerNodes ? std::to_string(targetLayerNodes->size()) : "null") << " nodes\n";
+    ELK_TRACE_DEBUG("\nrouteEdges called: sourceLayer=" << (sourceLayerNodes ? std::to_string(sourceLayerNodes->size()) : "null")
+                    << " nodes, targetLayer=" << (targetLayerNodes ? std::to_string(targetLayerNodes->size()) : "null") << " nodes\n");
 
-    // Keep track of our hyperedge segments, and which ports they were created for
-    std::map<LPort*, HyperEdgeSegment*> portToEdgeSegmentMap;
-    std::vector<HyperEdgeSegment*> edgeSegments;
+    // Keep track of our hyperedge segments, and which ports they were created for. The
+    // segments and dependencies of the previous call are no longer referenced
+    segmentPool_.reset();
+    dependencyPool_.reset();
+    std::vector<HyperEdgeSegment*>& edgeSegments = edgeSegments_;
+    edgeSegments.clear();
 
     // Create hyperedge segments for eastern output ports of the left layer and for western
     // output ports of the right layer
     createHyperEdgeSegments(sourceLayerNodes, routingStrategy_->getSourcePortSide(),
-                           edgeSegments, portToEdgeSegmentMap);
+                           edgeSegments, segmentsByPort_);
     createHyperEdgeSegments(targetLayerNodes, routingStrategy_->getTargetPortSide(),
-                           edgeSegments, portToEdgeSegmentMap);
+                           edgeSegments, segmentsByPort_);
 
     // If no edge segments were created, return early
     if (edgeSegments.empty()) {
@@ -113,26 +144,28 @@ int OrthogonalRoutingGenerator::routeEdges(LGraph* layeredGraph,
         // Edges that are just straight lines don't take up a slot and don't need bend points
         double startCoord = node->getStartCoordinate();
         double endCoord = node->getEndCoordinate();
-        std::cerr << "  Segment: start=" << startCoord << " end=" << endCoord << " diff=" << std::abs(startCoord - endCoord) << "\n";
+        ELK_TRACE_DEBUG("  Segment: start=" << startCoord << " end=" << endCoord << " diff=" << std::abs(startCoord - endCoord) << "\n");
         if (std::abs(startCoord - endCoord) < TOLERANCE) {
-            std::cerr << "    -> Skipping segment (straight line)\n";
+            ELK_TRACE_DEBUG("    -> Skipping segment (straight line)\n");
             continue;
         }
 
         rankCount = std::max(rankCount, node->getRoutingSlot());
 
-        std::cerr << "  Calculating bend points for segment at slot " << node->getRoutingSlot() << "\n";
+        ELK_TRACE_DEBUG("  Calculating bend points for segment at slot " << node->getRoutingSlot() << "\n");
         routingStrategy_->calculateBendPoints(node, startPos, edgeSpacing_);
         bendPointsCalculated++;
     }
-    std::cerr << "  Calculated bend points for " << bendPointsCalculated << " segments, rankCount=" << (rankCount + 1) << "\n";
+    ELK_TRACE_DEBUG("  Calculated bend points for " << bendPointsCalculated << " segments, rankCount=" << (rankCount + 1) << "\n");
 
     // Release the created resources
     routingStrategy_->clearCreatedJunctionPoints();
 
-    // Clean up hyperedge segments
+    // Unmap the ports for the next call; the segments go back to the pool with it
     for (HyperEdgeSegment* segment : edgeSegments) {
-        delete segment;
+        for (LPort* port : segment->getPorts()) {
+            segmentsByPort_[port->graphIndex] = nullptr;
+        }
     }
 
     return rankCount + 1;
@@ -141,8 +174,10 @@ int OrthogonalRoutingGenerator::routeEdges(LGraph* layeredGraph,
 double OrthogonalRoutingGenerator::minimumHorizontalSegmentDistance(
         const std::vector<HyperEdgeSegment*>& edgeSegments) {
 
-    std::vector<double> incomingCoords;
-    std::vector<double> outgoingCoords;
+    std::vector<double>& incomingCoords = incomingCoordinates_;
+    std::vector<double>& outgoingCoords = outgoingCoordinates_;
+    incomingCoords.clear();
+    outgoingCoords.clear();
 
     for (const auto* segment : edgeSegments) {
         for (double coord : segment->getIncomingConnectionCoordinates()) {
@@ -182,30 +217,31 @@ void OrthogonalRoutingGenerator::createHyperEdgeSegments(
         const std::vector<LNode*>* nodes,
         PortSide portSide,
         std::vector<HyperEdgeSegment*>& hyperEdges,
-        std::map<LPort*, HyperEdgeSegment*>& portToHyperEdgeSegmentMap) {
+        std::vector<HyperEdgeSegment*>& segmentsByPort) {
 
     if (nodes != nullptr) {
-        std::cerr << "createHyperEdgeSegments: " << nodes->size() << " nodes, looking for OUTPUT ports on side " << (int)portSide << "\n";
+        ELK_TRACE_DEBUG("createHyperEdgeSegments: " << nodes->size() << " nodes, looking for OUTPUT ports on side " << (int)portSide << "\n");
         for (LNode* node : *nodes) {
-            std::cerr << "  Node with " << node->getPorts().size() << " ports\n";
+            ELK_TRACE_DEBUG("  Node with " << node->getPorts().size() << " ports\n");
             for (LPort* port : node->getPorts()) {
-                std::cerr << "    Port: side=" << (int)port->side << " type=" << (int)port->portType
-                          << " incoming=" << port->incomingEdges.size()
-                          << " outgoing=" << port->outgoingEdges.size() << "\n";
+                ELK_TRACE_DEBUG("    Port: side=" << (int)port->side << " type=" << (int)port->portType
+                                << " incoming=" << port->incomingEdges.size()
+                                << " outgoing=" << port->outgoingEdges.size() << "\n");
                 // Filter for OUTPUT ports on the specified side (matching Java ELK exactly)
                 // This matches: node.getPorts(PortType.OUTPUT, portSide)
                 if (port->portType == PortType::OUTPUT && port->side == portSide) {
-                    std::cerr << "      -> Creating hyperedge segment for this OUTPUT port\n";
-                    HyperEdgeSegment* hyperEdge = portToHyperEdgeSegmentMap[port];
+                    ELK_TRACE_DEBUG("      -> Creating hyperedge segment for this OUTPUT port\n");
+                    HyperEdgeSegment* hyperEdge = HyperEdgeSegment::segmentOf(port, segmentsByPort);
                     if (hyperEdge == nullptr) {
-                        hyperEdge = new HyperEdgeSegment(routingStrategy_);
+                        hyperEdge = segmentPool_.create();
+                        hyperEdge->setRoutingStrategy(routingStrategy_);
                         hyperEdges.push_back(hyperEdge);
-                        hyperEdge->addPortPositions(port, portToHyperEdgeSegmentMap);
+                        hyperEdge->addPortPositions(port, segmentsByPort);
                     }
                 }
             }
         }
-        std::cerr << "  Created " << hyperEdges.size() << " segments\n";
+        ELK_TRACE_DEBUG("  Created " << hyperEdges.size() << " segments\n");
     }
 }
 
@@ -232,13 +268,13 @@ int OrthogonalRoutingGenerator::createDependencyIfNecessary(HyperEdgeSegment* he
         // Check which critical dependencies have to be added
         if (conflicts1 == CRITICAL_CONFLICTS_DETECTED) {
             // hyperedge 1 MUST NOT be left of hyperedge 2, since that would cause critical conflicts
-            HyperEdgeSegmentDependency::createAndAddCritical(he2, he1);
+            HyperEdgeSegmentDependency::createAndAddCritical(dependencyPool_, he2, he1);
             criticalDependencyCount++;
         }
 
         if (conflicts2 == CRITICAL_CONFLICTS_DETECTED) {
             // hyperedge 2 MUST NOT be left of hyperedge 1, since that would cause critical conflicts
-            HyperEdgeSegmentDependency::createAndAddCritical(he1, he2);
+            HyperEdgeSegmentDependency::createAndAddCritical(dependencyPool_, he1, he2);
             criticalDependencyCount++;
         }
 
@@ -260,22 +296,22 @@ int OrthogonalRoutingGenerator::createDependencyIfNecessary(HyperEdgeSegment* he
 
         if (depValue1 < depValue2) {
             // hyperedge 1 wants to be left of hyperedge 2
-            HyperEdgeSegmentDependency::createAndAddRegular(he1, he2, depValue2 - depValue1);
+            HyperEdgeSegmentDependency::createAndAddRegular(dependencyPool_, he1, he2, depValue2 - depValue1);
         } else if (depValue1 > depValue2) {
             // hyperedge 2 wants to be left of hyperedge 1
-            HyperEdgeSegmentDependency::createAndAddRegular(he2, he1, depValue1 - depValue2);
+            HyperEdgeSegmentDependency::createAndAddRegular(dependencyPool_, he2, he1, depValue1 - depValue2);
         } else if (depValue1 > 0 && depValue2 > 0) {
             // Create two dependencies with zero weight
-            HyperEdgeSegmentDependency::createAndAddRegular(he1, he2, 0);
-            HyperEdgeSegmentDependency::createAndAddRegular(he2, he1, 0);
+            HyperEdgeSegmentDependency::createAndAddRegular(dependencyPool_, he1, he2, 0);
+            HyperEdgeSegmentDependency::createAndAddRegular(dependencyPool_, he2, he1, 0);
         }
     }
 
     return criticalDependencyCount;
 }
 
-int OrthogonalRoutingGenerator::countConflicts(const std::list<double>& posis1,
-                                                const std::list<double>& posis2) {
+int OrthogonalRoutingGenerator::countConflicts(const std::vector<double>& posis1,
+                                                const std::vector<double>& posis2) {
     int conflicts = 0;
 
     if (!posis1.empty() && !posis2.empty()) {
@@ -306,7 +342,7 @@ int OrthogonalRoutingGenerator::countConflicts(const std::list<double>& posis1,
     return conflicts;
 }
 
-int OrthogonalRoutingGenerator::countCrossings(const std::list<double>& posis,
+int OrthogonalRoutingGenerator::countCrossings(const std::vector<double>& posis,
                                                 double start,
                                                 double end) {
     int crossings = 0;
@@ -325,12 +361,12 @@ int OrthogonalRoutingGenerator::countCrossings(const std::list<double>& posis,
 
 void OrthogonalRoutingGenerator::breakCriticalCycles(std::vector<HyperEdgeSegment*>& edgeSegments,
                                                       std::mt19937& random) {
-    std::vector<HyperEdgeSegmentDependency*> cycleDependencies =
-        HyperEdgeCycleDetector::detectCycles(edgeSegments, true, random);
+    const std::vector<HyperEdgeSegmentDependency*>& cycleDependencies =
+        cycleDetector_.detectCycles(edgeSegments, true, random);
 
     // Lazy initialization
     if (segmentSplitter_ == nullptr) {
-        segmentSplitter_ = new HyperEdgeSegmentSplitter(this);
+        segmentSplitter_ = new HyperEdgeSegmentSplitter(this, segmentPool_, dependencyPool_);
     }
 
     segmentSplitter_->splitSegments(cycleDependencies, edgeSegments, criticalConflictThreshold_);
@@ -338,8 +374,8 @@ void OrthogonalRoutingGenerator::breakCriticalCycles(std::vector<HyperEdgeSegmen
 
 void OrthogonalRoutingGenerator::breakNonCriticalCycles(std::vector<HyperEdgeSegment*>& edgeSegments,
                                                          std::mt19937& random) {
-    std::vector<HyperEdgeSegmentDependency*> cycleDependencies =
-        HyperEdgeCycleDetector::detectCycles(edgeSegments, false, random);
+    const std::vector<HyperEdgeSegmentDependency*>& cycleDependencies =
+        cycleDetector_.detectCycles(edgeSegments, false, random);
 
     for (HyperEdgeSegmentDependency* cycleDependency : cycleDependencies) {
         if (cycleDependency->getWeight() == 0) {
@@ -358,8 +394,10 @@ void OrthogonalRoutingGenerator::topologicalNumbering(std::vector<HyperEdgeSegme
     // Determine sources, targets, incoming count and outgoing count; targets are only
     // added to the list if they only connect westward ports (that is, if all their
     // horizontal segments point to the right)
-    std::vector<HyperEdgeSegment*> sources;
-    std::vector<HyperEdgeSegment*> rightwardTargets;
+    std::vector<HyperEdgeSegment*>& sources = sources_;
+    std::vector<HyperEdgeSegment*>& rightwardTargets = rightwardTargets_;
+    sources.clear();
+    rightwardTargets.clear();
 
     for (HyperEdgeSegment* node : segments) {
         node->setInWeight(static_cast<int>(node->getIncomingSegmentDependencies().size()));
@@ -376,10 +414,9 @@ void OrthogonalRoutingGenerator::topologicalNumbering(std::vector<HyperEdgeSegme
 
     int maxRank = -1;
 
-    // Assign ranks using topological numbering
-    while (!sources.empty()) {
-        HyperEdgeSegment* node = sources.front();
-        sources.erase(sources.begin());
+    // Assign ranks using topological numbering; sources are taken in the order they were found
+    for (std::size_t next = 0; next < sources.size(); next++) {
+        HyperEdgeSegment* node = sources[next];
 
         for (HyperEdgeSegmentDependency* dep : node->getOutgoingSegmentDependencies()) {
             HyperEdgeSegment* target = dep->getTarget();
@@ -407,9 +444,8 @@ void OrthogonalRoutingGenerator::topologicalNumbering(std::vector<HyperEdgeSegme
 
         // Let all other segments with horizontal segments pointing rightwards move as
         // far right as possible
-        while (!rightwardTargets.empty()) {
-            HyperEdgeSegment* node = rightwardTargets.front();
-            rightwardTargets.erase(rightwardTargets.begin());
+        for (std::size_t next = 0; next < rightwardTargets.size(); next++) {
+            HyperEdgeSegment* node = rightwardTargets[next];
 
             // The node only has connections to western ports
             for (HyperEdgeSegmentDependency* dep : node->getIncomingSegmentDependencies()) {
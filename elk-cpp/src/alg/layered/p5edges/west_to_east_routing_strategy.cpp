@@ -3,8 +3,8 @@
 // SPDX-License-Identifier: EPL-2.0
 
 #include "../../../../include/elk/alg/layered/p5edges/west_to_east_routing_strategy.h"
+#include "../../../../include/elk/core/trace.h"
 #include <cmath>
-#include <iostream>
 
 namespace elk {
 namespace layered {
@@ -18,7 +18,7 @@ double WestToEastRoutingStrategy::getPortPositionOnHyperNode(LPort* port) {
     double portY = port->getPosition().y;
     double anchorY = port->getAnchor().y;
     double total = nodeY + portY + anchorY;
-    std::cerr << "      getPortPositionOnHyperNode: node.y=" << nodeY << " port.y=" << portY << " anchor.y=" << anchorY << " total=" << total << "\n";
+    ELK_TRACE_DEBUG("      getPortPositionOnHyperNode: node.y=" << nodeY << " port.y=" << portY << " anchor.y=" << anchorY << " total=" << total << "\n");
     return total;
 }
 
@@ -39,27 +39,27 @@ void WestToEastRoutingStrategy::calculateBendPoints(HyperEdgeSegment* segment, d
     // Calculate coordinates for each port's bend points
     double segmentX = startPos + segment->getRoutingSlot() * edgeSpacing;
 
-    std::cerr << "    calculateBendPoints: segment has " << segment->getPorts().size() << " ports\n";
+    ELK_TRACE_DEBUG("    calculateBendPoints: segment has " << segment->getPorts().size() << " ports\n");
     for (LPort* port : segment->getPorts()) {
         double sourceY = port->getAbsoluteAnchor().y;
 
-        std::cerr << "      Port has " << port->getOutgoingEdges().size() << " outgoing edges\n";
+        ELK_TRACE_DEBUG("      Port has " << port->getOutgoingEdges().size() << " outgoing edges\n");
         for (LEdge* edge : port->getOutgoingEdges()) {
-            std::cerr << "        Processing edge\n";
+            ELK_TRACE_DEBUG("        Processing edge\n");
             if (!edge->isSelfLoop()) {
                 LPort* target = edge->getTarget();
                 double targetY = target->getAbsoluteAnchor().y;
 
-                std::cerr << "          sourceY=" << sourceY << " targetY=" << targetY << "\n";
+                ELK_TRACE_DEBUG("          sourceY=" << sourceY << " targetY=" << targetY << "\n");
                 if (std::abs(sourceY - targetY) > ORTHOGONAL_ROUTING_TOLERANCE) {
-                    std::cerr << "          Adding bend points to edge " << edge << ", current bendPoints=" << edge->getBendPoints().size() << "\n";
+                    ELK_TRACE_DEBUG("          Adding bend points to edge " << edge << ", current bendPoints=" << edge->getBendPoints().size() << "\n");
                     // We'll update these if we find that the segment was split
                     double currentX = segmentX;
                     HyperEdgeSegment* currentSegment = segment;
 
                     Point bend(currentX, sourceY);
                     edge->getBendPoints().push_back(bend);
-                    std::cerr << "          After push: bendPoints=" << edge->getBendPoints().size() << "\n";
+                    ELK_TRACE_DEBUG("          After push: bendPoints=" << edge->getBendPoints().size() << "\n");
                     addJunctionPointIfNecessary(edge, currentSegment, bend, true);
 
                     // If this segment was split, we need two additional bend points
@@ -18,17 +18,11 @@ LayoutOption* ConfigurationStore::getOption(const std::string& id) {
     return nullptr;
 }
 
-// Global configuration
-ConfigurationStore GlobalConfig::store_;
-
-const std::string GlobalConfig::ALGORITHM = "elk.algorithm";
-const std::string GlobalConfig::DIRECTION = "elk.direction";
-const std::string GlobalConfig::NODE_SPACING = "elk.spacing.node";
-const std::string GlobalConfig::LAYER_SPACING = "elk.spacing.layer";
-const std::string GlobalConfig::EDGE_ROUTING = "elk.edgeRouting";
-
-ConfigurationStore& GlobalConfig::instance() {
-    return store_;
-}
+// Common option keys
+const std::string CoreOptions::ALGORITHM = "elk.algorithm";
+const std::string CoreOptions::DIRECTION = "elk.direction";
+const std::string CoreOptions::NODE_SPACING = "elk.spacing.node";
+const std::string CoreOptions::LAYER_SPACING = "elk.spacing.layer";
+const std::string CoreOptions::EDGE_ROUTING = "elk.edgeRouting";
 
 } // namespace elk
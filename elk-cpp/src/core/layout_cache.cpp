@@ -0,0 +1,378 @@
+// Eclipse Layout Kernel - C++ Port
+// Layout cache implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/core/layout_cache.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace elk {
+
+// ============================================================================
+// LayoutSnapshot - Layout output of one graph, in preorder
+// ============================================================================
+
+namespace {
+
+constexpr std::uint32_t NO_SHAPE = 0xFFFFFFFFu;
+
+struct ShapeRef {
+    EdgeSection::ShapeType type = EdgeSection::ShapeType::NONE;
+    std::uint32_t index = NO_SHAPE;  // Preorder node or port number
+};
+
+struct Span {
+    std::uint32_t first = 0;
+    std::uint32_t count = 0;
+};
+
+struct NodeGeometry {
+    Point position;
+    Size size;
+};
+
+struct PortGeometry {
+    Point position;
+    PortSide side;
+    int index;
+};
+
+struct SectionGeometry {
+    Point start;
+    Point end;
+    Span bendPoints;
+    ShapeRef incoming;
+    ShapeRef outgoing;
+    std::string identifier;
+};
+
+struct EdgeGeometry {
+    Span sections;
+    Span junctionPoints;
+};
+
+} // namespace
+
+// Elements are visited in the same order as by fingerprint(): a node, its
+// labels, its ports with their labels, its edges with their labels, then
+// its children. Graphs with equal fingerprints visit the same sequence.
+struct LayoutSnapshot {
+    std::vector<NodeGeometry> nodes;
+    std::vector<PortGeometry> ports;
+    std::vector<EdgeGeometry> edges;
+    std::vector<SectionGeometry> sections;
+    std::vector<Point> labels;
+    std::vector<Point> points;  // Bend and junction points
+
+    std::size_t bytes() const {
+        std::size_t total = sizeof(LayoutSnapshot) +
+            nodes.capacity() * sizeof(NodeGeometry) +
+            ports.capacity() * sizeof(PortGeometry) +
+            edges.capacity() * sizeof(EdgeGeometry) +
+            sections.capacity() * sizeof(SectionGeometry) +
+            labels.capacity() * sizeof(Point) +
+            points.capacity() * sizeof(Point);
+        for (const auto& section : sections) {
+            // Short identifiers live inside the string object itself
+            if (section.identifier.capacity() > sizeof(std::string)) {
+                total += section.identifier.capacity();
+            }
+        }
+        return total;
+    }
+};
+
+namespace {
+
+Span appendPoints(std::vector<Point>& points, const std::vector<Point>& source) {
+    Span span{static_cast<std::uint32_t>(points.size()), static_cast<std::uint32_t>(source.size())};
+    points.insert(points.end(), source.begin(), source.end());
+    return span;
+}
+
+class SnapshotWriter {
+public:
+    std::shared_ptr<LayoutSnapshot> run(const Node& root) {
+        number(root);
+        snapshot_ = std::make_shared<LayoutSnapshot>();
+        snapshot_->nodes.reserve(nodeIndex_.size());
+        snapshot_->ports.reserve(portIndex_.size());
+        capture(root);
+        return std::move(snapshot_);
+    }
+
+private:
+    void number(const Node& node) {
+        nodeIndex_.emplace(&node, static_cast<std::uint32_t>(nodeIndex_.size()));
+        for (const auto& port : node.ports) {
+            portIndex_.emplace(port.get(), static_cast<std::uint32_t>(portIndex_.size()));
+        }
+        for (const auto& child : node.children) {
+            number(*child);
+        }
+    }
+
+    void capture(const Node& node) {
+        snapshot_->nodes.push_back({node.position, node.size});
+        captureLabels(node.labels);
+        for (const auto& port : node.ports) {
+            snapshot_->ports.push_back({port->position, port->side, port->index});
+            captureLabels(port->labels);
+        }
+        for (const auto& edge : node.edges) {
+            captureEdge(*edge);
+        }
+        for (const auto& child : node.children) {
+            capture(*child);
+        }
+    }
+
+    void captureEdge(const Edge& edge) {
+        EdgeGeometry geometry;
+        geometry.sections = {static_cast<std::uint32_t>(snapshot_->sections.size()),
+                             static_cast<std::uint32_t>(edge.sections.size())};
+        for (const auto& section : edge.sections) {
+            SectionGeometry out;
+            out.start = section.startPoint;
+            out.end = section.endPoint;
+            out.bendPoints = appendPoints(snapshot_->points, section.bendPoints);
+            out.incoming = shapeRef(section.incomingShapeType, section.incomingShape);
+            out.outgoing = shapeRef(section.outgoingShapeType, section.outgoingShape);
+            out.identifier = section.identifier;
+            snapshot_->sections.push_back(std::move(out));
+        }
+        geometry.junctionPoints = appendPoints(snapshot_->points, edge.junctionPoints);
+        snapshot_->edges.push_back(geometry);
+        captureLabels(edge.labels);
+    }
+
+    void captureLabels(const std::vector<Label>& labels) {
+        for (const auto& label : labels) {
+            snapshot_->labels.push_back(label.position);
+        }
+    }
+
+    // Shapes outside the hierarchy have no preorder number and are dropped
+    ShapeRef shapeRef(EdgeSection::ShapeType type, const void* shape) const {
+        if (type == EdgeSection::ShapeType::NODE) {
+            auto it = nodeIndex_.find(static_cast<const Node*>(shape));
+            if (it != nodeIndex_.end()) return {type, it->second};
+        } else if (type == EdgeSection::ShapeType::PORT) {
+            auto it = portIndex_.find(static_cast<const Port*>(shape));
+            if (it != portIndex_.end()) return {type, it->second};
+        }
+        return {};
+    }
+
+    std::shared_ptr<LayoutSnapshot> snapshot_;
+    std::unordered_map<const Node*, std::uint32_t> nodeIndex_;
+    std::unordered_map<const Port*, std::uint32_t> portIndex_;
+};
+
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const LayoutSnapshot& snapshot) : snapshot_(snapshot) {}
+
+    // False (with the graph untouched) if the graph does not have the shape
+    // of the snapshot, which only happens on a fingerprint collision
+    bool run(Node& root) {
+        number(root);
+        if (!matches()) return false;
+        nodeCursor_ = portCursor_ = edgeCursor_ = labelCursor_ = 0;
+        restore(root);
+        return true;
+    }
+
+private:
+    void number(Node& node) {
+        nodes_.push_back(&node);
+        for (auto& port : node.ports) {
+            ports_.push_back(port.get());
+        }
+        for (auto& child : node.children) {
+            number(*child);
+        }
+    }
+
+    bool matches() const {
+        if (nodes_.size() != snapshot_.nodes.size() || ports_.size() != snapshot_.ports.size()) {
+            return false;
+        }
+        std::size_t edges = 0;
+        std::size_t labels = 0;
+        for (const Node* node : nodes_) {
+            edges += node->edges.size();
+            labels += node->labels.size();
+            for (const auto& port : node->ports) labels += port->labels.size();
+            for (const auto& edge : node->edges) labels += edge->labels.size();
+        }
+        return edges == snapshot_.edges.size() && labels == snapshot_.labels.size();
+    }
+
+    void restore(Node& node) {
+        const NodeGeometry& geometry = snapshot_.nodes[nodeCursor_++];
+        node.position = geometry.position;
+        node.size = geometry.size;
+        restoreLabels(node.labels);
+        for (auto& port : node.ports) {
+            const PortGeometry& portGeometry = snapshot_.ports[portCursor_++];
+            port->position = portGeometry.position;
+            port->side = portGeometry.side;
+            port->index = portGeometry.index;
+            restoreLabels(port->labels);
+        }
+        for (auto& edge : node.edges) {
+            restoreEdge(*edge);
+        }
+        for (auto& child : node.children) {
+            restore(*child);
+        }
+    }
+
+    void restoreEdge(Edge& edge) {
+        const EdgeGeometry& geometry = snapshot_.edges[edgeCursor_++];
+        edge.sections.clear();
+        edge.sections.resize(geometry.sections.count);
+        for (std::uint32_t i = 0; i < geometry.sections.count; i++) {
+            const SectionGeometry& in = snapshot_.sections[geometry.sections.first + i];
+            EdgeSection& section = edge.sections[i];
+            section.parent = &edge;
+            section.startPoint = in.start;
+            section.endPoint = in.end;
+            section.bendPoints = points(in.bendPoints);
+            section.identifier = in.identifier;
+            setShape(in.incoming, section.incomingShape, section.incomingShapeType);
+            setShape(in.outgoing, section.outgoingShape, section.outgoingShapeType);
+        }
+        edge.junctionPoints = points(geometry.junctionPoints);
+        restoreLabels(edge.labels);
+    }
+
+    void restoreLabels(std::vector<Label>& labels) {
+        for (auto& label : labels) {
+            label.position = snapshot_.labels[labelCursor_++];
+        }
+    }
+
+    std::vector<Point> points(Span span) const {
+        auto first = snapshot_.points.begin() + span.first;
+        return std::vector<Point>(first, first + span.count);
+    }
+
+    void setShape(const ShapeRef& ref, void*& shape, EdgeSection::ShapeType& type) const {
+        type = ref.type;
+        switch (ref.type) {
+            case EdgeSection::ShapeType::NODE: shape = nodes_[ref.index]; break;
+            case EdgeSection::ShapeType::PORT: shape = ports_[ref.index]; break;
+            default: shape = nullptr; break;
+        }
+    }
+
+    const LayoutSnapshot& snapshot_;
+    std::vector<Node*> nodes_;
+    std::vector<Port*> ports_;
+    std::size_t nodeCursor_ = 0;
+    std::size_t portCursor_ = 0;
+    std::size_t edgeCursor_ = 0;
+    std::size_t labelCursor_ = 0;
+};
+
+} // namespace
+
+// ============================================================================
+// LayoutCache
+// ============================================================================
+
+LayoutCache::LayoutCache(ILayoutProvider& provider, std::size_t maxBytes)
+    : provider_(provider), maxBytes_(maxBytes) {}
+
+LayoutCache::~LayoutCache() = default;
+
+Fingerprint LayoutCache::key(const Node& graph) const {
+    Fingerprint structure = fingerprint(graph);
+    FingerprintHasher hasher;
+    hasher.add(structure.high);
+    hasher.add(structure.low);
+    hasher.add(std::string_view(provider_.getAlgorithmId()));
+    provider_.hashConfiguration(hasher);
+    return hasher.finish();
+}
+
+void LayoutCache::layout(Node* graph, ProgressCallback progress) {
+    if (!graph) return;
+
+    // A stored result the graph does not fit counts as a miss
+    Fingerprint graphKey = key(*graph);
+    std::shared_ptr<const LayoutSnapshot> snapshot = lookup(graphKey);
+    bool hit = snapshot && SnapshotReader(*snapshot).run(*graph);
+    count(hit);
+    if (hit) {
+        if (progress) progress("Layout cache hit", 1.0);
+        return;
+    }
+
+    provider_.layout(graph, progress);
+    insert(graphKey, SnapshotWriter().run(*graph));
+}
+
+std::shared_ptr<const LayoutSnapshot> LayoutCache::lookup(const Fingerprint& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = lookup_.find(key);
+    if (it == lookup_.end()) return nullptr;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->snapshot;
+}
+
+void LayoutCache::count(bool hit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (hit) {
+        stats_.hits++;
+    } else {
+        stats_.misses++;
+    }
+}
+
+void LayoutCache::insert(const Fingerprint& key, std::shared_ptr<const LayoutSnapshot> snapshot) {
+    std::size_t size = snapshot->bytes();
+    if (size > maxBytes_) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto existing = lookup_.find(key);
+    if (existing != lookup_.end()) {
+        // Another thread laid out the same graph meanwhile (or a collision
+        // made the stored result unusable); keep the newer result
+        stats_.bytes -= existing->second->snapshot->bytes();
+        entries_.erase(existing->second);
+        lookup_.erase(existing);
+    }
+
+    entries_.push_front({key, std::move(snapshot)});
+    lookup_[key] = entries_.begin();
+    stats_.bytes += size;
+
+    while (stats_.bytes > maxBytes_) {
+        Entry& oldest = entries_.back();
+        stats_.bytes -= oldest.snapshot->bytes();
+        lookup_.erase(oldest.key);
+        entries_.pop_back();
+        stats_.evictions++;
+    }
+    stats_.entries = entries_.size();
+}
+
+LayoutCacheStats LayoutCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void LayoutCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lookup_.clear();
+    stats_.entries = 0;
+    stats_.bytes = 0;
+}
+
+} // namespace elk
@@ -0,0 +1,126 @@
+// Eclipse Layout Kernel - C++ Port
+// Property registry implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/core/properties.h"
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace elk {
+
+namespace {
+
+// Keys are stored in fixed-size chunks that never move, so keyFor() can
+// read them without the lock
+constexpr int CHUNK_BITS = 8;
+constexpr int CHUNK_SIZE = 1 << CHUNK_BITS;
+constexpr int MAX_CHUNKS = 1 << 16;
+
+struct RegistryState {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string_view, int> ids;  // Views into the chunks
+    std::vector<std::unique_ptr<std::string[]>> storage;
+    std::array<std::atomic<const std::string*>, MAX_CHUNKS> chunks{};
+    int count = 0;
+};
+
+RegistryState& registryState() {
+    static RegistryState state;
+    return state;
+}
+
+constexpr std::string_view ECLIPSE_PREFIX = "org.eclipse.";
+
+std::string_view normalizeKey(std::string_view key) {
+    if (key.substr(0, ECLIPSE_PREFIX.size()) == ECLIPSE_PREFIX) {
+        key.remove_prefix(ECLIPSE_PREFIX.size());
+    }
+    return key;
+}
+
+} // namespace
+
+int PropertyRegistry::idFor(std::string_view key) {
+    RegistryState& state = registryState();
+    std::string_view normalized = normalizeKey(key);
+
+    {
+        std::shared_lock<std::shared_mutex> lock(state.mutex);
+        auto it = state.ids.find(normalized);
+        if (it != state.ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(state.mutex);
+    auto it = state.ids.find(normalized);
+    if (it != state.ids.end()) {
+        return it->second;
+    }
+    int id = state.count;
+    int chunk = id >> CHUNK_BITS;
+    if (chunk >= MAX_CHUNKS) {
+        throw std::length_error("Too many property keys");
+    }
+    if ((id & (CHUNK_SIZE - 1)) == 0) {
+        state.storage.push_back(std::make_unique<std::string[]>(CHUNK_SIZE));
+        state.chunks[chunk].store(state.storage.back().get(), std::memory_order_release);
+    }
+    std::string& stored = state.storage[chunk][id & (CHUNK_SIZE - 1)];
+    stored.assign(normalized);
+    state.ids.emplace(stored, id);
+    state.count++;
+    return id;
+}
+
+int PropertyRegistry::find(std::string_view key) {
+    RegistryState& state = registryState();
+    std::shared_lock<std::shared_mutex> lock(state.mutex);
+    auto it = state.ids.find(normalizeKey(key));
+    return it != state.ids.end() ? it->second : -1;
+}
+
+const std::string& PropertyRegistry::keyFor(int id) {
+    // An ID was handed out after its key was stored
+    RegistryState& state = registryState();
+    const std::string* chunk =
+        id >= 0 && (id >> CHUNK_BITS) < MAX_CHUNKS ? state.chunks[id >> CHUNK_BITS].load(std::memory_order_acquire)
+                                                   : nullptr;
+    if (chunk == nullptr) {
+        throw std::out_of_range("Unknown property ID");
+    }
+    return chunk[id & (CHUNK_SIZE - 1)];
+}
+
+bool PropertyHolder::toNumber(const std::any& value, double& number) {
+    if (const int* integer = std::any_cast<int>(&value)) {
+        number = *integer;
+        return true;
+    }
+    if (const std::int64_t* integer = std::any_cast<std::int64_t>(&value)) {
+        number = static_cast<double>(*integer);
+        return true;
+    }
+    if (const float* single = std::any_cast<float>(&value)) {
+        number = *single;
+        return true;
+    }
+    std::string_view text;
+    if (const std::string* string = std::any_cast<std::string>(&value)) {
+        text = *string;
+    } else if (const char* const* chars = std::any_cast<const char*>(&value)) {
+        text = *chars;
+    } else {
+        return false;
+    }
+    auto result = std::from_chars(text.data(), text.data() + text.size(), number);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+} // namespace elk
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: EPL-2.0
 
 #include "elk/core/recursive_layout.h"
+#include <algorithm>
 
 namespace elk {
 
@@ -15,7 +16,16 @@ void RecursiveLayoutEngine::layout(Node* root, ILayoutProvider* provider,
             layoutTopDown(root, provider, config);
             break;
         case RecursiveStrategy::BOTTOM_UP:
-            layoutBottomUp(root, provider, config);
+            if (config.parallel && config.layoutChildren) {
+                if (config.pool) {
+                    layoutBottomUpParallel(root, provider, config, *config.pool);
+                } else {
+                    WorkStealingPool pool(config.threads);
+                    layoutBottomUpParallel(root, provider, config, pool);
+                }
+            } else {
+                layoutBottomUp(root, provider, config);
+            }
             break;
         default:
             layoutTopDown(root, provider, config);
@@ -62,6 +72,35 @@ void RecursiveLayoutEngine::layoutBottomUp(Node* node, ILayoutProvider* provider
     }
 }
 
+void RecursiveLayoutEngine::layoutBottomUpParallel(Node* node, ILayoutProvider* provider,
+                                                  const RecursiveConfig& config,
+                                                  WorkStealingPool& pool) {
+    if (!node) return;
+
+    // Sibling subtrees are independent until this node is laid out. Only
+    // compound children become tasks; leaves are too cheap to be worth it.
+    {
+        TaskGroup siblings(pool);
+        for (auto& child : node->children) {
+            Node* subtree = child.get();
+            if (subtree->children.empty()) {
+                layoutBottomUp(subtree, provider, config);
+            } else {
+                siblings.run([=, &config, &pool]() {
+                    layoutBottomUpParallel(subtree, provider, config, pool);
+                });
+            }
+        }
+        siblings.wait();
+    }
+
+    provider->layout(node);
+
+    if (config.adjustParentSize) {
+        adjustParentSize(node, config);
+    }
+}
+
 void RecursiveLayoutEngine::adjustParentSize(Node* parent,
                                             const RecursiveConfig& config) {
     if (!parent || parent->children.empty()) return;
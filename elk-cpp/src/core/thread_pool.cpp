@@ -0,0 +1,150 @@
+// Eclipse Layout Kernel - C++ Port
+// Work-stealing thread pool implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/core/thread_pool.h"
+#include <algorithm>
+#include <utility>
+
+namespace elk {
+
+namespace {
+
+// Pool and queue of the worker running on this thread, if any
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local std::size_t currentIndex = 0;
+
+} // namespace
+
+// ============================================================================
+// WorkStealingPool
+// ============================================================================
+
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i <= threads; i++) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(threads);
+    for (unsigned i = 0; i < threads; i++) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+std::size_t WorkStealingPool::currentQueue() const {
+    return currentPool == this ? currentIndex : queues_.size() - 1;
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    Queue& queue = *queues_[currentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        // Under the sleep mutex so a worker cannot check queued_ and then
+        // miss the notification
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        queued_.fetch_add(1);
+    }
+    wake_.notify_one();
+}
+
+bool WorkStealingPool::popLocal(std::size_t index, std::function<void()>& task) {
+    Queue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(std::size_t thief, std::function<void()>& task) {
+    std::size_t count = queues_.size();
+    for (std::size_t offset = 1; offset <= count; offset++) {
+        Queue& queue = *queues_[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingPool::runPending() {
+    if (queued_.load() == 0) return false;
+
+    std::size_t index = currentQueue();
+    std::function<void()> task;
+    if (!popLocal(index, task) && !steal(index, task)) {
+        return false;
+    }
+    queued_.fetch_sub(1);
+    task();
+    return true;
+}
+
+void WorkStealingPool::workerLoop(std::size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    while (true) {
+        if (runPending()) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this]() { return stopping_ || queued_.load() > 0; });
+        if (stopping_ && queued_.load() == 0) return;
+    }
+}
+
+// ============================================================================
+// TaskGroup
+// ============================================================================
+
+TaskGroup::~TaskGroup() {
+    // Tasks may refer to the spawning frame; never leave while they run
+    while (pending_.load() > 0) {
+        if (!pool_.runPending()) std::this_thread::yield();
+    }
+}
+
+void TaskGroup::run(std::function<void()> task) {
+    pending_.fetch_add(1);
+    pool_.submit([this, task = std::move(task)]() {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+        pending_.fetch_sub(1);
+    });
+}
+
+void TaskGroup::wait() {
+    while (pending_.load() > 0) {
+        if (!pool_.runPending()) std::this_thread::yield();
+    }
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        std::swap(error, error_);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace elk
@@ -0,0 +1,215 @@
+// Eclipse Layout Kernel - C++ Port
+// Tracing implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/core/trace.h"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+namespace elk {
+namespace trace {
+
+namespace {
+
+thread_local Tracer* currentTracer = nullptr;
+
+const char* const COUNTER_NAMES[] = {
+    "reversed edges",
+    "dummy nodes",
+    "saved dummies",
+    "crossings",
+    "routing slots",
+    "node allocations",
+    "port allocations",
+    "edge allocations",
+};
+static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == static_cast<std::size_t>(Counter::COUNT),
+              "every counter needs a name");
+
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+const char* counterName(Counter counter) {
+    return COUNTER_NAMES[static_cast<std::size_t>(counter)];
+}
+
+double threadCpuMs() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0) {
+        return now.tv_sec * 1e3 + now.tv_nsec / 1e6;
+    }
+#endif
+    // Process CPU time; only meaningful while one thread is busy
+    return std::clock() * 1e3 / CLOCKS_PER_SEC;
+}
+
+// ============================================================================
+// Tracer
+// ============================================================================
+
+Tracer::Tracer() : logStream_(&std::cerr), origin_(std::chrono::steady_clock::now()) {}
+
+void Tracer::log(const std::string& message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    *logStream_ << message;
+}
+
+void Tracer::addPhase(const char* name, std::chrono::steady_clock::time_point start,
+                      double wallMs, double cpuMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(phases_.begin(), phases_.end(),
+                           [name](const PhaseStats& phase) { return phase.name == name; });
+    if (it == phases_.end()) {
+        phases_.push_back(PhaseStats{name});
+        it = phases_.end() - 1;
+    }
+    it->calls++;
+    it->wallMs += wallMs;
+    it->cpuMs += cpuMs;
+
+    if (recordEvents_) {
+        double startUs = std::chrono::duration<double, std::micro>(start - origin_).count();
+        events_.push_back(Event{name, startUs, wallMs * 1e3, cpuMs * 1e3, threadNumber()});
+    }
+}
+
+void Tracer::count(Counter counter, std::int64_t delta) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    counters_[static_cast<std::size_t>(counter)] += delta;
+}
+
+std::int64_t Tracer::counter(Counter counter) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return counters_[static_cast<std::size_t>(counter)];
+}
+
+std::vector<PhaseStats> Tracer::phases() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return phases_;
+}
+
+void Tracer::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    phases_.clear();
+    counters_.fill(0);
+    events_.clear();
+    threads_.clear();
+    origin_ = std::chrono::steady_clock::now();
+}
+
+int Tracer::threadNumber() {
+    // Called with mutex_ held
+    std::thread::id self = std::this_thread::get_id();
+    auto it = std::find(threads_.begin(), threads_.end(), self);
+    if (it != threads_.end()) {
+        return static_cast<int>(it - threads_.begin()) + 1;
+    }
+    threads_.push_back(self);
+    return static_cast<int>(threads_.size());
+}
+
+void Tracer::writeSummary(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << std::left << std::setw(24) << "phase" << std::right << std::setw(8) << "calls"
+        << std::setw(14) << "wall ms" << std::setw(14) << "cpu ms" << "\n";
+    for (const PhaseStats& phase : phases_) {
+        out << std::left << std::setw(24) << phase.name << std::right << std::setw(8) << phase.calls
+            << std::setw(14) << phase.wallMs << std::setw(14) << phase.cpuMs << "\n";
+    }
+    for (std::size_t i = 0; i < counters_.size(); i++) {
+        out << std::left << std::setw(24) << COUNTER_NAMES[i] << std::right << std::setw(8) << counters_[i] << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Tracer::writeChromeTrace(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    double endUs = 0.0;
+    for (const Event& event : events_) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":";
+        writeJsonString(out, event.name);
+        out << ",\"cat\":\"elk\",\"ph\":\"X\",\"ts\":" << event.startUs << ",\"dur\":" << event.wallUs
+            << ",\"pid\":1,\"tid\":" << event.thread << ",\"args\":{\"cpu_us\":" << event.cpuUs << "}}";
+        endUs = std::max(endUs, event.startUs + event.wallUs);
+    }
+    for (std::size_t i = 0; i < counters_.size(); i++) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":";
+        writeJsonString(out, COUNTER_NAMES[i]);
+        out << ",\"cat\":\"elk\",\"ph\":\"C\",\"ts\":" << endUs << ",\"pid\":1,\"args\":{\"value\":"
+            << counters_[i] << "}}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+// ============================================================================
+// Thread binding and timers
+// ============================================================================
+
+Tracer* current() {
+    return currentTracer;
+}
+
+TraceScope::TraceScope(Tracer& tracer) : previous_(currentTracer) {
+    currentTracer = &tracer;
+}
+
+TraceScope::~TraceScope() {
+    currentTracer = previous_;
+}
+
+PhaseTimer::PhaseTimer(const char* name) : tracer_(currentTracer), name_(name) {
+    if (tracer_) {
+        wallStart_ = std::chrono::steady_clock::now();
+        cpuStart_ = threadCpuMs();
+    }
+}
+
+PhaseTimer::~PhaseTimer() {
+    if (tracer_) {
+        double cpuMs = threadCpuMs() - cpuStart_;
+        double wallMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - wallStart_).count();
+        tracer_->addPhase(name_, wallStart_, wallMs, cpuMs);
+    }
+}
+
+void write(Level level, const std::string& message) {
+    if (Tracer* tracer = currentTracer) {
+        if (tracer->logs(level)) tracer->log(message);
+    } else if (level == Level::WARN) {
+        std::cerr << message;
+    }
+}
+
+} // namespace trace
+} // namespace elk
@@ -0,0 +1,323 @@
+// Eclipse Layout Kernel - C++ Port
+// Structural fingerprint implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/graph/fingerprint.h"
+#include "elk/graph/graph.h"
+#include <algorithm>
+#include <any>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace elk {
+
+namespace {
+
+constexpr std::uint64_t C1 = 0x87c37b91114253d5ull;
+constexpr std::uint64_t C2 = 0x4cf5ad432745937full;
+
+std::uint64_t rotl(std::uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+std::uint64_t fmix(std::uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+// Tags that separate element kinds in the hashed stream
+enum Tag : std::uint64_t {
+    TAG_NODE = 1,
+    TAG_PORT,
+    TAG_EDGE,
+    TAG_LABEL,
+    TAG_OPTIONS,
+    TAG_NODE_REF,
+    TAG_PORT_REF,
+    TAG_FOREIGN_REF,
+    TAG_STRING,
+    TAG_NUMBER,
+    TAG_BOOLEAN,
+};
+
+// Two passes: the first numbers nodes and ports in preorder so that edges
+// can refer to them by position; the second hashes the tree in that order.
+class GraphFingerprinter {
+public:
+    explicit GraphFingerprinter(const FingerprintOptions& options) : options_(options) {}
+
+    Fingerprint run(const Node& root) {
+        number(root);
+        hashNode(root, true);
+        return hasher_.finish();
+    }
+
+private:
+    void number(const Node& node) {
+        nodeIndex_.emplace(&node, nodeIndex_.size());
+        for (const auto& port : node.ports) {
+            portIndex_.emplace(port.get(), portIndex_.size());
+        }
+        for (const auto& child : node.children) {
+            number(*child);
+        }
+    }
+
+    void hashNode(const Node& node, bool isRoot) {
+        hasher_.add(static_cast<std::uint64_t>(TAG_NODE));
+        hashId(node.id);
+        // The size of the root and of compound nodes is computed by layout
+        if (!isRoot && node.children.empty()) {
+            hasher_.add(node.size.width);
+            hasher_.add(node.size.height);
+        }
+        hasher_.add(node.padding.top);
+        hasher_.add(node.padding.right);
+        hasher_.add(node.padding.bottom);
+        hasher_.add(node.padding.left);
+        hashOptions(node);
+        hashLabels(node.labels);
+
+        hasher_.add(static_cast<std::uint64_t>(node.ports.size()));
+        for (const auto& port : node.ports) {
+            hashPort(*port);
+        }
+
+        hasher_.add(static_cast<std::uint64_t>(node.edges.size()));
+        for (const auto& edge : node.edges) {
+            hashEdge(*edge);
+        }
+
+        hasher_.add(static_cast<std::uint64_t>(node.children.size()));
+        for (const auto& child : node.children) {
+            hashNode(*child, false);
+        }
+    }
+
+    void hashPort(const Port& port) {
+        hasher_.add(static_cast<std::uint64_t>(TAG_PORT));
+        hashId(port.id);
+        hasher_.add(static_cast<std::uint64_t>(port.side));
+        hasher_.add(port.index);
+        hasher_.add(port.position.x);
+        hasher_.add(port.position.y);
+        hasher_.add(port.size.width);
+        hasher_.add(port.size.height);
+        hashOptions(port);
+        hashLabels(port.labels);
+    }
+
+    void hashEdge(const Edge& edge) {
+        hasher_.add(static_cast<std::uint64_t>(TAG_EDGE));
+        hashId(edge.id);
+        hashEndpoints(edge.sourcePorts, edge.sourceNodes);
+        hashEndpoints(edge.targetPorts, edge.targetNodes);
+        hashOptions(edge);
+        hashLabels(edge.labels);
+    }
+
+    void hashEndpoints(const std::vector<Port*>& ports, const std::vector<Node*>& nodes) {
+        hasher_.add(static_cast<std::uint64_t>(ports.size()));
+        for (const Port* port : ports) {
+            auto it = portIndex_.find(port);
+            if (it != portIndex_.end()) {
+                hasher_.add(static_cast<std::uint64_t>(TAG_PORT_REF));
+                hasher_.add(static_cast<std::uint64_t>(it->second));
+            } else {
+                hashForeign(port->id);
+            }
+        }
+        hasher_.add(static_cast<std::uint64_t>(nodes.size()));
+        for (const Node* node : nodes) {
+            auto it = nodeIndex_.find(node);
+            if (it != nodeIndex_.end()) {
+                hasher_.add(static_cast<std::uint64_t>(TAG_NODE_REF));
+                hasher_.add(static_cast<std::uint64_t>(it->second));
+            } else {
+                hashForeign(node->id);
+            }
+        }
+    }
+
+    // Endpoint outside the hashed hierarchy; only its ID identifies it
+    void hashForeign(const ElementId& id) {
+        hasher_.add(static_cast<std::uint64_t>(TAG_FOREIGN_REF));
+        hasher_.add(std::string_view(id.str()));
+    }
+
+    void hashLabels(const std::vector<Label>& labels) {
+        if (!options_.labels) return;
+        hasher_.add(static_cast<std::uint64_t>(labels.size()));
+        for (const Label& label : labels) {
+            hasher_.add(static_cast<std::uint64_t>(TAG_LABEL));
+            hasher_.add(label.size.width);
+            hasher_.add(label.size.height);
+            hashOptions(label);
+        }
+    }
+
+    void hashId(const ElementId& id) {
+        if (options_.ids) {
+            hasher_.add(std::string_view(id.str()));
+        }
+    }
+
+    // Options are sorted by key text: storage order depends on the order in
+    // which they were set, and registry IDs on the order keys were first seen
+    void hashOptions(const PropertyHolder& holder) {
+        optionScratch_.clear();
+        holder.forEachProperty([&](int id, const std::any& value) {
+            if (value.type() == typeid(std::string) || value.type() == typeid(double) ||
+                value.type() == typeid(int) || value.type() == typeid(bool)) {
+                optionScratch_.emplace_back(&PropertyRegistry::keyFor(id), &value);
+            }
+        });
+        std::sort(optionScratch_.begin(), optionScratch_.end(),
+                  [](const auto& a, const auto& b) { return *a.first < *b.first; });
+
+        hasher_.add(static_cast<std::uint64_t>(TAG_OPTIONS));
+        hasher_.add(static_cast<std::uint64_t>(optionScratch_.size()));
+        for (const auto& option : optionScratch_) {
+            hasher_.add(std::string_view(*option.first));
+            const std::any& value = *option.second;
+            if (const std::string* text = std::any_cast<std::string>(&value)) {
+                hasher_.add(static_cast<std::uint64_t>(TAG_STRING));
+                hasher_.add(std::string_view(*text));
+            } else if (const double* real = std::any_cast<double>(&value)) {
+                hasher_.add(static_cast<std::uint64_t>(TAG_NUMBER));
+                hasher_.add(*real);
+            } else if (const int* integer = std::any_cast<int>(&value)) {
+                // Same value as the double a reader would have produced
+                hasher_.add(static_cast<std::uint64_t>(TAG_NUMBER));
+                hasher_.add(static_cast<double>(*integer));
+            } else {
+                hasher_.add(static_cast<std::uint64_t>(TAG_BOOLEAN));
+                hasher_.add(*std::any_cast<bool>(&value));
+            }
+        }
+    }
+
+    const FingerprintOptions& options_;
+    FingerprintHasher hasher_;
+    std::unordered_map<const Node*, std::size_t> nodeIndex_;
+    std::unordered_map<const Port*, std::size_t> portIndex_;
+    std::vector<std::pair<const std::string*, const std::any*>> optionScratch_;
+};
+
+} // namespace
+
+// ============================================================================
+// Fingerprint
+// ============================================================================
+
+std::string Fingerprint::hex() const {
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string text(32, '0');
+    for (int i = 0; i < 16; i++) {
+        text[15 - i] = DIGITS[(high >> (4 * i)) & 0xF];
+        text[31 - i] = DIGITS[(low >> (4 * i)) & 0xF];
+    }
+    return text;
+}
+
+// ============================================================================
+// FingerprintHasher
+// ============================================================================
+
+void FingerprintHasher::add(std::uint64_t value) {
+    length_ += 8;
+    if (!hasPending_) {
+        pending_ = value;
+        hasPending_ = true;
+        return;
+    }
+    mixBlock(pending_, value);
+    hasPending_ = false;
+}
+
+void FingerprintHasher::add(double value) {
+    if (value == 0.0) {
+        value = 0.0;
+    } else if (std::isnan(value)) {
+        value = std::numeric_limits<double>::quiet_NaN();
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    add(bits);
+}
+
+void FingerprintHasher::add(std::string_view text) {
+    add(static_cast<std::uint64_t>(text.size()));
+    std::uint64_t word = 0;
+    int shift = 0;
+    for (char c : text) {
+        word |= static_cast<std::uint64_t>(static_cast<unsigned char>(c)) << shift;
+        shift += 8;
+        if (shift == 64) {
+            add(word);
+            word = 0;
+            shift = 0;
+        }
+    }
+    if (shift != 0) {
+        add(word);
+    }
+}
+
+void FingerprintHasher::mixBlock(std::uint64_t k1, std::uint64_t k2) {
+    k1 *= C1;
+    k1 = rotl(k1, 31);
+    k1 *= C2;
+    h1_ ^= k1;
+    h1_ = rotl(h1_, 27);
+    h1_ += h2_;
+    h1_ = h1_ * 5 + 0x52dce729;
+
+    k2 *= C2;
+    k2 = rotl(k2, 33);
+    k2 *= C1;
+    h2_ ^= k2;
+    h2_ = rotl(h2_, 31);
+    h2_ += h1_;
+    h2_ = h2_ * 5 + 0x38495ab5;
+}
+
+Fingerprint FingerprintHasher::finish() const {
+    std::uint64_t h1 = h1_;
+    std::uint64_t h2 = h2_;
+    if (hasPending_) {
+        std::uint64_t k1 = pending_ * C1;
+        k1 = rotl(k1, 31);
+        k1 *= C2;
+        h1 ^= k1;
+    }
+    h1 ^= length_;
+    h2 ^= length_;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix(h1);
+    h2 = fmix(h2);
+    h1 += h2;
+    h2 += h1;
+    return Fingerprint{h2, h1};
+}
+
+// ============================================================================
+// Graph fingerprints
+// ============================================================================
+
+Fingerprint fingerprint(const Node& root, const FingerprintOptions& options) {
+    GraphFingerprinter fingerprinter(options);
+    return fingerprinter.run(root);
+}
+
+} // namespace elk
@@ -0,0 +1,68 @@
+// Eclipse Layout Kernel - C++ Port
+// Graph arena implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/graph/graph_arena.h"
+#include <cstdint>
+#include <cstdlib>
+
+namespace elk {
+
+GraphArena::GraphArena(std::size_t blockSize)
+    : blockSize_(blockSize < 1024 ? 1024 : blockSize) {}
+
+GraphArena::~GraphArena() {
+    release();
+}
+
+void* GraphArena::allocate(std::size_t size, std::size_t alignment) {
+    std::uintptr_t current = reinterpret_cast<std::uintptr_t>(cursor_);
+    std::uintptr_t aligned = (current + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+
+    if (cursor_ == nullptr || aligned + size > reinterpret_cast<std::uintptr_t>(end_)) {
+        addBlock(size + alignment);
+        current = reinterpret_cast<std::uintptr_t>(cursor_);
+        aligned = (current + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+    }
+
+    cursor_ = reinterpret_cast<char*>(aligned + size);
+    bytesAllocated_ += size;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void GraphArena::addBlock(std::size_t minSize) {
+    std::size_t size = minSize > blockSize_ ? minSize : blockSize_;
+    void* raw = std::malloc(sizeof(Block) + size);
+    if (raw == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    Block* block = static_cast<Block*>(raw);
+    block->next = head_;
+    block->size = size;
+    head_ = block;
+
+    cursor_ = reinterpret_cast<char*>(block + 1);
+    end_ = cursor_ + size;
+
+    bytesReserved_ += size;
+    blockCount_++;
+}
+
+void GraphArena::release() {
+    Block* block = head_;
+    while (block != nullptr) {
+        Block* next = block->next;
+        std::free(block);
+        block = next;
+    }
+
+    head_ = nullptr;
+    cursor_ = nullptr;
+    end_ = nullptr;
+    bytesAllocated_ = 0;
+    bytesReserved_ = 0;
+    blockCount_ = 0;
+}
+
+} // namespace elk
@@ -0,0 +1,119 @@
+// Eclipse Layout Kernel - C++ Port
+// Graph index implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/graph/graph_index.h"
+#include "elk/graph/graph.h"
+
+namespace elk {
+
+void GraphIndex::build(Node* root) {
+    clear();
+    if (root != nullptr) {
+        indexSubtree(root);
+    }
+}
+
+void GraphIndex::clear() {
+    table_ = nullptr;
+    nodes_.clear();
+    ports_.clear();
+    edges_.clear();
+    reusedNodes_.clear();
+    reusedPorts_.clear();
+}
+
+void GraphIndex::indexSubtree(Node* node) {
+    addNode(node);
+    for (auto& port : node->ports) {
+        addPort(port.get());
+    }
+    for (auto& edge : node->edges) {
+        addEdge(edge.get());
+    }
+    for (auto& child : node->children) {
+        indexSubtree(child.get());
+    }
+}
+
+Symbol GraphIndex::keyFor(const ElementId& id) {
+    if (table_ == nullptr) {
+        table_ = id.table();
+    }
+    return id.table() == table_ ? id.symbol() : table_->intern(id.str());
+}
+
+bool GraphIndex::lookup(const std::string& text, Symbol& symbol) const {
+    return table_ != nullptr && table_->find(text, symbol);
+}
+
+bool GraphIndex::lookup(const ElementId& id, Symbol& symbol) const {
+    if (table_ == nullptr || id.empty()) {
+        return false;
+    }
+    if (id.table() == table_) {
+        symbol = id.symbol();
+        return true;
+    }
+    return table_->find(id.str(), symbol);
+}
+
+void GraphIndex::addNode(Node* node) {
+    if (!node->id.empty()) {
+        Symbol key = keyFor(node->id);
+        auto [it, added] = nodes_.try_emplace(key, node);
+        if (!added) {
+            it->second = node;
+            reusedNodes_.insert(key);
+        }
+    }
+}
+
+void GraphIndex::addPort(Port* port) {
+    if (!port->id.empty()) {
+        Symbol key = keyFor(port->id);
+        auto [it, added] = ports_.try_emplace(key, port);
+        if (!added) {
+            it->second = port;
+            reusedPorts_.insert(key);
+        }
+    }
+}
+
+void GraphIndex::addEdge(Edge* edge) {
+    if (!edge->id.empty()) {
+        edges_[keyFor(edge->id)] = edge;
+    }
+}
+
+Node* GraphIndex::findNode(const std::string& id) const {
+    Symbol symbol;
+    return lookup(id, symbol) ? get(nodes_, symbol) : nullptr;
+}
+
+Port* GraphIndex::findPort(const std::string& id) const {
+    Symbol symbol;
+    return lookup(id, symbol) ? get(ports_, symbol) : nullptr;
+}
+
+Edge* GraphIndex::findEdge(const std::string& id) const {
+    Symbol symbol;
+    return lookup(id, symbol) ? get(edges_, symbol) : nullptr;
+}
+
+Node* GraphIndex::findNode(const ElementId& id) const {
+    Symbol symbol;
+    return lookup(id, symbol) ? get(nodes_, symbol) : nullptr;
+}
+
+Port* GraphIndex::findPort(const ElementId& id) const {
+    Symbol symbol;
+    return lookup(id, symbol) ? get(ports_, symbol) : nullptr;
+}
+
+Edge* GraphIndex::findEdge(const ElementId& id) const {
+    Symbol symbol;
+    return lookup(id, symbol) ? get(edges_, symbol) : nullptr;
+}
+
+} // namespace elk
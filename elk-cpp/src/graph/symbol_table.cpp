@@ -0,0 +1,73 @@
+// Eclipse Layout Kernel - C++ Port
+// Symbol table implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/graph/symbol_table.h"
+#include <mutex>
+#include <stdexcept>
+
+namespace elk {
+
+SymbolTable::SymbolTable() {
+    intern(std::string_view());
+}
+
+SymbolTable::~SymbolTable() {
+    for (std::atomic<Entry*>& chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+Symbol SymbolTable::intern(std::string_view text) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = symbols_.find(text);
+        if (it != symbols_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = symbols_.find(text);
+    if (it != symbols_.end()) {
+        return it->second;
+    }
+    if (size_ > UINT32_MAX) {
+        throw std::length_error("Too many symbols");
+    }
+
+    // Readers only see the new entry through a symbol handed out after it
+    // was written, but may read earlier entries of its chunk meanwhile
+    Symbol symbol = static_cast<Symbol>(size_++);
+    std::size_t offset = 0;
+    int chunk = chunkOf(symbol, offset);
+    Entry* entries = chunks_[chunk].load(std::memory_order_relaxed);
+    if (entries == nullptr) {
+        entries = new Entry[FIRST_CHUNK << chunk];
+        chunks_[chunk].store(entries, std::memory_order_release);
+    }
+    Entry& entry = entries[offset];
+    entry.text.assign(text);
+    entry.hash = std::hash<std::string_view>{}(text);
+    entry.symbol = symbol;
+    entry.table = this;
+    symbols_.emplace(std::string_view(entry.text), symbol);
+    return symbol;
+}
+
+bool SymbolTable::find(std::string_view text, Symbol& symbol) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = symbols_.find(text);
+    if (it == symbols_.end()) {
+        return false;
+    }
+    symbol = it->second;
+    return true;
+}
+
+std::size_t SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return static_cast<std::size_t>(size_);
+}
+
+} // namespace elk
@@ -0,0 +1,633 @@
+// Eclipse Layout Kernel - C++ Port
+// Binary graph format implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/io/binary_format.h"
+#include "elk/io/mapped_file.h"
+#include <any>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace elk {
+namespace io {
+
+using namespace binary;
+
+static_assert(sizeof(Header) == 176, "binary layout changed");
+static_assert(sizeof(NodeRecord) == 112, "binary layout changed");
+static_assert(sizeof(PortRecord) == 64, "binary layout changed");
+static_assert(sizeof(EdgeRecord) == 56, "binary layout changed");
+static_assert(sizeof(EndpointRecord) == 8, "binary layout changed");
+static_assert(sizeof(SectionRecord) == 64, "binary layout changed");
+static_assert(sizeof(LabelRecord) == 48, "binary layout changed");
+static_assert(sizeof(PointRecord) == 16, "binary layout changed");
+static_assert(sizeof(OptionRecord) == 24, "binary layout changed");
+static_assert(sizeof(StringRecord) == 8, "binary layout changed");
+
+namespace {
+
+constexpr std::size_t ALIGNMENT = 8;
+
+std::size_t alignUp(std::size_t offset) {
+    return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+std::uint32_t checkedIndex(std::size_t size) {
+    if (size > std::numeric_limits<std::uint32_t>::max()) {
+        throw BinaryFormatError("graph too large for 32-bit indices");
+    }
+    return static_cast<std::uint32_t>(size);
+}
+
+// ----------------------------------------------------------------------------
+// Writer
+// ----------------------------------------------------------------------------
+
+// Flattens the tree into the record tables, then lays them out after the
+// header. Node and port indices are assigned in a first breadth-first pass
+// so edges and sections can refer to elements anywhere in the hierarchy.
+class BinaryGraphWriter {
+public:
+    void write(const Node& root, std::string& out) {
+        collect(root);
+        for (std::size_t i = 0; i < nodeOrder_.size(); i++) {
+            flattenNode(i);
+        }
+        emit(out);
+    }
+
+private:
+    void collect(const Node& root) {
+        nodeOrder_.push_back(&root);
+        for (std::size_t i = 0; i < nodeOrder_.size(); i++) {
+            const Node* node = nodeOrder_[i];
+            nodeIndex_[node] = checkedIndex(i);
+            for (const auto& child : node->children) {
+                nodeOrder_.push_back(child.get());
+            }
+            for (const auto& port : node->ports) {
+                portIndex_[port.get()] = checkedIndex(portIndex_.size());
+            }
+        }
+        nodes_.resize(nodeOrder_.size());
+    }
+
+    void flattenNode(std::size_t i) {
+        const Node& node = *nodeOrder_[i];
+        NodeRecord& record = nodes_[i];
+        record.id = intern(node.id.str());
+        record.parent = i == 0 ? NONE : nodeIndex_[node.parent];
+        record.x = node.position.x;
+        record.y = node.position.y;
+        record.width = node.size.width;
+        record.height = node.size.height;
+        record.paddingTop = node.padding.top;
+        record.paddingRight = node.padding.right;
+        record.paddingBottom = node.padding.bottom;
+        record.paddingLeft = node.padding.left;
+
+        // Children were appended breadth-first, so they are contiguous
+        record.children = Range{NONE, checkedIndex(node.children.size())};
+        if (!node.children.empty()) {
+            record.children.first = nodeIndex_[node.children.front().get()];
+        }
+
+        record.ports.first = checkedIndex(ports_.size());
+        for (const auto& port : node.ports) {
+            flattenPort(*port, static_cast<std::uint32_t>(i));
+        }
+        record.ports.count = checkedIndex(node.ports.size());
+
+        record.edges.first = checkedIndex(edges_.size());
+        for (const auto& edge : node.edges) {
+            flattenEdge(*edge, static_cast<std::uint32_t>(i));
+        }
+        record.edges.count = checkedIndex(node.edges.size());
+
+        record.labels = flattenLabels(node.labels);
+        record.options = flattenOptions(node);
+    }
+
+    void flattenPort(const Port& port, std::uint32_t node) {
+        PortRecord record{};
+        record.id = intern(port.id.str());
+        record.node = node;
+        record.side = static_cast<std::uint32_t>(port.side);
+        record.index = port.index;
+        record.x = port.position.x;
+        record.y = port.position.y;
+        record.width = port.size.width;
+        record.height = port.size.height;
+        record.labels = flattenLabels(port.labels);
+        record.options = flattenOptions(port);
+        ports_.push_back(record);
+    }
+
+    void flattenEdge(const Edge& edge, std::uint32_t container) {
+        EdgeRecord record{};
+        record.id = intern(edge.id.str());
+        record.container = container;
+        record.sources = flattenEndpoints(edge.sourcePorts, edge.sourceNodes);
+        record.targets = flattenEndpoints(edge.targetPorts, edge.targetNodes);
+
+        record.sections.first = checkedIndex(sections_.size());
+        for (const EdgeSection& section : edge.sections) {
+            SectionRecord sectionRecord{};
+            sectionRecord.id = intern(section.identifier);
+            sectionRecord.incomingShape = shape(section.getIncomingNode(), section.getIncomingPort());
+            sectionRecord.outgoingShape = shape(section.getOutgoingNode(), section.getOutgoingPort());
+            sectionRecord.bendPoints = flattenPoints(section.bendPoints);
+            sectionRecord.startX = section.startPoint.x;
+            sectionRecord.startY = section.startPoint.y;
+            sectionRecord.endX = section.endPoint.x;
+            sectionRecord.endY = section.endPoint.y;
+            sections_.push_back(sectionRecord);
+        }
+        record.sections.count = checkedIndex(edge.sections.size());
+
+        record.junctionPoints = flattenPoints(edge.junctionPoints);
+        record.labels = flattenLabels(edge.labels);
+        record.options = flattenOptions(edge);
+        edges_.push_back(record);
+    }
+
+    Range flattenEndpoints(const std::vector<Port*>& ports, const std::vector<Node*>& nodes) {
+        Range range{checkedIndex(endpoints_.size()), 0};
+        for (const Port* port : ports) {
+            endpoints_.push_back(shape(nullptr, port));
+        }
+        for (const Node* node : nodes) {
+            endpoints_.push_back(shape(node, nullptr));
+        }
+        range.count = checkedIndex(ports.size() + nodes.size());
+        return range;
+    }
+
+    EndpointRecord shape(const Node* node, const Port* port) {
+        if (port != nullptr) {
+            auto it = portIndex_.find(port);
+            if (it == portIndex_.end()) {
+                throw BinaryFormatError("edge refers to port '" + port->id.str() + "' outside the graph");
+            }
+            return EndpointRecord{ShapeKind::PORT, it->second};
+        }
+        if (node != nullptr) {
+            auto it = nodeIndex_.find(node);
+            if (it == nodeIndex_.end()) {
+                throw BinaryFormatError("edge refers to node '" + node->id.str() + "' outside the graph");
+            }
+            return EndpointRecord{ShapeKind::NODE, it->second};
+        }
+        return EndpointRecord{ShapeKind::NONE, NONE};
+    }
+
+    Range flattenPoints(const std::vector<Point>& points) {
+        Range range{checkedIndex(points_.size()), checkedIndex(points.size())};
+        for (const Point& point : points) {
+            points_.push_back(PointRecord{point.x, point.y});
+        }
+        return range;
+    }
+
+    Range flattenLabels(const std::vector<Label>& labels) {
+        Range range{checkedIndex(labels_.size()), checkedIndex(labels.size())};
+        for (const Label& label : labels) {
+            LabelRecord record{};
+            record.id = intern(label.id.str());
+            record.text = intern(label.text);
+            record.options = flattenOptions(label);
+            record.x = label.position.x;
+            record.y = label.position.y;
+            record.width = label.size.width;
+            record.height = label.size.height;
+            labels_.push_back(record);
+        }
+        return range;
+    }
+
+    // Same value types as the JSON writer; other properties are internal
+    Range flattenOptions(const PropertyHolder& holder) {
+        Range range{checkedIndex(options_.size()), 0};
+        holder.forEachProperty([&](int id, const std::any& value) {
+            OptionRecord record{};
+            if (const std::string* text = std::any_cast<std::string>(&value)) {
+                record.type = OptionType::STRING;
+                record.text = intern(*text);
+            } else if (const double* real = std::any_cast<double>(&value)) {
+                record.type = OptionType::NUMBER;
+                record.number = *real;
+            } else if (const int* integer = std::any_cast<int>(&value)) {
+                record.type = OptionType::NUMBER;
+                record.number = *integer;
+            } else if (const bool* flag = std::any_cast<bool>(&value)) {
+                record.type = OptionType::BOOLEAN;
+                record.flag = *flag ? 1 : 0;
+            } else {
+                return;
+            }
+            record.key = intern(PropertyRegistry::keyFor(id));
+            options_.push_back(record);
+            range.count++;
+        });
+        return range;
+    }
+
+    std::uint32_t intern(const std::string& text) {
+        auto it = stringIndex_.find(text);
+        if (it != stringIndex_.end()) {
+            return it->second;
+        }
+        if (chars_.size() + text.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw BinaryFormatError("string data exceeds 4 GiB");
+        }
+        std::uint32_t index = checkedIndex(strings_.size());
+        strings_.push_back(StringRecord{static_cast<std::uint32_t>(chars_.size()),
+                                        static_cast<std::uint32_t>(text.size())});
+        chars_.append(text);
+        stringIndex_.emplace(text, index);
+        return index;
+    }
+
+    template<typename T>
+    static Table place(std::size_t& offset, const std::vector<T>& records) {
+        offset = alignUp(offset);
+        Table table{offset, records.size()};
+        offset += records.size() * sizeof(T);
+        return table;
+    }
+
+    template<typename T>
+    static void copyTable(std::string& out, std::size_t base, const Table& table, const std::vector<T>& records) {
+        if (!records.empty()) {
+            std::memcpy(&out[base + table.offset], records.data(), records.size() * sizeof(T));
+        }
+    }
+
+    void emit(std::string& out) {
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.byteOrder = BYTE_ORDER_MARK;
+
+        std::size_t offset = sizeof(Header);
+        header.nodes = place(offset, nodes_);
+        header.ports = place(offset, ports_);
+        header.edges = place(offset, edges_);
+        header.endpoints = place(offset, endpoints_);
+        header.sections = place(offset, sections_);
+        header.labels = place(offset, labels_);
+        header.points = place(offset, points_);
+        header.options = place(offset, options_);
+        header.strings = place(offset, strings_);
+        offset = alignUp(offset);
+        header.chars = Table{offset, chars_.size()};
+        offset += chars_.size();
+
+        // Tables are aligned relative to the start of the graph, so the
+        // graph itself must start at an aligned position within out
+        std::size_t base = alignUp(out.size());
+        out.resize(base + offset, '\0');
+        std::memcpy(&out[base], &header, sizeof(header));
+        copyTable(out, base, header.nodes, nodes_);
+        copyTable(out, base, header.ports, ports_);
+        copyTable(out, base, header.edges, edges_);
+        copyTable(out, base, header.endpoints, endpoints_);
+        copyTable(out, base, header.sections, sections_);
+        copyTable(out, base, header.labels, labels_);
+        copyTable(out, base, header.points, points_);
+        copyTable(out, base, header.options, options_);
+        copyTable(out, base, header.strings, strings_);
+        if (!chars_.empty()) {
+            std::memcpy(&out[base + header.chars.offset], chars_.data(), chars_.size());
+        }
+    }
+
+    std::vector<const Node*> nodeOrder_;
+    std::unordered_map<const Node*, std::uint32_t> nodeIndex_;
+    std::unordered_map<const Port*, std::uint32_t> portIndex_;
+    std::unordered_map<std::string, std::uint32_t> stringIndex_;
+
+    std::vector<NodeRecord> nodes_;
+    std::vector<PortRecord> ports_;
+    std::vector<EdgeRecord> edges_;
+    std::vector<EndpointRecord> endpoints_;
+    std::vector<SectionRecord> sections_;
+    std::vector<LabelRecord> labels_;
+    std::vector<PointRecord> points_;
+    std::vector<OptionRecord> options_;
+    std::vector<StringRecord> strings_;
+    std::string chars_;
+};
+
+// ----------------------------------------------------------------------------
+// Reader
+// ----------------------------------------------------------------------------
+
+// Rebuilds the element tree from a validated view. Every index and range
+// read from the file is bounds-checked before use.
+class BinaryGraphReader {
+public:
+    BinaryGraphReader(const BinaryGraphView& view, GraphDocument& document)
+        : view_(view), document_(document), symbols_(document.symbols.get()),
+          stringSymbols_(view.stringCount(), NONE),
+          stringProperties_(view.stringCount(), -1) {}
+
+    void read() {
+        std::size_t nodeCount = view_.nodeCount();
+        if (nodeCount == 0) {
+            throw BinaryFormatError("graph has no root node");
+        }
+        nodes_.assign(nodeCount, nullptr);
+        ports_.assign(view_.portCount(), nullptr);
+        nodes_[0] = document_.root.get();
+
+        // Parents precede their children, so one forward pass creates
+        // every node before its own children are visited
+        for (std::size_t i = 0; i < nodeCount; i++) {
+            if (nodes_[i] == nullptr) {
+                throw BinaryFormatError("node " + std::to_string(i) + " is not reachable from the root");
+            }
+            readNode(view_.nodes()[i], nodes_[i]);
+        }
+        for (std::size_t i = 0; i < nodeCount; i++) {
+            readEdges(view_.nodes()[i], nodes_[i]);
+        }
+        indexGraphDocument(document_);
+    }
+
+private:
+    void readNode(const NodeRecord& record, Node* node) {
+        node->id = id(record.id);
+        node->position = Point(record.x, record.y);
+        node->size = Size(record.width, record.height);
+        node->padding.top = record.paddingTop;
+        node->padding.right = record.paddingRight;
+        node->padding.bottom = record.paddingBottom;
+        node->padding.left = record.paddingLeft;
+        readLabels(record.labels, node->labels, node, Label::ParentType::NODE);
+        readOptions(record.options, *node);
+
+        checkRange(record.children, view_.nodeCount(), "children");
+        for (std::uint32_t c = 0; c < record.children.count; c++) {
+            std::uint32_t index = record.children.first + c;
+            if (nodes_[index] != nullptr || index == 0) {
+                throw BinaryFormatError("node " + std::to_string(index) + " has more than one parent");
+            }
+            nodes_[index] = node->addChild();
+        }
+
+        checkRange(record.ports, view_.portCount(), "ports");
+        for (std::uint32_t p = 0; p < record.ports.count; p++) {
+            std::uint32_t index = record.ports.first + p;
+            const PortRecord& portRecord = view_.ports()[index];
+            if (ports_[index] != nullptr) {
+                throw BinaryFormatError("port " + std::to_string(index) + " has more than one node");
+            }
+            if (portRecord.side > static_cast<std::uint32_t>(PortSide::WEST)) {
+                throw BinaryFormatError("invalid port side");
+            }
+            Port* port = node->addPort();
+            port->id = id(portRecord.id);
+            port->side = static_cast<PortSide>(portRecord.side);
+            port->index = portRecord.index;
+            port->position = Point(portRecord.x, portRecord.y);
+            port->size = Size(portRecord.width, portRecord.height);
+            readLabels(portRecord.labels, port->labels, port, Label::ParentType::PORT);
+            readOptions(portRecord.options, *port);
+            ports_[index] = port;
+        }
+    }
+
+    void readEdges(const NodeRecord& record, Node* node) {
+        checkRange(record.edges, view_.edgeCount(), "edges");
+        for (std::uint32_t e = 0; e < record.edges.count; e++) {
+            const EdgeRecord& edgeRecord = view_.edges()[record.edges.first + e];
+            Edge* edge = node->addEdge();
+            edge->id = id(edgeRecord.id);
+            readEndpoints(edgeRecord.sources, edge, true);
+            readEndpoints(edgeRecord.targets, edge, false);
+
+            checkRange(edgeRecord.sections, view_.header().sections.count, "sections");
+            edge->sections.resize(edgeRecord.sections.count);
+            for (std::uint32_t s = 0; s < edgeRecord.sections.count; s++) {
+                const SectionRecord& sectionRecord = view_.sections()[edgeRecord.sections.first + s];
+                EdgeSection& section = edge->sections[s];
+                section.parent = edge;
+                section.identifier = std::string(view_.string(sectionRecord.id));
+                section.startPoint = Point(sectionRecord.startX, sectionRecord.startY);
+                section.endPoint = Point(sectionRecord.endX, sectionRecord.endY);
+                readPoints(sectionRecord.bendPoints, section.bendPoints);
+                if (Port* port = portAt(sectionRecord.incomingShape)) section.setIncomingPort(port);
+                else if (Node* shapeNode = nodeAt(sectionRecord.incomingShape)) section.setIncomingNode(shapeNode);
+                if (Port* port = portAt(sectionRecord.outgoingShape)) section.setOutgoingPort(port);
+                else if (Node* shapeNode = nodeAt(sectionRecord.outgoingShape)) section.setOutgoingNode(shapeNode);
+            }
+
+            readPoints(edgeRecord.junctionPoints, edge->junctionPoints);
+            readLabels(edgeRecord.labels, edge->labels, edge, Label::ParentType::EDGE);
+            readOptions(edgeRecord.options, *edge);
+        }
+    }
+
+    void readEndpoints(const Range& range, Edge* edge, bool source) {
+        checkRange(range, view_.header().endpoints.count, "endpoints");
+        for (std::uint32_t i = 0; i < range.count; i++) {
+            const EndpointRecord& endpoint = view_.endpoints()[range.first + i];
+            if (Port* port = portAt(endpoint)) {
+                (source ? edge->sourcePorts : edge->targetPorts).push_back(port);
+                (source ? port->outgoingEdges : port->incomingEdges).push_back(edge);
+            } else if (Node* node = nodeAt(endpoint)) {
+                (source ? edge->sourceNodes : edge->targetNodes).push_back(node);
+                (source ? node->outgoingEdges : node->incomingEdges).push_back(edge);
+            } else {
+                throw BinaryFormatError("edge '" + edge->id.str() + "' has an empty endpoint");
+            }
+        }
+    }
+
+    Port* portAt(const EndpointRecord& endpoint) const {
+        if (endpoint.kind != ShapeKind::PORT) return nullptr;
+        if (endpoint.index >= ports_.size()) {
+            throw BinaryFormatError("port index out of range");
+        }
+        return ports_[endpoint.index];
+    }
+
+    Node* nodeAt(const EndpointRecord& endpoint) const {
+        if (endpoint.kind != ShapeKind::NODE) return nullptr;
+        if (endpoint.index >= nodes_.size()) {
+            throw BinaryFormatError("node index out of range");
+        }
+        return nodes_[endpoint.index];
+    }
+
+    void readPoints(const Range& range, std::vector<Point>& points) {
+        checkRange(range, view_.header().points.count, "points");
+        points.reserve(range.count);
+        for (std::uint32_t i = 0; i < range.count; i++) {
+            const PointRecord& point = view_.points()[range.first + i];
+            points.emplace_back(point.x, point.y);
+        }
+    }
+
+    void readLabels(const Range& range, std::vector<Label>& labels, void* parent, Label::ParentType parentType) {
+        checkRange(range, view_.header().labels.count, "labels");
+        labels.reserve(range.count);
+        for (std::uint32_t i = 0; i < range.count; i++) {
+            const LabelRecord& record = view_.labels()[range.first + i];
+            labels.emplace_back(std::string(view_.string(record.text)), record.width, record.height);
+            Label& label = labels.back();
+            label.id = id(record.id);
+            label.position = Point(record.x, record.y);
+            label.parent = parent;
+            label.parentType = parentType;
+            readOptions(record.options, label);
+        }
+    }
+
+    void readOptions(const Range& range, PropertyHolder& holder) {
+        checkRange(range, view_.header().options.count, "options");
+        for (std::uint32_t i = 0; i < range.count; i++) {
+            const OptionRecord& option = view_.options()[range.first + i];
+            int key = propertyId(option.key);
+            switch (option.type) {
+                case OptionType::STRING:
+                    holder.setPropertyValue(key, std::string(view_.string(option.text)));
+                    break;
+                case OptionType::NUMBER:
+                    holder.setPropertyValue(key, option.number);
+                    break;
+                case OptionType::BOOLEAN:
+                    holder.setPropertyValue(key, option.flag != 0);
+                    break;
+                default:
+                    throw BinaryFormatError("unknown option type");
+            }
+        }
+    }
+
+    // Each distinct string is interned (or registered as an option key) once
+    ElementId id(std::uint32_t index) {
+        std::string_view text = view_.string(index);
+        if (stringSymbols_[index] == NONE) {
+            stringSymbols_[index] = symbols_->intern(text);
+        }
+        return ElementId(symbols_, stringSymbols_[index]);
+    }
+
+    int propertyId(std::uint32_t index) {
+        std::string_view text = view_.string(index);
+        if (stringProperties_[index] < 0) {
+            stringProperties_[index] = PropertyRegistry::idFor(text);
+        }
+        return stringProperties_[index];
+    }
+
+    static void checkRange(const Range& range, std::uint64_t size, const char* what) {
+        if (range.count == 0) return;
+        if (range.first > size || range.count > size - range.first) {
+            throw BinaryFormatError(std::string(what) + " range out of bounds");
+        }
+    }
+
+    const BinaryGraphView& view_;
+    GraphDocument& document_;
+    SymbolTable* symbols_;
+    std::vector<Node*> nodes_;
+    std::vector<Port*> ports_;
+    std::vector<Symbol> stringSymbols_;  // NONE until first use
+    std::vector<int> stringProperties_;  // -1 until first use
+};
+
+} // namespace
+
+// ============================================================================
+// BinaryGraphView
+// ============================================================================
+
+BinaryGraphView::BinaryGraphView(std::string_view bytes) : bytes_(bytes) {
+    if (bytes.size() < sizeof(Header) || !isElkBinary(bytes)) {
+        throw BinaryFormatError("missing header");
+    }
+    if (reinterpret_cast<std::uintptr_t>(bytes.data()) % ALIGNMENT != 0) {
+        throw BinaryFormatError("buffer is not 8-byte aligned");
+    }
+    header_ = reinterpret_cast<const Header*>(bytes.data());
+    if (header_->byteOrder != BYTE_ORDER_MARK) {
+        throw BinaryFormatError("written with a different byte order");
+    }
+    if (header_->version != VERSION) {
+        throw BinaryFormatError("unsupported version " + std::to_string(header_->version));
+    }
+
+    auto check = [&](const Table& table, std::size_t recordSize, const char* name) {
+        if (table.offset % ALIGNMENT != 0 || table.offset > bytes.size() ||
+            table.count > (bytes.size() - table.offset) / recordSize) {
+            throw BinaryFormatError(std::string(name) + " table out of bounds");
+        }
+    };
+    check(header_->nodes, sizeof(NodeRecord), "node");
+    check(header_->ports, sizeof(PortRecord), "port");
+    check(header_->edges, sizeof(EdgeRecord), "edge");
+    check(header_->endpoints, sizeof(EndpointRecord), "endpoint");
+    check(header_->sections, sizeof(SectionRecord), "section");
+    check(header_->labels, sizeof(LabelRecord), "label");
+    check(header_->points, sizeof(PointRecord), "point");
+    check(header_->options, sizeof(OptionRecord), "option");
+    check(header_->strings, sizeof(StringRecord), "string");
+    if (header_->chars.offset > bytes.size() || header_->chars.count > bytes.size() - header_->chars.offset) {
+        throw BinaryFormatError("character data out of bounds");
+    }
+}
+
+std::string_view BinaryGraphView::string(std::uint32_t index) const {
+    if (index >= header_->strings.count) {
+        throw BinaryFormatError("string index out of range");
+    }
+    const StringRecord& record = table<StringRecord>(header_->strings)[index];
+    if (static_cast<std::uint64_t>(record.offset) + record.length > header_->chars.count) {
+        throw BinaryFormatError("string out of bounds");
+    }
+    return std::string_view(bytes_.data() + header_->chars.offset + record.offset, record.length);
+}
+
+// ============================================================================
+// Reading and writing
+// ============================================================================
+
+void writeElkBinary(const Node& root, std::string& out) {
+    BinaryGraphWriter writer;
+    writer.write(root, out);
+}
+
+void writeElkBinaryFile(const Node& root, const std::string& path) {
+    std::string out;
+    writeElkBinary(root, out);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+}
+
+GraphDocument readElkBinary(std::string_view bytes, const ReadOptions& options) {
+    BinaryGraphView view(bytes);
+    GraphDocument document = makeGraphDocument(options);
+    BinaryGraphReader reader(view, document);
+    reader.read();
+    return document;
+}
+
+GraphDocument readElkBinaryFile(const std::string& path, const ReadOptions& options) {
+    MappedFile file(path);
+    return readElkBinary(file.view(), options);
+}
+
+bool isElkBinary(std::string_view bytes) {
+    return bytes.size() >= sizeof(MAGIC) && std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+} // namespace io
+} // namespace elk
@@ -0,0 +1,40 @@
+// Eclipse Layout Kernel - C++ Port
+// Graph document helpers
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/io/graph_document.h"
+
+namespace elk {
+namespace io {
+
+namespace {
+
+void attachIndex(Node* node, GraphIndex* index) {
+    node->index = index;
+    for (auto& child : node->children) {
+        attachIndex(child.get(), index);
+    }
+}
+
+} // namespace
+
+GraphDocument makeGraphDocument(const ReadOptions& options) {
+    GraphDocument document;
+    if (options.useArena) {
+        document.arena = std::make_unique<GraphArena>();
+    }
+    document.symbols = std::make_unique<SymbolTable>();
+    document.index = std::make_unique<GraphIndex>();
+    document.root = std::make_unique<Node>();
+    document.root->arena = document.arena.get();
+    document.root->symbols = document.symbols.get();
+    return document;
+}
+
+void indexGraphDocument(GraphDocument& document) {
+    document.index->build(document.root.get());
+    attachIndex(document.root.get(), document.index.get());
+}
+
+} // namespace io
+} // namespace elk
@@ -0,0 +1,607 @@
+// Eclipse Layout Kernel - C++ Port
+// Streaming ELK JSON reader implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/io/json_reader.h"
+#include "elk/io/mapped_file.h"
+#include <charconv>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace elk {
+namespace io {
+
+namespace {
+
+PortSide parsePortSide(std::string_view value) {
+    if (value == "NORTH") return PortSide::NORTH;
+    if (value == "SOUTH") return PortSide::SOUTH;
+    if (value == "EAST") return PortSide::EAST;
+    if (value == "WEST") return PortSide::WEST;
+    return PortSide::UNDEFINED;
+}
+
+void appendUtf8(std::string& out, std::uint32_t code) {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+// Recursive descent over the input, creating graph elements as their
+// objects are entered. Strings are returned as views into the input unless
+// they contain escapes, in which case they are decoded into a scratch buffer.
+// Edge endpoints may refer to elements that appear later in the input, so
+// they are recorded by symbol and resolved once the whole tree exists.
+// Objects and arrays may nest at most MAX_DEPTH deep, which bounds the
+// recursion on hostile input.
+class ElkJsonParser {
+public:
+    static constexpr int MAX_DEPTH = 4096;
+
+    ElkJsonParser(std::string_view input, GraphDocument& document)
+        : input_(input), document_(document), symbols_(document.symbols.get()) {}
+
+    void parse() {
+        if (input_.substr(0, 3) == "\xEF\xBB\xBF") {
+            pos_ = 3;
+        }
+        if (peek() != '{') {
+            fail("Expected a graph object");
+        }
+        parseNode(document_.root.get());
+        skipWhitespace();
+        if (pos_ != input_.size()) {
+            fail("Unexpected characters after the graph");
+        }
+        resolveReferences();
+    }
+
+private:
+    struct PendingEndpoint {
+        Edge* edge;
+        Symbol id;
+        bool source;
+        std::size_t offset;
+    };
+
+    struct PendingShape {
+        Edge* edge;
+        std::size_t section;
+        Symbol id;
+        bool incoming;
+        std::size_t offset;
+    };
+
+    // ------------------------------------------------------------------------
+    // Graph elements
+    // ------------------------------------------------------------------------
+
+    void parseNode(Node* node) {
+        parseObject([&](std::string_view key) {
+            if (key == "id") {
+                node->id = parseId();
+            } else if (key == "x") {
+                parseNumber(node->position.x);
+            } else if (key == "y") {
+                parseNumber(node->position.y);
+            } else if (key == "width") {
+                parseNumber(node->size.width);
+            } else if (key == "height") {
+                parseNumber(node->size.height);
+            } else if (key == "children") {
+                parseArray([&]() { parseNode(node->addChild()); });
+            } else if (key == "ports") {
+                parseArray([&]() { parsePort(node->addPort()); });
+            } else if (key == "edges") {
+                parseArray([&]() { parseEdge(node->addEdge()); });
+            } else if (key == "labels") {
+                parseLabels(node->labels, node, Label::ParentType::NODE);
+            } else if (key == "layoutOptions" || key == "properties") {
+                parseLayoutOptions(*node, nullptr);
+            } else {
+                skipValue();
+            }
+        });
+    }
+
+    void parsePort(Port* port) {
+        port->index = static_cast<int>(port->parent->ports.size()) - 1;
+        parseObject([&](std::string_view key) {
+            if (key == "id") {
+                port->id = parseId();
+            } else if (key == "x") {
+                parseNumber(port->position.x);
+            } else if (key == "y") {
+                parseNumber(port->position.y);
+            } else if (key == "width") {
+                parseNumber(port->size.width);
+            } else if (key == "height") {
+                parseNumber(port->size.height);
+            } else if (key == "labels") {
+                parseLabels(port->labels, port, Label::ParentType::PORT);
+            } else if (key == "layoutOptions" || key == "properties") {
+                parseLayoutOptions(*port, port);
+            } else {
+                skipValue();
+            }
+        });
+    }
+
+    void parseEdge(Edge* edge) {
+        // Primitive form; turned into endpoints once the object is complete
+        Symbol source = 0, sourcePort = 0, target = 0, targetPort = 0;
+        std::size_t sourceOffset = 0, targetOffset = 0;
+
+        parseObject([&](std::string_view key) {
+            if (key == "id") {
+                edge->id = parseId();
+            } else if (key == "sources" || key == "targets") {
+                bool isSource = key == "sources";
+                parseArray([&]() {
+                    std::size_t offset = pos_;
+                    endpoints_.push_back(PendingEndpoint{edge, parseSymbol(), isSource, offset});
+                });
+            } else if (key == "source") {
+                sourceOffset = pos_;
+                source = parseSymbol();
+            } else if (key == "sourcePort") {
+                sourceOffset = pos_;
+                sourcePort = parseSymbol();
+            } else if (key == "target") {
+                targetOffset = pos_;
+                target = parseSymbol();
+            } else if (key == "targetPort") {
+                targetOffset = pos_;
+                targetPort = parseSymbol();
+            } else if (key == "sections") {
+                parseArray([&]() { parseSection(edge); });
+            } else if (key == "junctionPoints") {
+                parseArray([&]() {
+                    edge->junctionPoints.emplace_back();
+                    parsePoint(edge->junctionPoints.back());
+                });
+            } else if (key == "labels") {
+                parseLabels(edge->labels, edge, Label::ParentType::EDGE);
+            } else if (key == "layoutOptions" || key == "properties") {
+                parseLayoutOptions(*edge, nullptr);
+            } else {
+                skipValue();
+            }
+        });
+
+        if (sourcePort != 0 || source != 0) {
+            endpoints_.push_back(PendingEndpoint{edge, sourcePort != 0 ? sourcePort : source, true, sourceOffset});
+        }
+        if (targetPort != 0 || target != 0) {
+            endpoints_.push_back(PendingEndpoint{edge, targetPort != 0 ? targetPort : target, false, targetOffset});
+        }
+    }
+
+    void parseSection(Edge* edge) {
+        std::size_t sectionIndex = edge->sections.size();
+        edge->sections.emplace_back();
+        edge->sections.back().parent = edge;
+
+        parseObject([&](std::string_view key) {
+            EdgeSection& section = edge->sections[sectionIndex];
+            if (key == "id") {
+                section.identifier = std::string(parseString(valueScratch_));
+            } else if (key == "startPoint") {
+                parsePoint(section.startPoint);
+            } else if (key == "endPoint") {
+                parsePoint(section.endPoint);
+            } else if (key == "bendPoints") {
+                parseArray([&]() {
+                    section.bendPoints.emplace_back();
+                    parsePoint(section.bendPoints.back());
+                });
+            } else if (key == "incomingShape" || key == "outgoingShape") {
+                bool incoming = key == "incomingShape";
+                std::size_t offset = pos_;
+                shapes_.push_back(PendingShape{edge, sectionIndex, parseSymbol(), incoming, offset});
+            } else {
+                skipValue();
+            }
+        });
+    }
+
+    void parseLabels(std::vector<Label>& labels, void* parent, Label::ParentType parentType) {
+        parseArray([&]() {
+            labels.emplace_back();
+            Label& label = labels.back();
+            label.parent = parent;
+            label.parentType = parentType;
+            parseObject([&](std::string_view key) {
+                if (key == "id") {
+                    label.id = parseId();
+                } else if (key == "text") {
+                    label.text = std::string(parseString(valueScratch_));
+                } else if (key == "x") {
+                    parseNumber(label.position.x);
+                } else if (key == "y") {
+                    parseNumber(label.position.y);
+                } else if (key == "width") {
+                    parseNumber(label.size.width);
+                } else if (key == "height") {
+                    parseNumber(label.size.height);
+                } else if (key == "layoutOptions" || key == "properties") {
+                    parseLayoutOptions(label, nullptr);
+                } else {
+                    skipValue();
+                }
+            });
+        });
+    }
+
+    void parsePoint(Point& point) {
+        parseObject([&](std::string_view key) {
+            if (key == "x") {
+                parseNumber(point.x);
+            } else if (key == "y") {
+                parseNumber(point.y);
+            } else {
+                skipValue();
+            }
+        });
+    }
+
+    void parseLayoutOptions(PropertyHolder& holder, Port* port) {
+        parseObject([&](std::string_view key) {
+            int id = propertyId(key);
+            char c = peek();
+            if (c == '"') {
+                std::string_view value = parseString(valueScratch_);
+                if (port != nullptr && id == LayoutOptions::PORT_SIDE.id()) {
+                    port->side = parsePortSide(value);
+                }
+                holder.setPropertyValue(id, std::string(value));
+            } else if (c == 't' || c == 'f') {
+                holder.setPropertyValue(id, parseBool());
+            } else if (c == '-' || (c >= '0' && c <= '9')) {
+                double value = 0.0;
+                parseNumber(value);
+                holder.setPropertyValue(id, value);
+            } else {
+                skipValue();
+            }
+        });
+    }
+
+    // Registry ID for an option key; keys that are views into the input are
+    // cached so each distinct key is normalized and looked up only once
+    int propertyId(std::string_view key) {
+        bool inInput = key.data() >= input_.data() && key.data() < input_.data() + input_.size();
+        if (inInput) {
+            auto it = propertyIds_.find(key);
+            if (it != propertyIds_.end()) {
+                return it->second;
+            }
+        }
+        int id = PropertyRegistry::idFor(key);
+        if (inInput) {
+            propertyIds_.emplace(key, id);
+        }
+        return id;
+    }
+
+    ElementId parseId() {
+        return ElementId(symbols_, parseSymbol());
+    }
+
+    Symbol parseSymbol() {
+        if (peek() != '"') {
+            fail("Expected an ID string");
+        }
+        return symbols_->intern(parseString(valueScratch_));
+    }
+
+    // ------------------------------------------------------------------------
+    // Reference resolution
+    // ------------------------------------------------------------------------
+
+    void resolveReferences() {
+        indexGraphDocument(document_);
+        GraphIndex* index = document_.index.get();
+
+        for (const PendingEndpoint& endpoint : endpoints_) {
+            ElementId id(symbols_, endpoint.id);
+            Edge* edge = endpoint.edge;
+            if (Port* port = index->findPort(id)) {
+                if (endpoint.source) {
+                    edge->sourcePorts.push_back(port);
+                    port->outgoingEdges.push_back(edge);
+                } else {
+                    edge->targetPorts.push_back(port);
+                    port->incomingEdges.push_back(edge);
+                }
+            } else if (Node* node = index->findNode(id)) {
+                if (endpoint.source) {
+                    edge->sourceNodes.push_back(node);
+                    node->outgoingEdges.push_back(edge);
+                } else {
+                    edge->targetNodes.push_back(node);
+                    node->incomingEdges.push_back(edge);
+                }
+            } else {
+                throw JsonReadError("Unknown edge endpoint '" + id.str() + "'", endpoint.offset);
+            }
+        }
+
+        for (const PendingShape& shape : shapes_) {
+            ElementId id(symbols_, shape.id);
+            EdgeSection& section = shape.edge->sections[shape.section];
+            if (Port* port = index->findPort(id)) {
+                if (shape.incoming) section.setIncomingPort(port); else section.setOutgoingPort(port);
+            } else if (Node* node = index->findNode(id)) {
+                if (shape.incoming) section.setIncomingNode(node); else section.setOutgoingNode(node);
+            } else {
+                throw JsonReadError("Unknown section shape '" + id.str() + "'", shape.offset);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Lexical layer
+    // ------------------------------------------------------------------------
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw JsonReadError(message, pos_);
+    }
+
+    void skipWhitespace() {
+        while (pos_ < input_.size()) {
+            char c = input_[pos_];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+            pos_++;
+        }
+    }
+
+    // Next significant character, or '\0' at the end of the input
+    char peek() {
+        skipWhitespace();
+        return pos_ < input_.size() ? input_[pos_] : '\0';
+    }
+
+    void expect(char c) {
+        if (peek() != c) {
+            fail(std::string("Expected '") + c + "'");
+        }
+        pos_++;
+    }
+
+    bool consume(char c) {
+        if (peek() == c) {
+            pos_++;
+            return true;
+        }
+        return false;
+    }
+
+    // Calls onMember(key) with the position at the member's value; the
+    // callback must consume the value
+    template<typename F>
+    void parseObject(F&& onMember) {
+        expect('{');
+        enter();
+        if (!consume('}')) {
+            do {
+                if (peek() != '"') {
+                    fail("Expected a member name");
+                }
+                std::string_view key = parseString(keyScratch_);
+                expect(':');
+                onMember(key);
+            } while (consume(','));
+            expect('}');
+        }
+        depth_--;
+    }
+
+    // Calls onElement() with the position at each element
+    template<typename F>
+    void parseArray(F&& onElement) {
+        expect('[');
+        enter();
+        if (!consume(']')) {
+            do {
+                onElement();
+            } while (consume(','));
+            expect(']');
+        }
+        depth_--;
+    }
+
+    void enter() {
+        if (++depth_ > MAX_DEPTH) {
+            fail("Nesting deeper than " + std::to_string(MAX_DEPTH) + " levels");
+        }
+    }
+
+    std::string_view parseString(std::string& scratch) {
+        expect('"');
+        std::size_t start = pos_;
+        while (pos_ < input_.size()) {
+            char c = input_[pos_];
+            if (c == '"') {
+                return input_.substr(start, pos_++ - start);
+            }
+            if (c == '\\') {
+                scratch.assign(input_.data() + start, pos_ - start);
+                return parseEscapedString(scratch);
+            }
+            pos_++;
+        }
+        fail("Unterminated string");
+    }
+
+    // Continues a string at its first backslash, decoding into scratch
+    std::string_view parseEscapedString(std::string& scratch) {
+        while (pos_ < input_.size()) {
+            char c = input_[pos_++];
+            if (c == '"') {
+                return scratch;
+            }
+            if (c != '\\') {
+                scratch += c;
+                continue;
+            }
+            if (pos_ >= input_.size()) break;
+            char escape = input_[pos_++];
+            switch (escape) {
+                case '"': scratch += '"'; break;
+                case '\\': scratch += '\\'; break;
+                case '/': scratch += '/'; break;
+                case 'b': scratch += '\b'; break;
+                case 'f': scratch += '\f'; break;
+                case 'n': scratch += '\n'; break;
+                case 'r': scratch += '\r'; break;
+                case 't': scratch += '\t'; break;
+                case 'u': {
+                    // Surrogates are only valid as a high-low pair
+                    std::uint32_t code = parseHex4();
+                    if (code >= 0xDC00 && code < 0xE000) {
+                        fail("Unpaired low surrogate");
+                    }
+                    if (code >= 0xD800 && code < 0xDC00) {
+                        if (input_.substr(pos_, 2) != "\\u") {
+                            fail("Unpaired high surrogate");
+                        }
+                        pos_ += 2;
+                        std::uint32_t low = parseHex4();
+                        if (low < 0xDC00 || low >= 0xE000) {
+                            fail("Invalid low surrogate");
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(scratch, code);
+                    break;
+                }
+                default:
+                    fail("Invalid escape sequence");
+            }
+        }
+        fail("Unterminated string");
+    }
+
+    std::uint32_t parseHex4() {
+        if (pos_ + 4 > input_.size()) {
+            fail("Truncated \\u escape");
+        }
+        std::uint32_t code = 0;
+        auto result = std::from_chars(input_.data() + pos_, input_.data() + pos_ + 4, code, 16);
+        if (result.ptr != input_.data() + pos_ + 4) {
+            fail("Invalid \\u escape");
+        }
+        pos_ += 4;
+        return code;
+    }
+
+    // Reads a number into value; numeric strings (as some netlists carry for
+    // fixed positions) are accepted too, and null leaves value unchanged
+    void parseNumber(double& value) {
+        char c = peek();
+        if (c == 'n') {
+            parseLiteral("null");
+            return;
+        }
+        if (c == '"') {
+            std::size_t offset = pos_;
+            std::string_view text = parseString(valueScratch_);
+            auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+                throw JsonReadError("Expected a number", offset);
+            }
+            return;
+        }
+        auto result = std::from_chars(input_.data() + pos_, input_.data() + input_.size(), value);
+        if (result.ec != std::errc()) {
+            fail("Expected a number");
+        }
+        pos_ = static_cast<std::size_t>(result.ptr - input_.data());
+    }
+
+    bool parseBool() {
+        if (peek() == 't') {
+            parseLiteral("true");
+            return true;
+        }
+        parseLiteral("false");
+        return false;
+    }
+
+    void parseLiteral(std::string_view literal) {
+        if (input_.substr(pos_, literal.size()) != literal) {
+            fail("Invalid literal");
+        }
+        pos_ += literal.size();
+    }
+
+    void skipValue() {
+        switch (peek()) {
+            case '{':
+                parseObject([&](std::string_view) { skipValue(); });
+                break;
+            case '[':
+                parseArray([&]() { skipValue(); });
+                break;
+            case '"':
+                parseString(valueScratch_);
+                break;
+            case 't':
+                parseLiteral("true");
+                break;
+            case 'f':
+                parseLiteral("false");
+                break;
+            case 'n':
+                parseLiteral("null");
+                break;
+            default: {
+                double ignored;
+                parseNumber(ignored);
+            }
+        }
+    }
+
+    std::string_view input_;
+    std::size_t pos_ = 0;
+    int depth_ = 0;  // Objects and arrays currently open
+    GraphDocument& document_;
+    SymbolTable* symbols_;
+
+    std::string keyScratch_;
+    std::string valueScratch_;
+    std::unordered_map<std::string_view, int> propertyIds_;
+    std::vector<PendingEndpoint> endpoints_;
+    std::vector<PendingShape> shapes_;
+};
+
+} // namespace
+
+GraphDocument readElkJson(std::string_view json, const ReadOptions& options) {
+    GraphDocument document = makeGraphDocument(options);
+    ElkJsonParser parser(json, document);
+    parser.parse();
+    return document;
+}
+
+GraphDocument readElkJsonFile(const std::string& path, const ReadOptions& options) {
+    MappedFile file(path);
+    return readElkJson(file.view(), options);
+}
+
+} // namespace io
+} // namespace elk
@@ -0,0 +1,476 @@
+// Eclipse Layout Kernel - C++ Port
+// Streaming ELK JSON writer implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/io/json_writer.h"
+#include <algorithm>
+#include <any>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ELK_HAVE_POSIX_IO 1
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <io.h>
+#endif
+
+namespace elk {
+namespace io {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// JsonStream - Buffered JSON token writer
+// ----------------------------------------------------------------------------
+
+// Tracks just enough state (element count per open container) to place
+// commas and, when indenting, line breaks in the layout JSON.stringify uses.
+// Output is collected in a fixed buffer and handed to the sink when full.
+class JsonStream {
+public:
+    JsonStream(std::string* out, int fd, int indent) : out_(out), fd_(fd), indent_(indent) {
+        counts_.reserve(32);
+    }
+
+    void beginObject() { beginContainer('{'); }
+    void endObject() { endContainer('}'); }
+    void beginArray() { beginContainer('['); }
+    void endArray() { endContainer(']'); }
+
+    void key(std::string_view name) {
+        prefixItem();
+        writeString(name);
+        put(':');
+        if (indent_ > 0) put(' ');
+        afterKey_ = true;
+    }
+
+    void value(std::string_view text) {
+        prefixValue();
+        writeString(text);
+    }
+
+    void value(double number) {
+        prefixValue();
+        writeNumber(number);
+    }
+
+    void value(bool flag) {
+        prefixValue();
+        write(flag ? std::string_view("true") : std::string_view("false"));
+    }
+
+    // Writes "<text><suffix><number>" as one string value
+    void compositeValue(std::string_view text, std::string_view suffix, std::size_t number) {
+        prefixValue();
+        put('"');
+        writeEscaped(text);
+        writeEscaped(suffix);
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number);
+        write(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+        put('"');
+    }
+
+    void flush() {
+        if (used_ == 0) return;
+        if (out_ != nullptr) {
+            out_->append(buffer_, used_);
+        } else {
+            writeToFd(buffer_, used_);
+        }
+        used_ = 0;
+    }
+
+private:
+    void beginContainer(char open) {
+        prefixValue();
+        put(open);
+        counts_.push_back(0);
+    }
+
+    void endContainer(char close) {
+        bool hadItems = counts_.back() != 0;
+        counts_.pop_back();
+        if (hadItems && indent_ > 0) newline();
+        put(close);
+    }
+
+    void prefixValue() {
+        if (afterKey_) {
+            afterKey_ = false;
+            return;
+        }
+        prefixItem();
+    }
+
+    void prefixItem() {
+        if (counts_.empty()) return;
+        if (counts_.back()++ != 0) put(',');
+        if (indent_ > 0) newline();
+    }
+
+    void newline() {
+        put('\n');
+        for (std::size_t i = counts_.size() * static_cast<std::size_t>(indent_); i > 0; i--) {
+            put(' ');
+        }
+    }
+
+    void writeNumber(double number) {
+        if (!std::isfinite(number)) {
+            write("null");
+            return;
+        }
+        if (number == 0.0) number = 0.0;  // No "-0"
+        char digits[32];
+        auto result = std::to_chars(digits, digits + sizeof(digits), number);
+        write(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+    }
+
+    void writeString(std::string_view text) {
+        put('"');
+        writeEscaped(text);
+        put('"');
+    }
+
+    void writeEscaped(std::string_view text) {
+        static const char HEX[] = "0123456789abcdef";
+        std::size_t runStart = 0;
+        for (std::size_t i = 0; i < text.size(); i++) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            write(text.substr(runStart, i - runStart));
+            runStart = i + 1;
+            switch (c) {
+                case '"': write("\\\""); break;
+                case '\\': write("\\\\"); break;
+                case '\b': write("\\b"); break;
+                case '\f': write("\\f"); break;
+                case '\n': write("\\n"); break;
+                case '\r': write("\\r"); break;
+                case '\t': write("\\t"); break;
+                default: {
+                    char escape[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+                    write(std::string_view(escape, sizeof(escape)));
+                }
+            }
+        }
+        write(text.substr(runStart));
+    }
+
+    void put(char c) {
+        if (used_ == sizeof(buffer_)) flush();
+        buffer_[used_++] = c;
+    }
+
+    void write(std::string_view text) {
+        while (!text.empty()) {
+            if (used_ == sizeof(buffer_)) flush();
+            std::size_t n = std::min(text.size(), sizeof(buffer_) - used_);
+            std::copy(text.data(), text.data() + n, buffer_ + used_);
+            used_ += n;
+            text.remove_prefix(n);
+        }
+    }
+
+    void writeToFd(const char* data, std::size_t size) {
+        while (size > 0) {
+#ifdef ELK_HAVE_POSIX_IO
+            ssize_t written = ::write(fd_, data, size);
+#else
+            int written = ::_write(fd_, data, static_cast<unsigned int>(size));
+#endif
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Failed to write ELK JSON output");
+            }
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+
+    std::string* out_;
+    int fd_;
+    int indent_;
+    bool afterKey_ = false;
+    std::vector<std::uint32_t> counts_;  // Items written per open container
+    std::size_t used_ = 0;
+    char buffer_[16384];
+};
+
+std::string_view portSideName(PortSide side) {
+    switch (side) {
+        case PortSide::NORTH: return "NORTH";
+        case PortSide::SOUTH: return "SOUTH";
+        case PortSide::EAST: return "EAST";
+        case PortSide::WEST: return "WEST";
+        default: return "UNDEFINED";
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Graph traversal
+// ----------------------------------------------------------------------------
+
+class ElkJsonEmitter {
+public:
+    ElkJsonEmitter(JsonStream& json, const JsonWriteOptions& options)
+        : json_(json), options_(options) {}
+
+    void writeNode(const Node& node) {
+        json_.beginObject();
+        json_.key("id");
+        json_.value(std::string_view(node.id.str()));
+        writeBounds(node.position, node.size);
+
+        if (!node.ports.empty()) {
+            json_.key("ports");
+            json_.beginArray();
+            for (const auto& port : node.ports) {
+                writePort(*port);
+            }
+            json_.endArray();
+        }
+        writeLabels(node.labels);
+        if (!node.children.empty()) {
+            json_.key("children");
+            json_.beginArray();
+            for (const auto& child : node.children) {
+                writeNode(*child);
+            }
+            json_.endArray();
+        }
+        if (!node.edges.empty()) {
+            json_.key("edges");
+            json_.beginArray();
+            for (const auto& edge : node.edges) {
+                writeEdge(*edge);
+            }
+            json_.endArray();
+        }
+        writeLayoutOptions(node);
+        json_.endObject();
+    }
+
+private:
+    void writePort(const Port& port) {
+        json_.beginObject();
+        json_.key("id");
+        json_.value(std::string_view(port.id.str()));
+        writeBounds(port.position, port.size);
+        writeLabels(port.labels);
+        writeLayoutOptions(port, &port);
+        json_.endObject();
+    }
+
+    void writeEdge(const Edge& edge) {
+        json_.beginObject();
+        json_.key("id");
+        json_.value(std::string_view(edge.id.str()));
+
+        json_.key("sources");
+        json_.beginArray();
+        for (const Port* port : edge.sourcePorts) json_.value(std::string_view(port->id.str()));
+        for (const Node* node : edge.sourceNodes) json_.value(std::string_view(node->id.str()));
+        json_.endArray();
+
+        json_.key("targets");
+        json_.beginArray();
+        for (const Port* port : edge.targetPorts) json_.value(std::string_view(port->id.str()));
+        for (const Node* node : edge.targetNodes) json_.value(std::string_view(node->id.str()));
+        json_.endArray();
+
+        writeLabels(edge.labels);
+
+        if (!edge.sections.empty()) {
+            json_.key("sections");
+            json_.beginArray();
+            for (std::size_t i = 0; i < edge.sections.size(); i++) {
+                writeSection(edge, edge.sections[i], i);
+            }
+            json_.endArray();
+        }
+        if (!edge.junctionPoints.empty()) {
+            json_.key("junctionPoints");
+            json_.beginArray();
+            for (const Point& point : edge.junctionPoints) {
+                writePoint(point);
+            }
+            json_.endArray();
+        }
+        writeLayoutOptions(edge);
+        json_.endObject();
+    }
+
+    void writeSection(const Edge& edge, const EdgeSection& section, std::size_t index) {
+        json_.beginObject();
+        json_.key("id");
+        if (!section.identifier.empty()) {
+            json_.value(std::string_view(section.identifier));
+        } else {
+            // elkjs names sections "<edge id>_s<index>"
+            json_.compositeValue(edge.id.str(), "_s", index);
+        }
+        json_.key("startPoint");
+        writePoint(section.startPoint);
+        json_.key("endPoint");
+        writePoint(section.endPoint);
+        if (!section.bendPoints.empty()) {
+            json_.key("bendPoints");
+            json_.beginArray();
+            for (const Point& point : section.bendPoints) {
+                writePoint(point);
+            }
+            json_.endArray();
+        }
+        writeShape("incomingShape", section.getIncomingNode(), section.getIncomingPort());
+        writeShape("outgoingShape", section.getOutgoingNode(), section.getOutgoingPort());
+        json_.endObject();
+    }
+
+    void writeShape(std::string_view key, const Node* node, const Port* port) {
+        if (port != nullptr) {
+            json_.key(key);
+            json_.value(std::string_view(port->id.str()));
+        } else if (node != nullptr) {
+            json_.key(key);
+            json_.value(std::string_view(node->id.str()));
+        }
+    }
+
+    void writeLabels(const std::vector<Label>& labels) {
+        if (labels.empty()) return;
+        json_.key("labels");
+        json_.beginArray();
+        for (const Label& label : labels) {
+            json_.beginObject();
+            if (!label.id.empty()) {
+                json_.key("id");
+                json_.value(std::string_view(label.id.str()));
+            }
+            json_.key("text");
+            json_.value(std::string_view(label.text));
+            writeBounds(label.position, label.size);
+            writeLayoutOptions(label);
+            json_.endObject();
+        }
+        json_.endArray();
+    }
+
+    void writeBounds(const Point& position, const Size& size) {
+        json_.key("x");
+        json_.value(position.x);
+        json_.key("y");
+        json_.value(position.y);
+        json_.key("width");
+        json_.value(size.width);
+        json_.key("height");
+        json_.value(size.height);
+    }
+
+    void writePoint(const Point& point) {
+        json_.beginObject();
+        json_.key("x");
+        json_.value(point.x);
+        json_.key("y");
+        json_.value(point.y);
+        json_.endObject();
+    }
+
+    // Only values with a JSON representation are written; internal
+    // properties holding enums or pointers are skipped. A port side set
+    // through Port::side is written as "elk.port.side" so it survives a
+    // round trip through the reader.
+    void writeLayoutOptions(const PropertyHolder& holder, const Port* port = nullptr) {
+        if (!options_.layoutOptions) return;
+        bool open = false;
+        if (port != nullptr && port->side != PortSide::UNDEFINED &&
+            !holder.hasProperty(LayoutOptions::PORT_SIDE)) {
+            json_.key("layoutOptions");
+            json_.beginObject();
+            open = true;
+            json_.key(LayoutOptions::PORT_SIDE.key());
+            json_.value(portSideName(port->side));
+        }
+        holder.forEachProperty([&](int id, const std::any& value) {
+            const std::string* text = std::any_cast<std::string>(&value);
+            const double* real = std::any_cast<double>(&value);
+            const int* integer = std::any_cast<int>(&value);
+            const bool* flag = std::any_cast<bool>(&value);
+            if (text == nullptr && real == nullptr && integer == nullptr && flag == nullptr) {
+                return;
+            }
+            if (!open) {
+                json_.key("layoutOptions");
+                json_.beginObject();
+                open = true;
+            }
+            json_.key(PropertyRegistry::keyFor(id));
+            if (text != nullptr) json_.value(std::string_view(*text));
+            else if (real != nullptr) json_.value(*real);
+            else if (integer != nullptr) json_.value(static_cast<double>(*integer));
+            else json_.value(*flag);
+        });
+        if (open) {
+            json_.endObject();
+        }
+    }
+
+    JsonStream& json_;
+    const JsonWriteOptions& options_;
+};
+
+void writeDocument(const Node& root, JsonStream& json, const JsonWriteOptions& options) {
+    ElkJsonEmitter emitter(json, options);
+    emitter.writeNode(root);
+    json.flush();
+}
+
+} // namespace
+
+void writeElkJson(const Node& root, std::string& out, const JsonWriteOptions& options) {
+    JsonStream json(&out, -1, options.indent);
+    writeDocument(root, json, options);
+}
+
+void writeElkJson(const Node& root, int fd, const JsonWriteOptions& options) {
+    JsonStream json(nullptr, fd, options.indent);
+    writeDocument(root, json, options);
+}
+
+void writeElkJsonFile(const Node& root, const std::string& path, const JsonWriteOptions& options) {
+#ifdef ELK_HAVE_POSIX_IO
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    }
+    try {
+        writeElkJson(root, fd, options);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    if (::close(fd) != 0) {
+        throw std::runtime_error("Failed to write ELK JSON output: " + path);
+    }
+#else
+    std::string out;
+    writeElkJson(root, out, options);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+#endif
+}
+
+} // namespace io
+} // namespace elk
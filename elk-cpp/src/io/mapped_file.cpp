@@ -0,0 +1,92 @@
+// Eclipse Layout Kernel - C++ Port
+// Memory-mapped file implementation
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/io/mapped_file.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ELK_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace elk {
+namespace io {
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef ELK_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            data_ = buffer_.data();
+            return;
+        }
+        void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            ::close(fd);
+            data_ = static_cast<const char*>(address);
+            mapped_ = true;
+            return;
+        }
+    }
+    ::close(fd);
+#endif
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    buffer_ = contents.str();
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        mapped_ = other.mapped_;
+        size_ = other.size_;
+        buffer_ = std::move(other.buffer_);
+        data_ = mapped_ ? other.data_ : buffer_.data();
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+    return *this;
+}
+
+void MappedFile::unmap() {
+#ifdef ELK_HAVE_MMAP
+    if (mapped_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+
+} // namespace io
+} // namespace elk
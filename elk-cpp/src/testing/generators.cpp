@@ -0,0 +1,507 @@
+// Eclipse Layout Kernel - C++ Port
+// Synthetic netlist graphs for tests and benchmarks
+// SPDX-License-Identifier: EPL-2.0
+
+#include "elk/testing/generators.h"
+#include "elk/core/properties.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace elk {
+namespace testing {
+
+namespace {
+
+struct PinSpec {
+    const char* name;
+    double x;
+    double y;
+    PortSide side;
+};
+
+struct CellSpec {
+    const char* type;
+    double width;
+    double height;
+    std::vector<PinSpec> pins;
+};
+
+// Shapes and pins of lib/default.svg, in the order netlistsvg creates ports
+const std::vector<CellSpec>& skin() {
+    static const std::vector<CellSpec> cells = {
+        {"inputExt", 30, 20, {{"Y", 30, 10, PortSide::EAST}}},
+        {"outputExt", 30, 20, {{"A", 0, 10, PortSide::WEST}}},
+        {"constant", 30, 20, {{"Y", 31, 10, PortSide::EAST}}},
+        {"and", 30, 25, {{"A", 0, 5, PortSide::WEST}, {"B", 0, 20, PortSide::WEST}, {"Y", 30, 12.5, PortSide::EAST}}},
+        {"or", 30, 25, {{"A", 2, 5, PortSide::WEST}, {"B", 2, 20, PortSide::WEST}, {"Y", 30, 12.5, PortSide::EAST}}},
+        {"reduce_xor", 33, 25,
+         {{"A", 2, 5, PortSide::WEST}, {"B", 2, 20, PortSide::WEST}, {"Y", 33, 12.5, PortSide::EAST}}},
+        {"not", 30, 20, {{"A", -1, 10, PortSide::WEST}, {"Y", 27, 10, PortSide::EAST}}},
+        {"mux", 20, 40,
+         {{"A", 0, 10, PortSide::WEST}, {"B", 0, 30, PortSide::WEST}, {"S", 10, 35, PortSide::SOUTH},
+          {"Y", 20, 20, PortSide::EAST}}},
+        {"add", 25, 25, {{"A", 2, 5, PortSide::WEST}, {"B", 2, 20, PortSide::WEST}, {"Y", 26, 12.5, PortSide::EAST}}},
+        {"eq", 25, 25, {{"A", 2, 5, PortSide::WEST}, {"B", 2, 20, PortSide::WEST}, {"Y", 25, 12.5, PortSide::EAST}}},
+        {"dff", 30, 40,
+         {{"Q", 31, 10, PortSide::EAST}, {"CLK", -1, 30, PortSide::WEST}, {"D", -1, 10, PortSide::WEST},
+          {"ARST", 15, 40, PortSide::SOUTH}}},
+    };
+    return cells;
+}
+
+// Text size netlistsvg assumes for labels
+Label makeLabel(const std::string& id, const std::string& text, double x, double y, SymbolTable& symbols) {
+    Label label(text, 6.0 * text.size(), 11);
+    label.id = ElementId(id, symbols);
+    label.position = Point(x, y);
+    return label;
+}
+
+// Random two-input gate
+CellKind randomGate(NetlistBuilder& builder) {
+    static const CellKind gates[] = {CellKind::AND, CellKind::OR, CellKind::XOR, CellKind::ADD, CellKind::EQ};
+    return gates[builder.pick(sizeof(gates) / sizeof(gates[0]))];
+}
+
+Port* output(Node* cell) {
+    return NetlistBuilder::pin(cell, "Y");
+}
+
+} // namespace
+
+// ============================================================================
+// NetlistBuilder
+// ============================================================================
+
+NetlistBuilder::NetlistBuilder(Node* module, std::uint64_t seed, const std::string& prefix)
+    : module_(module), random_(seed), prefix_(prefix) {}
+
+std::string NetlistBuilder::nextId(const std::string& type) {
+    return prefix_ + "$" + type + "$" + std::to_string(++cells_);
+}
+
+Node* NetlistBuilder::addCell(CellKind kind, const std::string& label) {
+    const CellSpec& spec = skin()[static_cast<std::size_t>(kind)];
+    Node* cell = module_->addChild(nextId(spec.type));
+    const std::string& id = cell->id.str();
+    cell->size = Size(spec.width, spec.height);
+    cell->setProperty(LayoutOptions::PORT_CONSTRAINTS, std::string("FIXED_POS"));
+    for (const PinSpec& pinSpec : spec.pins) {
+        Port* port = cell->addPort(id + "." + pinSpec.name, pinSpec.side);
+        port->position = Point(pinSpec.x, pinSpec.y);
+        port->size = Size(0, 0);
+    }
+    if (!label.empty()) {
+        cell->labels.push_back(makeLabel(id + ".label", label, 15, -10, module_->symbolTable()));
+    }
+    return cell;
+}
+
+Node* NetlistBuilder::addSplit(std::size_t outputs) {
+    if (outputs == 0) throw std::invalid_argument("split needs at least one output");
+    // Input first, so that output i is port i + 1
+    Node* split = module_->addChild(nextId("split"));
+    const std::string& id = split->id.str();
+    std::size_t pins = std::max<std::size_t>(outputs, 2);
+    split->size = Size(5, 40 + 20.0 * (pins - 2));
+    split->setProperty(LayoutOptions::PORT_CONSTRAINTS, std::string("FIXED_POS"));
+    Port* in = split->addPort(id + ".in", PortSide::WEST);
+    in->position = Point(0, split->size.height / 2);
+    in->size = Size(1, 1);
+    for (std::size_t i = 0; i < outputs; i++) {
+        Port* out = split->addPort(id + ".out" + std::to_string(i), PortSide::EAST);
+        out->position = Point(4, 10 + 20.0 * i);
+        out->size = Size(1, 1);
+    }
+    return split;
+}
+
+Node* NetlistBuilder::addJoin(std::size_t inputs) {
+    if (inputs == 0) throw std::invalid_argument("join needs at least one input");
+    Node* join = module_->addChild(nextId("join"));
+    const std::string& id = join->id.str();
+    std::size_t pins = std::max<std::size_t>(inputs, 2);
+    join->size = Size(4, 40 + 20.0 * (pins - 2));
+    join->setProperty(LayoutOptions::PORT_CONSTRAINTS, std::string("FIXED_POS"));
+    for (std::size_t i = 0; i < inputs; i++) {
+        Port* in = join->addPort(id + ".in" + std::to_string(i), PortSide::WEST);
+        in->position = Point(0, 10 + 20.0 * i);
+        in->size = Size(1, 1);
+    }
+    Port* out = join->addPort(id + ".out", PortSide::EAST);
+    out->position = Point(5, join->size.height / 2);
+    out->size = Size(1, 1);
+    return join;
+}
+
+Node* NetlistBuilder::addInstance(const std::string& name, std::size_t inputs, std::size_t outputs) {
+    Node* instance = module_->addChild(nextId(name));
+    const std::string& id = instance->id.str();
+    // Pins 20 apart from y = 10, on a body of height 40 for up to two
+    std::size_t pins = std::max<std::size_t>(std::max(inputs, outputs), 2);
+    instance->size = Size(30, 40 + 20.0 * (pins - 2));
+    instance->setProperty(LayoutOptions::PORT_CONSTRAINTS, std::string("FIXED_POS"));
+    auto addPins = [&](const std::string& prefix, std::size_t count, double x, PortSide side) {
+        for (std::size_t i = 0; i < count; i++) {
+            std::string pinName = prefix + std::to_string(i);
+            Port* port = instance->addPort(id + "." + pinName, side);
+            port->position = Point(x, 10 + 20.0 * i);
+            port->size = Size(1, 1);
+            port->labels.push_back(makeLabel(id + "." + pinName + ".label", pinName,
+                                             side == PortSide::WEST ? -13 : -5, -10, module_->symbolTable()));
+        }
+    };
+    addPins("in", inputs, 0, PortSide::WEST);
+    addPins("out", outputs, 30, PortSide::EAST);
+    instance->labels.push_back(makeLabel(id + ".label", name, 15, -10, module_->symbolTable()));
+    return instance;
+}
+
+Port* NetlistBuilder::pin(Node* cell, const std::string& name) {
+    const std::string& id = cell->id.str();
+    for (const auto& port : cell->ports) {
+        const std::string& portId = port->id.str();
+        if (portId.size() == id.size() + 1 + name.size() && portId.compare(id.size() + 1, name.size(), name) == 0) {
+            return port.get();
+        }
+    }
+    throw std::invalid_argument("cell " + id + " has no pin " + name);
+}
+
+Edge* NetlistBuilder::connect(Port* driver, Port* rider) {
+    Edge* edge = module_->addEdge(prefix_ + "e" + std::to_string(edges_++));
+    edge->sourcePorts.push_back(driver);
+    edge->targetPorts.push_back(rider);
+    return edge;
+}
+
+// ============================================================================
+// Netlist fragments
+// ============================================================================
+
+std::size_t addCarryChain(NetlistBuilder& builder, std::size_t bits) {
+    std::size_t before = builder.cellCount();
+    Node* di = builder.addSplit(bits);
+    Node* s = builder.addSplit(bits);
+    builder.connect(NetlistBuilder::pin(builder.addInput("DI"), "Y"), NetlistBuilder::pin(di, "in"));
+    builder.connect(NetlistBuilder::pin(builder.addInput("S"), "Y"), NetlistBuilder::pin(s, "in"));
+
+    // CI | CYINIT; CYINIT is tied off in most instances
+    Node* carryIn = builder.addCell(CellKind::OR);
+    builder.connect(output(builder.addInput("CI")), NetlistBuilder::pin(carryIn, "A"));
+    Node* cyinit = builder.pick(4) == 0 ? builder.addInput("CYINIT") : builder.addConstant("0");
+    builder.connect(output(cyinit), NetlistBuilder::pin(carryIn, "B"));
+
+    Node* o = builder.addJoin(bits);
+    Node* co = builder.addJoin(bits);
+    Port* carry = output(carryIn);
+    for (std::size_t i = 0; i < bits; i++) {
+        Port* select = NetlistBuilder::splitOutput(s, i);
+        Node* sum = builder.addCell(CellKind::XOR);
+        builder.connect(select, NetlistBuilder::pin(sum, "A"));
+        builder.connect(carry, NetlistBuilder::pin(sum, "B"));
+        builder.connect(output(sum), NetlistBuilder::joinInput(o, i));
+
+        Node* mux = builder.addCell(CellKind::MUX);
+        builder.connect(NetlistBuilder::splitOutput(di, i), NetlistBuilder::pin(mux, "A"));
+        builder.connect(carry, NetlistBuilder::pin(mux, "B"));
+        builder.connect(select, NetlistBuilder::pin(mux, "S"));
+        carry = output(mux);
+        builder.connect(carry, NetlistBuilder::joinInput(co, i));
+    }
+    builder.connect(NetlistBuilder::pin(o, "out"), NetlistBuilder::pin(builder.addOutput("O"), "A"));
+    builder.connect(NetlistBuilder::pin(co, "out"), NetlistBuilder::pin(builder.addOutput("CO"), "A"));
+    return builder.cellCount() - before;
+}
+
+std::size_t addMuxTree(NetlistBuilder& builder, std::size_t inputs) {
+    std::size_t before = builder.cellCount();
+    std::vector<Port*> level;
+    for (std::size_t i = 0; i < std::max<std::size_t>(inputs, 1); i++) {
+        Node* leaf = builder.pick(8) == 0 ? builder.addConstant(builder.pick(2) ? "1" : "0")
+                                          : builder.addInput("d" + std::to_string(i));
+        level.push_back(output(leaf));
+    }
+    for (std::size_t depth = 0; level.size() > 1; depth++) {
+        Port* select = output(builder.addInput("s" + std::to_string(depth)));
+        std::vector<Port*> next;
+        for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+            Node* mux = builder.addCell(CellKind::MUX);
+            builder.connect(level[i], NetlistBuilder::pin(mux, "A"));
+            builder.connect(level[i + 1], NetlistBuilder::pin(mux, "B"));
+            builder.connect(select, NetlistBuilder::pin(mux, "S"));
+            next.push_back(output(mux));
+        }
+        if (level.size() % 2 == 1) next.push_back(level.back());
+        level.swap(next);
+    }
+    builder.connect(level[0], NetlistBuilder::pin(builder.addOutput("y"), "A"));
+    return builder.cellCount() - before;
+}
+
+std::size_t addRegisterFile(NetlistBuilder& builder, std::size_t registers, std::size_t width) {
+    std::size_t before = builder.cellCount();
+    registers = std::max<std::size_t>(registers, 1);
+    width = std::max<std::size_t>(width, 1);
+    Port* clk = output(builder.addInput("clk"));
+    Port* rst = output(builder.addInput("rst"));
+    Node* wdata = builder.addSplit(width);
+    builder.connect(output(builder.addInput("wdata")), NetlistBuilder::pin(wdata, "in"));
+
+    // q[r][b]
+    std::vector<std::vector<Port*>> q(registers);
+    for (std::size_t r = 0; r < registers; r++) {
+        Port* enable = output(builder.addInput("we" + std::to_string(r)));
+        for (std::size_t b = 0; b < width; b++) {
+            Node* dff = builder.addCell(CellKind::DFF);
+            Node* hold = builder.addCell(CellKind::MUX);
+            Port* value = NetlistBuilder::pin(dff, "Q");
+            builder.connect(value, NetlistBuilder::pin(hold, "A"));
+            builder.connect(NetlistBuilder::splitOutput(wdata, b), NetlistBuilder::pin(hold, "B"));
+            builder.connect(enable, NetlistBuilder::pin(hold, "S"));
+            builder.connect(output(hold), NetlistBuilder::pin(dff, "D"));
+            builder.connect(clk, NetlistBuilder::pin(dff, "CLK"));
+            builder.connect(rst, NetlistBuilder::pin(dff, "ARST"));
+            q[r].push_back(value);
+        }
+    }
+
+    std::vector<Port*> selects;
+    for (std::size_t r = 1; r < registers; r++) {
+        selects.push_back(output(builder.addInput("ra" + std::to_string(r))));
+    }
+    Node* rdata = builder.addJoin(width);
+    for (std::size_t b = 0; b < width; b++) {
+        Port* read = q[0][b];
+        for (std::size_t r = 1; r < registers; r++) {
+            Node* mux = builder.addCell(CellKind::MUX);
+            builder.connect(read, NetlistBuilder::pin(mux, "A"));
+            builder.connect(q[r][b], NetlistBuilder::pin(mux, "B"));
+            builder.connect(selects[r - 1], NetlistBuilder::pin(mux, "S"));
+            read = output(mux);
+        }
+        builder.connect(read, NetlistBuilder::joinInput(rdata, b));
+    }
+    builder.connect(NetlistBuilder::pin(rdata, "out"), NetlistBuilder::pin(builder.addOutput("rdata"), "A"));
+    return builder.cellCount() - before;
+}
+
+std::size_t addBitBlastedBus(NetlistBuilder& builder, std::size_t width, std::size_t stages) {
+    std::size_t before = builder.cellCount();
+    width = std::max<std::size_t>(width, 1);
+    Node* split = builder.addSplit(width);
+    builder.connect(output(builder.addInput("a")), NetlistBuilder::pin(split, "in"));
+    std::vector<Port*> bits;
+    for (std::size_t i = 0; i < width; i++) {
+        bits.push_back(NetlistBuilder::splitOutput(split, i));
+    }
+
+    for (std::size_t stage = 0; stage < stages; stage++) {
+        std::vector<Port*> next;
+        for (std::size_t i = 0; i < width; i++) {
+            if (builder.pick(6) == 0) {
+                Node* inverter = builder.addCell(CellKind::NOT);
+                builder.connect(bits[i], NetlistBuilder::pin(inverter, "A"));
+                next.push_back(output(inverter));
+                continue;
+            }
+            Node* gate = builder.addCell(randomGate(builder));
+            builder.connect(bits[i], NetlistBuilder::pin(gate, "A"));
+            builder.connect(bits[(i + 1 + builder.pick(3)) % width], NetlistBuilder::pin(gate, "B"));
+            next.push_back(output(gate));
+        }
+        bits.swap(next);
+    }
+
+    Node* join = builder.addJoin(width);
+    for (std::size_t i = 0; i < width; i++) {
+        builder.connect(bits[i], NetlistBuilder::joinInput(join, i));
+    }
+    builder.connect(NetlistBuilder::pin(join, "out"), NetlistBuilder::pin(builder.addOutput("y"), "A"));
+    return builder.cellCount() - before;
+}
+
+std::size_t addFeedbackLoops(NetlistBuilder& builder, std::size_t cells, std::size_t loops) {
+    std::size_t before = builder.cellCount();
+    cells = std::max<std::size_t>(cells, 1);
+    std::vector<Node*> gates;
+    Port* previous = output(builder.addInput("x"));
+    for (std::size_t i = 0; i < cells; i++) {
+        Node* gate = builder.addCell(randomGate(builder));
+        builder.connect(previous, NetlistBuilder::pin(gate, "A"));
+        previous = output(gate);
+        gates.push_back(gate);
+    }
+
+    // B pins: back edges first, then shared side inputs
+    std::vector<Port*> drivers(cells, nullptr);
+    Port* clk = nullptr;
+    Port* rst = nullptr;
+    std::size_t placed = 0;
+    for (std::size_t attempt = 0; placed < loops && attempt < 4 * loops; attempt++) {
+        std::size_t target = builder.pick(cells);
+        if (drivers[target]) continue;
+        std::size_t source = target + builder.pick(cells - target);
+        Port* back = output(gates[source]);
+        if (placed % 2 == 1 || source == target) {
+            if (!clk) {
+                clk = output(builder.addInput("clk"));
+                rst = output(builder.addInput("rst"));
+            }
+            Node* dff = builder.addCell(CellKind::DFF);
+            builder.connect(back, NetlistBuilder::pin(dff, "D"));
+            builder.connect(clk, NetlistBuilder::pin(dff, "CLK"));
+            builder.connect(rst, NetlistBuilder::pin(dff, "ARST"));
+            back = NetlistBuilder::pin(dff, "Q");
+        }
+        drivers[target] = back;
+        placed++;
+    }
+    std::vector<Port*> sideInputs;
+    for (std::size_t i = 0; i < cells; i++) {
+        if (drivers[i]) continue;
+        if (sideInputs.empty() || builder.pick(8) == 0) {
+            sideInputs.push_back(output(builder.addInput("b" + std::to_string(sideInputs.size()))));
+        }
+        drivers[i] = sideInputs[builder.pick(sideInputs.size())];
+    }
+    for (std::size_t i = 0; i < cells; i++) {
+        builder.connect(drivers[i], NetlistBuilder::pin(gates[i], "B"));
+    }
+
+    builder.connect(previous, NetlistBuilder::pin(builder.addOutput("y"), "A"));
+    return builder.cellCount() - before;
+}
+
+std::size_t addInverterChain(NetlistBuilder& builder, std::size_t cells) {
+    std::size_t before = builder.cellCount();
+    Port* previous = output(builder.addInput("x"));
+    for (std::size_t i = 0; i < cells; i++) {
+        Node* inverter = builder.addCell(CellKind::NOT);
+        builder.connect(previous, NetlistBuilder::pin(inverter, "A"));
+        previous = output(inverter);
+    }
+    builder.connect(previous, NetlistBuilder::pin(builder.addOutput("y"), "A"));
+    return builder.cellCount() - before;
+}
+
+// ============================================================================
+// Complete graphs
+// ============================================================================
+
+namespace {
+
+template<typename Fill>
+io::GraphDocument build(const std::string& name, std::uint64_t seed, Fill fill) {
+    io::GraphDocument document = io::makeGraphDocument(io::ReadOptions());
+    document.root->id = ElementId(name, *document.symbols);
+    NetlistBuilder builder(document.root.get(), seed);
+    fill(builder);
+    io::indexGraphDocument(document);
+    return document;
+}
+
+// Module body of a hierarchical design: in0 through nested instances to
+// out0, next to a feedback-loop fragment
+void fillModule(NetlistBuilder& builder, std::size_t depth, std::size_t instances, std::size_t cellsPerModule) {
+    Port* signal = output(builder.addInput("in0"));
+    if (depth > 1) {
+        for (std::size_t i = 0; i < instances; i++) {
+            Node* instance = builder.addInstance("sub" + std::to_string(i), 1, 1);
+            builder.connect(signal, NetlistBuilder::pin(instance, "in0"));
+            signal = NetlistBuilder::pin(instance, "out0");
+            NetlistBuilder inner(instance, builder.random()(), instance->id.str() + "/");
+            fillModule(inner, depth - 1, instances, cellsPerModule);
+        }
+    }
+    builder.connect(signal, NetlistBuilder::pin(builder.addOutput("out0"), "A"));
+    if (cellsPerModule > 3) {
+        addFeedbackLoops(builder, cellsPerModule - 3, 1 + cellsPerModule / 8);
+    }
+}
+
+} // namespace
+
+io::GraphDocument carryChain(std::size_t bits, std::uint64_t seed) {
+    return build("carry" + std::to_string(bits), seed,
+                 [&](NetlistBuilder& builder) { addCarryChain(builder, bits); });
+}
+
+io::GraphDocument muxTree(std::size_t inputs, std::uint64_t seed) {
+    return build("mux" + std::to_string(inputs), seed,
+                 [&](NetlistBuilder& builder) { addMuxTree(builder, inputs); });
+}
+
+io::GraphDocument registerFile(std::size_t registers, std::size_t width, std::uint64_t seed) {
+    return build("regfile" + std::to_string(registers) + "x" + std::to_string(width), seed,
+                 [&](NetlistBuilder& builder) { addRegisterFile(builder, registers, width); });
+}
+
+io::GraphDocument bitBlastedBus(std::size_t width, std::size_t stages, std::uint64_t seed) {
+    return build("bus" + std::to_string(width) + "x" + std::to_string(stages), seed,
+                 [&](NetlistBuilder& builder) { addBitBlastedBus(builder, width, stages); });
+}
+
+io::GraphDocument feedbackLoops(std::size_t cells, std::size_t loops, std::uint64_t seed) {
+    return build("loops" + std::to_string(cells), seed,
+                 [&](NetlistBuilder& builder) { addFeedbackLoops(builder, cells, loops); });
+}
+
+io::GraphDocument inverterChain(std::size_t cells, std::uint64_t seed) {
+    return build("chain" + std::to_string(cells), seed,
+                 [&](NetlistBuilder& builder) { addInverterChain(builder, cells); });
+}
+
+io::GraphDocument hierarchicalDesign(std::size_t depth, std::size_t instances,
+                                     std::size_t cellsPerModule, std::uint64_t seed) {
+    return build("top", seed, [&](NetlistBuilder& builder) {
+        fillModule(builder, std::max<std::size_t>(depth, 1) + 1, instances, cellsPerModule);
+    });
+}
+
+io::GraphDocument netlist(std::size_t cells, std::uint64_t seed) {
+    return build("netlist" + std::to_string(cells), seed, [&](NetlistBuilder& builder) {
+        // Fragment sizes are drawn first and then capped to what is left,
+        // so the total overshoots the target by a few cells at most
+        while (builder.cellCount() < cells) {
+            std::size_t left = cells - builder.cellCount();
+            switch (builder.pick(5)) {
+            case 0: {
+                std::size_t bits = 4 * (1 + builder.pick(16));
+                addCarryChain(builder, std::max<std::size_t>(std::min(bits, left / 2), 1));
+                break;
+            }
+            case 1: {
+                std::size_t inputs = 2 + builder.pick(63);
+                addMuxTree(builder, std::max<std::size_t>(std::min(inputs, left / 2), 2));
+                break;
+            }
+            case 2: {
+                std::size_t registers = 2 + builder.pick(7);
+                std::size_t width = 1 + builder.pick(16);
+                width = std::max<std::size_t>(std::min(width, left / (3 * registers)), 1);
+                registers = std::max<std::size_t>(std::min(registers, left / (3 * width)), 1);
+                addRegisterFile(builder, registers, width);
+                break;
+            }
+            case 3: {
+                std::size_t width = 2 + builder.pick(31);
+                std::size_t stages = 1 + builder.pick(4);
+                width = std::max<std::size_t>(std::min(width, left / stages), 1);
+                addBitBlastedBus(builder, width, stages);
+                break;
+            }
+            default: {
+                std::size_t gates = 8 + builder.pick(120);
+                gates = std::max<std::size_t>(std::min(gates, left), 1);
+                addFeedbackLoops(builder, gates, 1 + builder.pick(1 + gates / 8));
+                break;
+            }
+            }
+        }
+    });
+}
+
+} // namespace testing
+} // namespace elk